@@ -0,0 +1,207 @@
+/*
+ This file is part of ControlGris.
+
+ Developers: Hicheme BEN GAIED, Gaël LANE LÉPINE
+
+ ControlGris is free software: you can redistribute it and/or modify
+ it under the terms of the GNU Lesser General Public License as
+ published by the Free Software Foundation, either version 3 of the
+ License, or (at your option) any later version.
+
+ ControlGris is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with ControlGris.  If not, see
+ <http://www.gnu.org/licenses/>.
+*/
+
+//==============================================================================
+
+#pragma once
+
+#include "cg_Descriptors.hpp"
+
+#include <array>
+#include <atomic>
+
+namespace gris
+{
+//==============================================================================
+enum class AnalysisResource { loudness = 0, spectralFrames, pitch, shape, spectralFeatures, onsetDetection, count };
+
+//==============================================================================
+/** Lazily allocated buffers and algorithms of the audio descriptors.
+ *
+ * Nothing is allocated until a descriptor is followed by a spatial parameter. The message thread then allocates the
+ * resources of the descriptor and hands them to the analysis by raising their ready flag. A resource that has not been
+ * needed for IDLE_RELEASE_TIME_S is first withdrawn from the analysis and only freed once no analysis pass that
+ * could have seen it ready is still running, so neither the audio thread nor the worker thread ever allocates, frees
+ * or waits.
+ *
+ * The allocation and release themselves are done by the callbacks given to prepare() and update(), so that the
+ * resources stay where the descriptors use them.
+ */
+class AnalysisResources
+{
+public:
+    //==============================================================================
+    /** Not a user setting: it only trades memory for responsiveness and nothing audible depends on it. A descriptor
+     * picked again after its resources were freed keeps its last value until the message thread has re-allocated
+     * them, then restarts from an empty history (up to 32768 samples for the pitch). 30 s is long enough for trying
+     * descriptors in turn on a spatial parameter without paying that warm-up each time, and short enough to give
+     * back the buffers of a descriptor that is no longer used within the same session.
+     */
+    static constexpr double IDLE_RELEASE_TIME_S{ 30.0 };
+    static constexpr size_t NUM_RESOURCES{ static_cast<size_t>(AnalysisResource::count) };
+
+    //==============================================================================
+    /** Held by the thread that runs the analysis for the duration of a pass. */
+    class ScopedAnalysis
+    {
+        AnalysisResources & mResources;
+
+    public:
+        //==============================================================================
+        ScopedAnalysis() = delete;
+        ~ScopedAnalysis() { mResources.mIsAnalysing.store(false, std::memory_order_seq_cst); }
+
+        ScopedAnalysis(ScopedAnalysis const &) = delete;
+        ScopedAnalysis(ScopedAnalysis &&) = delete;
+
+        ScopedAnalysis & operator=(ScopedAnalysis const &) = delete;
+        ScopedAnalysis & operator=(ScopedAnalysis &&) = delete;
+        //==============================================================================
+        explicit ScopedAnalysis(AnalysisResources & resources) noexcept : mResources(resources)
+        {
+            // Pairs with update(): a pass either starts before a resource is withdrawn and delays its release, or
+            // starts after and does not see it ready.
+            mResources.mIsAnalysing.store(true, std::memory_order_seq_cst);
+            for (size_t i{}; i < NUM_RESOURCES; ++i) {
+                mResources.mUsableResources[i] = mResources.mReadyResources[i].load(std::memory_order_seq_cst);
+            }
+        }
+
+    private:
+        //==============================================================================
+        JUCE_LEAK_DETECTOR(ScopedAnalysis)
+    };
+
+    //==============================================================================
+    AnalysisResources() = default;
+
+    /** Resources needed by the descriptors of a mask with one bit per DescriptorID. */
+    static juce::uint32 getRequiredResources(juce::uint32 descriptorMask)
+    {
+        auto const has = [descriptorMask](DescriptorID const descID) {
+            return (descriptorMask & (1u << static_cast<juce::uint32>(descID))) != 0;
+        };
+        auto const bit = [](AnalysisResource const resource) { return 1u << static_cast<juce::uint32>(resource); };
+
+        juce::uint32 resources{};
+        if (has(DescriptorID::loudness)) {
+            resources |= bit(AnalysisResource::loudness);
+        }
+        if (has(DescriptorID::pitch)) {
+            resources |= bit(AnalysisResource::spectralFrames) | bit(AnalysisResource::pitch);
+        }
+        if (has(DescriptorID::centroid) || has(DescriptorID::spread) || has(DescriptorID::noise)) {
+            resources |= bit(AnalysisResource::spectralFrames) | bit(AnalysisResource::shape);
+        }
+        if (has(DescriptorID::flux) || has(DescriptorID::rolloff) || has(DescriptorID::crest)
+            || has(DescriptorID::lowBandEnergy) || has(DescriptorID::midBandEnergy)
+            || has(DescriptorID::highBandEnergy)) {
+            resources |= bit(AnalysisResource::spectralFrames) | bit(AnalysisResource::spectralFeatures);
+        }
+        if (has(DescriptorID::iterationsSpeed)) {
+            resources |= bit(AnalysisResource::onsetDetection);
+        }
+        return resources;
+    }
+
+    //==============================================================================
+    // Message thread
+    /** Re-allocates the required resources and frees the other ones. Must only be called while no analysis runs, e.g.
+     * from prepareToPlay().
+     */
+    template<typename Allocate, typename Release>
+    void prepare(juce::uint32 requiredResources, double timeMs, Allocate && allocate, Release && release)
+    {
+        for (size_t i{}; i < NUM_RESOURCES; ++i) {
+            auto const resource{ static_cast<AnalysisResource>(i) };
+            auto const isRequired{ (requiredResources & (1u << i)) != 0 };
+            if (isRequired) {
+                allocate(resource);
+                mLastRequiredTimesMs[i] = timeMs;
+            } else if (mIsAllocated[i]) {
+                release(resource);
+            }
+            mIsAllocated[i] = isRequired;
+            mIsWithdrawn[i] = false;
+            mReadyResources[i].store(isRequired, std::memory_order_seq_cst);
+        }
+    }
+
+    /** Allocates the newly required resources and releases the ones idle for too long. */
+    template<typename Allocate, typename Release>
+    void update(juce::uint32 requiredResources, double timeMs, Allocate && allocate, Release && release)
+    {
+        for (size_t i{}; i < NUM_RESOURCES; ++i) {
+            auto const resource{ static_cast<AnalysisResource>(i) };
+
+            if ((requiredResources & (1u << i)) != 0) {
+                mLastRequiredTimesMs[i] = timeMs;
+                if (!mIsAllocated[i]) {
+                    allocate(resource);
+                    mIsAllocated[i] = true;
+                }
+                mIsWithdrawn[i] = false;
+                mReadyResources[i].store(true, std::memory_order_seq_cst);
+                continue;
+            }
+
+            if (!mIsAllocated[i]) {
+                continue;
+            }
+            if (!mIsWithdrawn[i]) {
+                if (timeMs - mLastRequiredTimesMs[i] >= IDLE_RELEASE_TIME_S * 1000.0) {
+                    mReadyResources[i].store(false, std::memory_order_seq_cst);
+                    mIsWithdrawn[i] = true;
+                }
+                continue;
+            }
+            // Only a pass started before the withdrawal can still be reading the resource, and it is over once no pass
+            // is running.
+            if (!mIsAnalysing.load(std::memory_order_seq_cst)) {
+                release(resource);
+                mIsAllocated[i] = false;
+                mIsWithdrawn[i] = false;
+            }
+        }
+    }
+
+    bool isAllocated(AnalysisResource resource) const { return mIsAllocated[static_cast<size_t>(resource)]; }
+
+    //==============================================================================
+    // Analysis thread, within a ScopedAnalysis
+    bool isUsable(AnalysisResource resource) const { return mUsableResources[static_cast<size_t>(resource)]; }
+
+private:
+    //==============================================================================
+    std::array<std::atomic<bool>, NUM_RESOURCES> mReadyResources{};
+    std::atomic<bool> mIsAnalysing{};
+
+    // Analysis thread
+    std::array<bool, NUM_RESOURCES> mUsableResources{};
+
+    // Message thread
+    std::array<bool, NUM_RESOURCES> mIsAllocated{};
+    std::array<bool, NUM_RESOURCES> mIsWithdrawn{};
+    std::array<double, NUM_RESOURCES> mLastRequiredTimesMs{};
+
+    //==============================================================================
+    JUCE_LEAK_DETECTOR(AnalysisResources)
+};
+} // namespace gris
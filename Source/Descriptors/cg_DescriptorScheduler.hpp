@@ -0,0 +1,215 @@
+/*
+ This file is part of ControlGris.
+
+ Developers: Hicheme BEN GAIED, Gaël LANE LÉPINE
+
+ ControlGris is free software: you can redistribute it and/or modify
+ it under the terms of the GNU Lesser General Public License as
+ published by the Free Software Foundation, either version 3 of the
+ License, or (at your option) any later version.
+
+ ControlGris is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with ControlGris.  If not, see
+ <http://www.gnu.org/licenses/>.
+*/
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <array>
+#include <atomic>
+
+namespace gris
+{
+//==============================================================================
+enum class ScheduledDescriptor { pitch = 0, shape, count };
+
+//==============================================================================
+/** Decides, block after block, which descriptors of the analysis chain have to run.
+ *
+ * Each descriptor runs at its own control rate and the descriptors start out of phase, so that their work is spread
+ * over different blocks. The due descriptors are admitted by order of lateness as long as their estimated cost fits
+ * in the CPU budget of the block and the others are deferred to the next block. A descriptor that has been deferred
+ * for a whole period runs anyway.
+ *
+ * Everything but the setters must be called from the thread that runs the analysis.
+ */
+class DescriptorScheduler
+{
+public:
+    //==============================================================================
+    class ScopedJob
+    {
+        DescriptorScheduler & mScheduler;
+        ScheduledDescriptor mDescriptor;
+        juce::int64 mStartTicks;
+
+    public:
+        //==============================================================================
+        ScopedJob() = delete;
+        ~ScopedJob()
+        {
+            mScheduler.finishJob(mDescriptor, juce::Time::getHighResolutionTicks() - mStartTicks);
+        }
+
+        ScopedJob(ScopedJob const &) = delete;
+        ScopedJob(ScopedJob &&) = delete;
+
+        ScopedJob & operator=(ScopedJob const &) = delete;
+        ScopedJob & operator=(ScopedJob &&) = delete;
+        //==============================================================================
+        ScopedJob(DescriptorScheduler & scheduler, ScheduledDescriptor descriptor) noexcept
+            : mScheduler(scheduler)
+            , mDescriptor(descriptor)
+            , mStartTicks(juce::Time::getHighResolutionTicks())
+        {
+        }
+
+    private:
+        //==============================================================================
+        JUCE_LEAK_DETECTOR(ScopedJob)
+    };
+
+    //==============================================================================
+    static constexpr double DEFAULT_PITCH_RATE_HZ{ 20.0 };
+    static constexpr double DEFAULT_SHAPE_RATE_HZ{ 40.0 };
+    /** Measured per frame at 48 kHz: about 940 us for the pitch of the largest window (32768 samples), 250 us for
+     * the pitch of an 8192 sample window and about as much for the shape, which also runs an 8192 point FFT. The
+     * default admits the most expensive pitch frame on its own, so that it does not depend on the starvation
+     * bypass, but not with a shape frame on the same block.
+     */
+    static constexpr double DEFAULT_BUDGET_US{ 1000.0 };
+    static constexpr double MIN_BUDGET_US{ 100.0 };
+    static constexpr double MAX_BUDGET_US{ 5000.0 };
+
+    //==============================================================================
+    DescriptorScheduler()
+    {
+        setRateHz(ScheduledDescriptor::pitch, DEFAULT_PITCH_RATE_HZ);
+        setRateHz(ScheduledDescriptor::shape, DEFAULT_SHAPE_RATE_HZ);
+    }
+
+    /** Must not be called while the analysis is running. */
+    void prepare(double sampleRate)
+    {
+        mSampleRate = sampleRate;
+        for (size_t i{}; i < mJobs.size(); ++i) {
+            auto & job{ mJobs[i] };
+            // Staggers the descriptors so that they do not all become due on the same block.
+            job.elapsedSamples = getPeriodSamples(job) * static_cast<double>(mJobs.size() - i)
+                                 / static_cast<double>(mJobs.size());
+            job.estimatedCostUs = 0.0;
+            job.isActive = false;
+            job.isAdmitted = false;
+        }
+    }
+
+    //==============================================================================
+    // Any thread
+    void setRateHz(ScheduledDescriptor descriptor, double rateHz)
+    {
+        jassert(rateHz > 0.0);
+        mJobs[static_cast<size_t>(descriptor)].rateHz.store(rateHz, std::memory_order_relaxed);
+    }
+
+    /** CPU time the scheduled descriptors may use on a single block, between MIN_BUDGET_US and MAX_BUDGET_US. */
+    void setBudgetUs(double budgetUs)
+    {
+        mBudgetUs.store(juce::jlimit(MIN_BUDGET_US, MAX_BUDGET_US, budgetUs), std::memory_order_relaxed);
+    }
+    double getBudgetUs() const { return mBudgetUs.load(std::memory_order_relaxed); }
+
+    //==============================================================================
+    // Analysis thread
+    void setActive(ScheduledDescriptor descriptor, bool isActive)
+    {
+        mJobs[static_cast<size_t>(descriptor)].isActive = isActive;
+    }
+
+    /** Advances the clocks of the active descriptors and chooses the ones that run during this block. */
+    void beginBlock(int numSamples) noexcept
+    {
+        std::array<Job *, static_cast<size_t>(ScheduledDescriptor::count)> dueJobs{};
+        size_t numDueJobs{};
+
+        for (auto & job : mJobs) {
+            job.isAdmitted = false;
+            if (!job.isActive) {
+                continue;
+            }
+            job.elapsedSamples += static_cast<double>(numSamples);
+            if (job.elapsedSamples >= getPeriodSamples(job)) {
+                dueJobs[numDueJobs++] = &job;
+            }
+        }
+
+        // The latest descriptors, relative to their own period, get the budget first.
+        std::sort(dueJobs.begin(), dueJobs.begin() + static_cast<std::ptrdiff_t>(numDueJobs), [this](Job * a, Job * b) {
+            return a->elapsedSamples / getPeriodSamples(*a) > b->elapsedSamples / getPeriodSamples(*b);
+        });
+
+        auto const budgetUs{ getBudgetUs() };
+        double plannedUs{};
+        for (size_t i{}; i < numDueJobs; ++i) {
+            auto & job{ *dueJobs[i] };
+            auto const isStarving{ job.elapsedSamples >= 2.0 * getPeriodSamples(job) };
+            if (isStarving || plannedUs + job.estimatedCostUs <= budgetUs) {
+                job.isAdmitted = true;
+                plannedUs += job.estimatedCostUs;
+            }
+        }
+    }
+
+    bool shouldRun(ScheduledDescriptor descriptor) const noexcept
+    {
+        return mJobs[static_cast<size_t>(descriptor)].isAdmitted;
+    }
+
+private:
+    //==============================================================================
+    struct Job {
+        std::atomic<double> rateHz{};
+        double elapsedSamples{};
+        double estimatedCostUs{};
+        bool isActive{};
+        bool isAdmitted{};
+    };
+
+    //==============================================================================
+    double getPeriodSamples(Job const & job) const noexcept
+    {
+        return mSampleRate / job.rateHz.load(std::memory_order_relaxed);
+    }
+
+    void finishJob(ScheduledDescriptor descriptor, juce::int64 ticks) noexcept
+    {
+        static constexpr double COST_SMOOTHING{ 0.2 };
+
+        auto & job{ mJobs[static_cast<size_t>(descriptor)] };
+        auto const costUs{ juce::Time::highResolutionTicksToSeconds(ticks) * 1e6 };
+        job.estimatedCostUs += (costUs - job.estimatedCostUs) * COST_SMOOTHING;
+
+        // Keeps the descriptor on its own grid unless it is late by more than a period.
+        auto const period{ getPeriodSamples(job) };
+        job.elapsedSamples = std::min(job.elapsedSamples - period, period - 1.0);
+        job.elapsedSamples = std::max(job.elapsedSamples, 0.0);
+        job.isAdmitted = false;
+    }
+
+    //==============================================================================
+    std::array<Job, static_cast<size_t>(ScheduledDescriptor::count)> mJobs{};
+    std::atomic<double> mBudgetUs{ DEFAULT_BUDGET_US };
+    double mSampleRate{ 48000.0 };
+
+    //==============================================================================
+    JUCE_LEAK_DETECTOR(DescriptorScheduler)
+};
+} // namespace gris
@@ -31,7 +31,23 @@
 namespace gris
 {
 //==============================================================================
-enum class DescriptorID { invalid = -1, loudness = 0, centroid, spread, noise, pitch, iterationsSpeed };
+enum class DescriptorID {
+    invalid = -1,
+    loudness = 0,
+    centroid,
+    spread,
+    noise,
+    pitch,
+    iterationsSpeed,
+    flux,
+    rolloff,
+    crest,
+    lowBandEnergy,
+    midBandEnergy,
+    highBandEnergy
+};
+
+static constexpr size_t NUM_DESCRIPTOR_IDS{ static_cast<size_t>(DescriptorID::highBandEnergy) + 1 };
 
 class Descriptor
 {
@@ -63,23 +79,27 @@ public:
             return DescriptorID::pitch;
         case 7:
             return DescriptorID::iterationsSpeed;
+        case 8:
+            return DescriptorID::flux;
+        case 9:
+            return DescriptorID::rolloff;
+        case 10:
+            return DescriptorID::crest;
+        case 11:
+            return DescriptorID::lowBandEnergy;
+        case 12:
+            return DescriptorID::midBandEnergy;
+        case 13:
+            return DescriptorID::highBandEnergy;
         default:
             return DescriptorID::invalid;
         }
     }
 
-    fluid::RealVector computeStats(fluid::RealMatrixView matrix, fluid::algorithm::MultiStats stats)
+    /** The descriptors computed by SpectralFeatures. They are normalized to [0, 1] and share their settings. */
+    static bool isSpectralFeature(DescriptorID descID)
     {
-        mDim = matrix.cols();
-        fluid::RealMatrix resMat(mDim, 7);
-        mResult.resize(mDim * 7);
-        stats.process(matrix.transpose(), resMat);
-
-        for (int j = 0; j < mDim; j++) {
-            mResult(fluid::Slice(j * 7, 7)) <<= resMat.row(j);
-        }
-
-        return mResult;
+        return descID >= DescriptorID::flux && descID <= DescriptorID::highBandEnergy;
     }
 
 protected:
@@ -88,10 +108,6 @@ protected:
     int mRunningStatsHistory = 1;
 
 private:
-    //==============================================================================
-    fluid::index mDim;
-    fluid::RealVector mResult;
-
     //==============================================================================
     JUCE_LEAK_DETECTOR(Descriptor)
 };
@@ -46,13 +46,10 @@ public:
 
     void process(fluid::RealVector & shapeStats)
     {
-        // TODO : use members instead of instanciating
-        fluid::RealVector flatnessMeanRes = fluid::RealVector(1);
-        fluid::RealVector flatnessStdDevRes = fluid::RealVector(1);
-        fluid::RealVectorView flatnessData = fluid::RealVectorView(shapeStats(fluid::Slice(5 * 7, 1)));
+        fluid::RealVectorView flatnessData = fluid::RealVectorView(shapeStats(fluid::Slice(5, 1)));
         // we don't really need mean and stdDev...
-        // fluid::RealVectorView flatnessMeanOut = fluid::RealVectorView(flatnessMeanRes);
-        // fluid::RealVectorView flatnessStdDevOut = fluid::RealVectorView(flatnessStdDevRes);
+        // fluid::RealVectorView flatnessMeanOut = fluid::RealVectorView(mFlatnessMeanRes);
+        // fluid::RealVectorView flatnessStdDevOut = fluid::RealVectorView(mFlatnessStdDevRes);
         // mFlatnessRunningStats->process(flatnessData, flatnessMeanOut, flatnessStdDevOut);
         // mDescFlatness = flatnessMeanOut[0];
         mDescFlatness = flatnessData[0];
@@ -0,0 +1,140 @@
+/*
+ This file is part of ControlGris.
+
+ Developers: Hicheme BEN GAIED, Gaël LANE LÉPINE
+
+ ControlGris is free software: you can redistribute it and/or modify
+ it under the terms of the GNU Lesser General Public License as
+ published by the Free Software Foundation, either version 3 of the
+ License, or (at your option) any later version.
+
+ ControlGris is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with ControlGris.  If not, see
+ <http://www.gnu.org/licenses/>.
+*/
+
+//==============================================================================
+
+#pragma once
+
+#include "cg_Descriptors.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace gris
+{
+//==============================================================================
+/** Preallocated memory for the work arrays of the FluCoMa algorithms.
+ *
+ * YINFFT, SpectralShape and OnsetDetectionFunctions allocate their work arrays on every processFrame() call, through
+ * the fluid::Allocator they are given. Given getAllocator(), these arrays are carved out of the buffer allocated by
+ * reset() instead of the heap. A frame frees all its arrays before processFrame() returns, so the buffer is rewound
+ * as soon as no array is left.
+ *
+ * An array that does not fit falls back on the heap and asserts: the size given to reset() must cover the largest
+ * frame. An arena must only be used by one thread at a time.
+ */
+class FrameArena
+{
+public:
+    //==============================================================================
+    // Makes the arena a foonathan RawAllocator, referenced by the fluid::Allocator.
+    using is_stateful = std::true_type;
+
+    static constexpr size_t MAX_ALIGNMENT{ alignof(std::max_align_t) };
+
+    //==============================================================================
+    FrameArena() = default;
+    ~FrameArena() = default;
+
+    // mAllocator refers to this object.
+    FrameArena(FrameArena const &) = delete;
+    FrameArena(FrameArena &&) = delete;
+
+    FrameArena & operator=(FrameArena const &) = delete;
+    FrameArena & operator=(FrameArena &&) = delete;
+    //==============================================================================
+    /** Size of a buffer holding numValues values of type T spread over numArrays arrays. */
+    template<typename T>
+    static constexpr size_t getRequiredBytes(fluid::index numValues, int numArrays)
+    {
+        return static_cast<size_t>(numValues) * sizeof(T) + static_cast<size_t>(numArrays) * MAX_ALIGNMENT;
+    }
+
+    void reset(size_t numBytes)
+    {
+        jassert(mNumLiveArrays == 0);
+        mBuffer.assign(numBytes, std::byte{});
+        mTop = 0;
+    }
+
+    /** Frees what reset() allocated. reset() must be called again before the next use. */
+    void release()
+    {
+        jassert(mNumLiveArrays == 0);
+        mBuffer = std::vector<std::byte>{};
+        mTop = 0;
+    }
+
+    fluid::Allocator & getAllocator() noexcept { return mAllocator; }
+
+    //==============================================================================
+    void * allocate_node(std::size_t size, std::size_t alignment) noexcept
+    {
+        // Aligned like the heap, so that Eigen vectorises the arrays the same way and the results stay bit for bit
+        // those of the default allocator.
+        alignment = std::max(alignment, MAX_ALIGNMENT);
+        auto const bufferAddress{ reinterpret_cast<std::uintptr_t>(mBuffer.data()) };
+        auto const address{ (bufferAddress + mTop + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1) };
+        auto const top{ static_cast<size_t>(address - bufferAddress) + size };
+        if (mBuffer.empty() || top > mBuffer.size()) {
+            // The size given to reset() is too small for this frame.
+            jassertfalse;
+            return ::operator new(size, std::align_val_t{ alignment }, std::nothrow);
+        }
+
+        mTop = top;
+        ++mNumLiveArrays;
+        return reinterpret_cast<void *>(address);
+    }
+
+    void deallocate_node(void * node, std::size_t /*size*/, std::size_t alignment) noexcept
+    {
+        if (!isInBuffer(node)) {
+            ::operator delete(node, std::align_val_t{ alignment }, std::nothrow);
+            return;
+        }
+
+        jassert(mNumLiveArrays > 0);
+        if (--mNumLiveArrays == 0) {
+            mTop = 0;
+        }
+    }
+
+private:
+    //==============================================================================
+    bool isInBuffer(void const * node) const noexcept
+    {
+        auto const * const bytes{ static_cast<std::byte const *>(node) };
+        return !mBuffer.empty() && bytes >= mBuffer.data() && bytes < mBuffer.data() + mBuffer.size();
+    }
+
+    //==============================================================================
+    std::vector<std::byte> mBuffer;
+    size_t mTop{};
+    int mNumLiveArrays{};
+    fluid::Allocator mAllocator{ *this };
+
+    //==============================================================================
+    JUCE_LEAK_DETECTOR(FrameArena)
+};
+} // namespace gris
@@ -23,84 +23,203 @@
 #pragma once
 
 #include "cg_Descriptors.hpp"
+
+#include <cmath>
 #include <vector>
 
 namespace gris
 {
 //==============================================================================
+/** Integration window of the loudness, as defined by EBU R 128. */
+enum class LoudnessWindow { momentary = 0, shortTerm };
+
+//==============================================================================
+/** Streaming loudness of the analysed signal, as defined by ITU-R BS.1770.
+ *
+ * Every incoming sample goes once through the K-weighting filters, a high shelf followed by a high-pass, and its
+ * energy is accumulated in slices of SLICE_TIME_S. The loudness is the mean square of the slices covering the
+ * momentary (400 ms) or the short-term (3 s) window. Since the filters and the integrator keep their state from one
+ * block to the next, the value does not depend on the block size and no sample is analysed twice.
+ *
+ * The slices of the longest window are always kept, so switching windows does not lose any history. Nothing is
+ * allocated by process() or setWindow() after reset().
+ */
 class LoudnessD : public Descriptor
 {
 public:
     //==============================================================================
-    LoudnessD()
-    {
-        mID = DescriptorID::loudness;
-        mLoudnessMeanRes = fluid::RealVector(1);
-        mLoudnessStdDevRes = fluid::RealVector(1);
-    }
+    static constexpr double MOMENTARY_TIME_S{ 0.4 };
+    static constexpr double SHORT_TERM_TIME_S{ 3.0 };
+    static constexpr double SLICE_TIME_S{ 0.01 };
+    // Same floor as the frame based FluCoMa loudness.
+    static constexpr double SILENCE_MEAN_SQUARE{ 1e-10 };
+
+    //==============================================================================
+    LoudnessD() { mID = DescriptorID::loudness; }
 
-    void init(double mSampleRate)
+    void init(double sampleRate)
     {
-        mLoudness->init(WINDOW_SIZE, mSampleRate);
-        mLoudnessRunningStats->init(mRunningStatsHistory, 1);
+        // Coefficients from libebur128, valid at any sample rate.
+        auto const pi{ juce::MathConstants<double>::pi };
+
+        auto const shelfK{ std::tan(pi * 1681.974450955533 / sampleRate) };
+        auto const shelfQ{ 0.7071752369554196 };
+        auto const vh{ std::pow(10.0, 3.999843853973347 / 20.0) };
+        auto const vb{ std::pow(vh, 0.4996667741545416) };
+        auto const shelfA0{ 1.0 + shelfK / shelfQ + shelfK * shelfK };
+        mShelf = Biquad{ (vh + vb * shelfK / shelfQ + shelfK * shelfK) / shelfA0,
+                         2.0 * (shelfK * shelfK - vh) / shelfA0,
+                         (vh - vb * shelfK / shelfQ + shelfK * shelfK) / shelfA0,
+                         2.0 * (shelfK * shelfK - 1.0) / shelfA0,
+                         (1.0 - shelfK / shelfQ + shelfK * shelfK) / shelfA0 };
+
+        auto const highPassK{ std::tan(pi * 38.13547087602444 / sampleRate) };
+        auto const highPassQ{ 0.5003270373238773 };
+        auto const highPassA0{ 1.0 + highPassK / highPassQ + highPassK * highPassK };
+        mHighPass = Biquad{ 1.0,
+                            -2.0,
+                            1.0,
+                            2.0 * (highPassK * highPassK - 1.0) / highPassA0,
+                            (1.0 - highPassK / highPassQ + highPassK * highPassK) / highPassA0 };
+
+        mSliceLength = std::max(juce::roundToInt(SLICE_TIME_S * sampleRate), 1);
+        mSliceSum = 0.0;
+        mSliceCount = 0;
+        std::fill(mSlices.begin(), mSlices.end(), 0.0);
+        mNextSlice = 0;
+        mNumSlices = 0;
+        mWindowSum = 0.0;
+        mDescLoudness = toLoudness(0.0);
     }
 
-    void reset() override
+    void reset() override { mSlices.assign(static_cast<size_t>(MAX_NUM_SLICES), 0.0); }
+
+    /** Frees what reset() allocated. reset() and init() must be called again before the next use. */
+    void release() { mSlices = std::vector<double>{}; }
+
+    /** Can be called between two blocks. The new window applies to the next value. */
+    void setWindow(LoudnessWindow const window) noexcept
     {
-        mLoudness.reset(new fluid::algorithm::Loudness{ WINDOW_SIZE });
-        mLoudnessRunningStats.reset(new fluid::algorithm::RunningStats());
+        auto const numWindowSlices{ getNumSlices(window) };
+        if (numWindowSlices == mNumWindowSlices) {
+            return;
+        }
+        mNumWindowSlices = numWindowSlices;
+        mWindowSum = sumWindow();
     }
 
+    /** Loudness in LUFS. */
     double getValue() override { return mDescLoudness; }
 
-    void process(fluid::RealMatrix & loudnessMat, fluid::algorithm::MultiStats & stats)
+    void process(double const * data, int numSamples) noexcept
     {
-        mLoudnessStats = computeStats(loudnessMat, stats);
-
-        fluid::RealVectorView loudnessData = fluid::RealVectorView(mLoudnessStats(fluid::Slice(0, 1)));
-        fluid::RealVectorView loudnessMeanOut = fluid::RealVectorView(mLoudnessMeanRes);
-        fluid::RealVectorView loudnessStdDevOut = fluid::RealVectorView(mLoudnessStdDevRes);
-
-        mLoudnessRunningStats->process(loudnessData, loudnessMeanOut, loudnessStdDevOut);
-
-        mDescLoudness = loudnessMeanOut[0];
+        jassert(mSlices.size() == static_cast<size_t>(MAX_NUM_SLICES));
+
+        int position{};
+        while (position < numSamples) {
+            auto const numToProcess{ std::min(mSliceLength - mSliceCount, numSamples - position) };
+            for (int i{}; i < numToProcess; ++i) {
+                auto const weighted{ mHighPass.process(mShelf.process(data[position + i])) };
+                mSliceSum += weighted * weighted;
+            }
+            mSliceCount += numToProcess;
+            position += numToProcess;
+
+            if (mSliceCount == mSliceLength) {
+                pushSlice();
+            }
+        }
+
+        // The slice being filled is part of the window, so the value follows the signal within a block.
+        auto const numWindowSamples{ std::min(mNumSlices, mNumWindowSlices) * mSliceLength + mSliceCount };
+        auto const meanSquare{ numWindowSamples > 0 ? (mWindowSum + mSliceSum) / static_cast<double>(numWindowSamples)
+                                                    : 0.0 };
+        mDescLoudness = toLoudness(meanSquare);
     }
 
-    void loudnessProcess(fluid::RealVectorView & window, fluid::RealVector & loudnessDesc)
+private:
+    //==============================================================================
+    /** Transposed direct form II. */
+    struct Biquad {
+        double b0{ 1.0 };
+        double b1{};
+        double b2{};
+        double a1{};
+        double a2{};
+        double z1{};
+        double z2{};
+
+        double process(double const x) noexcept
+        {
+            auto const y{ b0 * x + z1 };
+            z1 = b1 * x - a1 * y + z2;
+            z2 = b2 * x - a2 * y;
+            return y;
+        }
+    };
+
+    static constexpr int MAX_NUM_SLICES{ static_cast<int>(SHORT_TERM_TIME_S / SLICE_TIME_S + 0.5) };
+
+    static constexpr int getNumSlices(LoudnessWindow const window) noexcept
     {
-        mLoudness->processFrame(window, loudnessDesc, true, true);
+        auto const timeS{ window == LoudnessWindow::shortTerm ? SHORT_TERM_TIME_S : MOMENTARY_TIME_S };
+        return static_cast<int>(timeS / SLICE_TIME_S + 0.5);
     }
 
-    fluid::RealVectorView calculateWindow(fluid::RealVector & padded, int & i)
+    //==============================================================================
+    void init() override {}
+
+    static double toLoudness(double meanSquare) { return -0.691 + 10.0 * std::log10(meanSquare + SILENCE_MEAN_SQUARE); }
+
+    void pushSlice() noexcept
     {
-        return padded(fluid::Slice(i * HOPSIZE, WINDOW_SIZE));
+        // Once the window is full, its oldest slice leaves it. It is read before being overwritten, since it is also
+        // the oldest slice of the ring when the window is the longest one.
+        if (mNumSlices >= mNumWindowSlices) {
+            auto const oldestSlice{ (mNextSlice + MAX_NUM_SLICES - mNumWindowSlices) % MAX_NUM_SLICES };
+            mWindowSum -= mSlices[static_cast<size_t>(oldestSlice)];
+        }
+        mWindowSum += mSliceSum;
+        mSlices[static_cast<size_t>(mNextSlice)] = mSliceSum;
+        mNextSlice = (mNextSlice + 1) % MAX_NUM_SLICES;
+        mNumSlices = std::min(mNumSlices + 1, MAX_NUM_SLICES);
+        mSliceSum = 0.0;
+        mSliceCount = 0;
+
+        // Sums the window again once per turn of the ring, so that rounding errors do not pile up.
+        if (mNextSlice == 0) {
+            mWindowSum = sumWindow();
+        }
     }
 
-    fluid::RealVector calculatePadded(fluid::RealVector in) { return in.size() + WINDOW_SIZE + HOPSIZE; }
-
-    fluid::index calculateFrames(fluid::RealVector padded)
+    /** Energy of the complete slices in the window, newest first. */
+    double sumWindow() const noexcept
     {
-        return static_cast<fluid::index>(floor((padded.size() - WINDOW_SIZE) / HOPSIZE));
+        double sum{};
+        auto const numSlices{ std::min(mNumSlices, mNumWindowSlices) };
+        for (int i{ 1 }; i <= numSlices; ++i) {
+            sum += mSlices[static_cast<size_t>((mNextSlice + MAX_NUM_SLICES - i) % MAX_NUM_SLICES)];
+        }
+        return sum;
     }
 
-    fluid::Slice paddedValue(fluid::RealVector in) { return fluid::Slice(HALF_WINDOW, in.size()); }
+    //==============================================================================
+    Biquad mShelf{};
+    Biquad mHighPass{};
 
-    static constexpr fluid::index WINDOW_SIZE = 512;
-    static constexpr fluid::index HALF_WINDOW = WINDOW_SIZE / 2;
+    // Energy of the last MAX_NUM_SLICES complete slices, oldest overwritten first.
+    std::vector<double> mSlices;
+    int mNextSlice{};
+    int mNumSlices{};
+    // The window covers the last mNumWindowSlices of them.
+    int mNumWindowSlices{ getNumSlices(LoudnessWindow::momentary) };
+    double mWindowSum{};
 
-private:
-    //==============================================================================
-    void init() override {}
+    int mSliceLength{ 1 };
+    int mSliceCount{};
+    double mSliceSum{};
 
-    //==============================================================================
-    std::unique_ptr<fluid::algorithm::RunningStats> mLoudnessRunningStats;
     double mDescLoudness{};
-    std::unique_ptr<fluid::algorithm::Loudness> mLoudness;
-
-    static constexpr fluid::index HOPSIZE = 256;
-    fluid::RealVector mLoudnessStats;
-    fluid::RealVector mLoudnessMeanRes;
-    fluid::RealVector mLoudnessStdDevRes;
 
     //==============================================================================
     JUCE_LEAK_DETECTOR(LoudnessD)
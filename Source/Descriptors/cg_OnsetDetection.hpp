@@ -24,45 +24,27 @@
 
 #include <JuceHeader.h>
 
-#include "cg_Descriptors.hpp"
+#include "cg_OnsetDetectionFunctionCache.hpp"
 
 #include <Containers/sg_CircularDeque.hpp>
 
 namespace gris
 {
 //==============================================================================
+/** Iterations speed of one spatial parameter.
+ *
+ * Picks the peaks of the onset detection function shared through OnsetDetectionFunctionCache with its own threshold,
+ * minimum time and maximum time.
+ */
 class OnsetDetectionD : public Descriptor
 {
     enum class Direction { up, down };
 
 public:
     //==============================================================================
-    OnsetDetectionD()
-    {
-        mID = DescriptorID::iterationsSpeed;
-        mOnsetDetectionUnusedSamples.resize(0);
-        mOnsetIn.resize(0);
-        mOnsetPadded.resize(0);
-    }
-
-    void init() override { mOnsetDetection->init(WINDOW_SIZE, FFT_SIZE, mOnsetDetectionFilterSize); }
+    OnsetDetectionD() { mID = DescriptorID::iterationsSpeed; }
 
-    void reset(int block_size)
-    {
-        mOnsetIn.resize(NUM_SAMPLES_TO_PROCESS);
-        mOnsetDetection.reset(new fluid::algorithm::OnsetDetectionFunctions(WINDOW_SIZE,
-                                                                            mOnesetDetectionMetric,
-                                                                            fluid::FluidDefaultAllocator()));
-        mOnsetDetectionUnusedSamples.resize(NUM_SAMPLES_TO_PROCESS);
-        mOnsetPadded.resize(mOnsetIn.size() + WINDOW_SIZE + HOP_SIZE);
-        // There are at most block_size + the amount of unused samples from last process
-        // samples in the buffer.
-        const auto all_sample_size = block_size + NUM_SAMPLES_TO_PROCESS;
-        mAllSamples.reserve(all_sample_size);
-        const auto nOnsetFrames = static_cast<int>((mOnsetPadded.size() - WINDOW_SIZE) / HOP_SIZE);
-        // reserve the worst case for this.
-        mOnsetDectectionVals.reserve(nOnsetFrames * all_sample_size / NUM_SAMPLES_TO_PROCESS);
-    }
+    void init() override {}
 
     void reset() override {}
 
@@ -80,6 +62,8 @@ public:
         mDescOnsetDetectionCurrent = 0.0;
     }
 
+    fluid::index getOnsetDetectionMetric() const { return mOnesetDetectionMetric; }
+
     void setOnsetDetectionMinTime(const double minTime)
     {
         mOnsetDetectionTimeMin = minTime * 1000;
@@ -98,55 +82,11 @@ public:
         mUseTimerButtonclickValue = true;
     }
 
-    void process(juce::AudioBuffer<float> & descriptorBuffer, double sampleRate, int blockSize)
+    /** Must be called after onsetDetectionFunctions.push(), with this descriptor's metric subscribed. */
+    void process(OnsetDetectionFunctionCache & onsetDetectionFunctions, double sampleRate, int blockSize)
     {
-        mAllSamples.clear();
-
-        mOnsetDectectionVals.clear();
-        auto * channelData = descriptorBuffer.getReadPointer(0);
-        int nFramesDivider{};
-        auto nSamplesDescBuf{ descriptorBuffer.getNumSamples() };
-
-        // get unprocessed samples from last processBlock call
-        for (int i{}; i < mLastUnusedSampleIndex; ++i) {
-            mAllSamples.push_back(static_cast<float>(mOnsetDetectionUnusedSamples[i]));
-        }
-        // get new samples
-        for (int i{}; i < nSamplesDescBuf; ++i) {
-            mAllSamples.push_back(channelData[i]);
-        }
-        for (int i{}; i < mAllSamples.size() / NUM_SAMPLES_TO_PROCESS; ++i) {
-            std::fill(mOnsetIn.begin(), mOnsetIn.end(), 0); // necessary?
-            for (int j{}; j < NUM_SAMPLES_TO_PROCESS; ++j) {
-                mOnsetIn[j] = mAllSamples[j + (i * NUM_SAMPLES_TO_PROCESS)];
-            }
-            fluid::index nOnsetFrames
-                = static_cast<fluid::index>(floor((mOnsetPadded.size() - WINDOW_SIZE) / HOP_SIZE));
-            nFramesDivider = static_cast<int>(nOnsetFrames);
-
-            std::fill(mOnsetPadded.begin(), mOnsetPadded.end(), 0);
-            std::copy(mOnsetIn.begin(), mOnsetIn.end(), mOnsetPadded.begin() + WINDOW_SIZE / 2);
-            for (int k = 0; k < nOnsetFrames; k++) {
-                mWindowOD = mOnsetPadded(fluid::Slice(k * HOP_SIZE, WINDOW_SIZE));
-                mOnsetDectectionVals.push_back(mOnsetDetection->processFrame(mWindowOD,
-                                                                             mOnesetDetectionMetric,
-                                                                             1,
-                                                                             0 /*more than 0 gives assert*/,
-                                                                             fluid::FluidDefaultAllocator()));
-            }
-        }
-
-        // store unused samples
-        if (mAllSamples.size() % NUM_SAMPLES_TO_PROCESS != 0) {
-            mLastUnusedSampleIndex = mAllSamples.size() % NUM_SAMPLES_TO_PROCESS;
-            for (int i = static_cast<int>(mAllSamples.size()) / NUM_SAMPLES_TO_PROCESS * NUM_SAMPLES_TO_PROCESS, j = 0;
-                 i < mAllSamples.size();
-                 ++i, ++j) {
-                mOnsetDetectionUnusedSamples[j] = mAllSamples[i];
-            }
-        } else {
-            mLastUnusedSampleIndex = 0;
-        }
+        auto const onsetDetectionVals{ onsetDetectionFunctions.getValues(mOnesetDetectionMetric) };
+        constexpr auto nFramesDivider{ OnsetDetectionFunctionCache::FRAMES_PER_CHUNK };
 
         if (mUseTimerButtonclickValue) {
             // when user clicks for Iterations Speed
@@ -172,8 +112,8 @@ public:
             }
         } else {
             // get onset detection from audio
-            for (int i{}; i < mOnsetDectectionVals.size(); ++i) {
-                if (mOnsetDectectionVals[i] >= mDescOnsetDetectionThreshold && mIsOnsetDetectionReady) {
+            for (fluid::index i{}; i < onsetDetectionVals.size(); ++i) {
+                if (onsetDetectionVals[i] >= mDescOnsetDetectionThreshold && mIsOnsetDetectionReady) {
                     mSampleCounter = 0;
                     mIsOnsetDetectionReady = false;
                     mOnsetDetectionStartCountingSamples = true;
@@ -200,11 +140,11 @@ public:
                             ? mOnsetDetectionDirection = Direction::up
                             : mOnsetDetectionDirection = Direction::down;
                     }
-                } else if (mOnsetDectectionVals[i] < mDescOnsetDetectionThreshold) {
+                } else if (onsetDetectionVals[i] < mDescOnsetDetectionThreshold) {
                     mIsOnsetDetectionReady = true;
                 }
                 if (mOnsetDetectionStartCountingSamples) {
-                    mOnsetDetectionNumSamples += NUM_SAMPLES_TO_PROCESS;
+                    mOnsetDetectionNumSamples += OnsetDetectionFunctionCache::CHUNK_SIZE;
                 }
             }
         }
@@ -232,14 +172,6 @@ public:
 
 private:
     //==============================================================================
-    std::unique_ptr<fluid::algorithm::OnsetDetectionFunctions> mOnsetDetection;
-
-    static constexpr fluid::index FFT_SIZE = 256;
-    static constexpr fluid::index HOP_SIZE = 64;
-    static constexpr fluid::index WINDOW_SIZE = 256;
-    static constexpr int NUM_SAMPLES_TO_PROCESS{ 256 };
-
-    fluid::index mOnsetDetectionFilterSize = 3;
     fluid::index mOnesetDetectionMetric = 9;
     double mOnsetDetectionTimeMin{ 100 };
     double mOnsetDetectionTimeMax{ 10000 };
@@ -253,19 +185,12 @@ private:
     bool mOnsetDetectionStartCountingSamples{};
     bool mIsOnsetDetectionReady{ true };
     juce::uint64 mOnsetDetectionNumSamples{};
-    fluid::RealVector mOnsetDetectionUnusedSamples;
-    int mLastUnusedSampleIndex{ 0 };
     static constexpr int maxTimeDequeSize{ 3 };
     CircularDeque<double, maxTimeDequeSize> mTimeSinceLastOnsetDetection{};
     Direction mOnsetDetectionDirection{};
     int mSampleCounter{};
     bool mUseTimerButtonclickValue{};
     double mTimerButtonClickvalue{};
-    std::vector<float> mAllSamples;
-    std::vector<double> mOnsetDectectionVals{};
-    fluid::RealVector mOnsetIn;
-    fluid::RealVector mOnsetPadded;
-    fluid::RealVectorView mWindowOD = mOnsetPadded(fluid::Slice(HOP_SIZE, WINDOW_SIZE));
 
     //==============================================================================
     JUCE_LEAK_DETECTOR(OnsetDetectionD)
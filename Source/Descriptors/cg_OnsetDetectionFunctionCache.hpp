@@ -0,0 +1,174 @@
+/*
+ This file is part of ControlGris.
+
+ Developers: Hicheme BEN GAIED, Gaël LANE LÉPINE
+
+ ControlGris is free software: you can redistribute it and/or modify
+ it under the terms of the GNU Lesser General Public License as
+ published by the Free Software Foundation, either version 3 of the
+ License, or (at your option) any later version.
+
+ ControlGris is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with ControlGris.  If not, see
+ <http://www.gnu.org/licenses/>.
+*/
+
+//==============================================================================
+
+#pragma once
+
+#include "cg_Descriptors.hpp"
+#include "cg_FrameArena.hpp"
+
+namespace gris
+{
+//==============================================================================
+/** Onset detection function frames shared by every iterations speed descriptor.
+ *
+ * The analysed signal is cut in chunks of CHUNK_SIZE samples, each chunk is zero padded and FRAMES_PER_CHUNK frames
+ * are taken from it. Descriptors subscribe to the metric they use and each subscribed metric is computed once per
+ * frame, whatever the number of descriptors reading it.
+ *
+ * Incoming samples are written straight into the middle of a fixed padded buffer and every frame is a slice of that
+ * buffer, so a sample is copied exactly once. Nothing is allocated by push() after reset().
+ */
+class OnsetDetectionFunctionCache
+{
+public:
+    //==============================================================================
+    static constexpr fluid::index NUM_METRICS{ 10 };
+    static constexpr fluid::index FFT_SIZE{ 256 };
+    static constexpr fluid::index HOP_SIZE{ 64 };
+    static constexpr fluid::index WINDOW_SIZE{ 256 };
+    static constexpr fluid::index FILTER_SIZE{ 3 };
+    static constexpr int CHUNK_SIZE{ 256 };
+    // A chunk is padded to CHUNK_SIZE + WINDOW_SIZE + HOP_SIZE samples.
+    static constexpr int FRAMES_PER_CHUNK{ static_cast<int>((CHUNK_SIZE + HOP_SIZE) / HOP_SIZE) };
+
+    //==============================================================================
+    OnsetDetectionFunctionCache() = default;
+
+    void reset(int blockSize)
+    {
+        for (auto & function : mFunctions) {
+            function.reset(new fluid::algorithm::OnsetDetectionFunctions(WINDOW_SIZE,
+                                                                         FILTER_SIZE,
+                                                                         fluid::FluidDefaultAllocator()));
+            function->init(WINDOW_SIZE, FFT_SIZE, FILTER_SIZE);
+        }
+        mFrameArena.reset(FRAME_ARENA_SIZE);
+
+        mNumChunkSamples = 0;
+        mPaddedChunk.resize(CHUNK_SIZE + WINDOW_SIZE + HOP_SIZE);
+        mPaddedChunk.fill(0.0);
+
+        // A block completes at most one more chunk than it contains, because of the samples left from the last one.
+        mValues.resize(NUM_METRICS, getMaxFramesPerBlock(blockSize));
+        mValues.fill(0.0);
+        mNumFrames = 0;
+
+        mSubscriptions.fill(false);
+    }
+
+    /** Frees what reset() allocated. reset() must be called again before the next use. */
+    void release()
+    {
+        for (auto & function : mFunctions) {
+            function.reset();
+        }
+        mFrameArena.release();
+        mPaddedChunk = fluid::RealVector{};
+        mValues = fluid::RealMatrix{};
+        mNumChunkSamples = 0;
+        mNumFrames = 0;
+    }
+
+    void clearSubscriptions() { mSubscriptions.fill(false); }
+
+    void setSubscribed(fluid::index metric, bool shouldSubscribe)
+    {
+        jassert(metric >= 0 && metric < NUM_METRICS);
+        mSubscriptions[static_cast<size_t>(metric)] = shouldSubscribe;
+    }
+
+    bool isSubscribed(fluid::index metric) const { return mSubscriptions[static_cast<size_t>(metric)]; }
+
+    /** Analyses new samples with every subscribed metric. Returns the number of frames produced by this call. */
+    int push(double const * data, int numSamples)
+    {
+        mNumFrames = 0;
+
+        int numConsumed{};
+        while (numConsumed < numSamples) {
+            auto const numToCopy{ std::min(CHUNK_SIZE - mNumChunkSamples, numSamples - numConsumed) };
+            for (int i{}; i < numToCopy; ++i) {
+                mPaddedChunk[CHUNK_OFFSET + mNumChunkSamples + i] = data[numConsumed + i];
+            }
+            mNumChunkSamples += numToCopy;
+            numConsumed += numToCopy;
+
+            if (mNumChunkSamples == CHUNK_SIZE) {
+                processChunk();
+                mNumChunkSamples = 0;
+            }
+        }
+
+        return mNumFrames;
+    }
+
+    /** Values of the last push() for the given metric. Only meaningful if the metric was subscribed. */
+    fluid::RealVectorView getValues(fluid::index metric)
+    {
+        return mValues.row(metric)(fluid::Slice(0, mNumFrames));
+    }
+
+    static int getMaxFramesPerBlock(int blockSize) { return (blockSize / CHUNK_SIZE + 1) * FRAMES_PER_CHUNK; }
+
+private:
+    //==============================================================================
+    void processChunk()
+    {
+        for (int frame{}; frame < FRAMES_PER_CHUNK; ++frame) {
+            auto window{ mPaddedChunk(fluid::Slice(frame * HOP_SIZE, WINDOW_SIZE)) };
+            for (fluid::index metric{}; metric < NUM_METRICS; ++metric) {
+                if (!isSubscribed(metric)) {
+                    continue;
+                }
+                mValues(metric, mNumFrames) = mFunctions[static_cast<size_t>(metric)]->processFrame(
+                    window,
+                    metric,
+                    1,
+                    0 /*more than 0 gives assert*/,
+                    mFrameArena.getAllocator());
+            }
+            ++mNumFrames;
+        }
+    }
+
+    //==============================================================================
+    std::array<std::unique_ptr<fluid::algorithm::OnsetDetectionFunctions>, NUM_METRICS> mFunctions;
+    std::array<bool, NUM_METRICS> mSubscriptions{};
+
+    // The largest frame, a complex domain metric, works on the padded window, its spectrum, the target spectrum and
+    // three real arrays of the spectrum size. The metrics are computed one after the other and share the arena.
+    static constexpr fluid::index NUM_FRAME_BINS{ FFT_SIZE / 2 + 1 };
+    static constexpr size_t FRAME_ARENA_SIZE{ FrameArena::getRequiredBytes<double>(FFT_SIZE + 7 * NUM_FRAME_BINS, 6) };
+    FrameArena mFrameArena;
+
+    // Only the chunk in the middle of the padded buffer is ever written, so the zero padding is never touched again.
+    static constexpr fluid::index CHUNK_OFFSET{ WINDOW_SIZE / 2 };
+    fluid::RealVector mPaddedChunk;
+    int mNumChunkSamples{};
+
+    fluid::RealMatrix mValues;
+    int mNumFrames{};
+
+    //==============================================================================
+    JUCE_LEAK_DETECTOR(OnsetDetectionFunctionCache)
+};
+} // namespace gris
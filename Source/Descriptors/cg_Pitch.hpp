@@ -23,6 +23,8 @@
 #pragma once
 
 #include "cg_Descriptors.hpp"
+#include "cg_FrameArena.hpp"
+#include "cg_Stats.hpp"
 #include <vector>
 
 namespace gris
@@ -43,18 +45,24 @@ public:
 
     void reset() override
     {
-        mYin.reset(new fluid::algorithm::YINFFT{ NBINS, fluid::FluidDefaultAllocator() });
+        mYin.reset(new fluid::algorithm::YINFFT{ MAX_NBINS, fluid::FluidDefaultAllocator() });
         mPitchRunningStats.reset(new fluid::algorithm::RunningStats());
-        mStft.reset(new fluid::algorithm::STFT{ WINDOW_SIZE, FFT_SIZE, HOP_SIZE });
+        mFrameArena.reset(FRAME_ARENA_SIZE);
+    }
+
+    /** Frees what reset() allocated. reset() and init() must be called again before the next use. */
+    void release()
+    {
+        mYin.reset();
+        mPitchRunningStats.reset();
+        mFrameArena.release();
     }
 
     double getValue() override { return mDescPitch; }
 
-    void process(fluid::RealMatrix & pitchMat, fluid::algorithm::MultiStats & stats)
+    void process(fluid::RealMatrixView pitchMat, StatsD & stats)
     {
-        mPitchStats = computeStats(pitchMat, stats);
-
-        fluid::RealVectorView pitchData = fluid::RealVectorView(mPitchStats(fluid::Slice(0, 1)));
+        fluid::RealVectorView pitchData = stats.computeMeans(pitchMat)(fluid::Slice(0, 1));
         fluid::RealVectorView pitchMeanOut = fluid::RealVectorView(mPitchMeanRes);
         fluid::RealVectorView pitchStdDevOut = fluid::RealVectorView(mPitchStdDevRes);
 
@@ -63,60 +71,54 @@ public:
         mDescPitch = pitchMeanOut[0];
     }
 
-    void yinProcess(fluid::RealVector & magnitude, fluid::RealVector & pitch, double mSampleRate)
+    void yinProcess(fluid::RealVectorView magnitude, fluid::RealVector & pitch, double mSampleRate)
     {
-        mYin->processFrame(magnitude, pitch, MIN_FREQ, MAX_FREQ, mSampleRate, fluid::FluidDefaultAllocator());
+        mYin->processFrame(magnitude, pitch, mMinFreq, mMaxFreq, mSampleRate, mFrameArena.getAllocator());
     }
 
-    fluid::RealVectorView calculateWindow(fluid::RealVector & padded, int & i)
+    /** Restricts the YIN search to the frequencies requested by the spatial parameters. */
+    void setFrequencyRange(double minFreq, double maxFreq)
     {
-        return padded(fluid::Slice(i * HOP_SIZE, WINDOW_SIZE));
+        mMinFreq = std::clamp(minFreq, MIN_FREQ, MAX_FREQ);
+        mMaxFreq = std::clamp(maxFreq, mMinFreq, MAX_FREQ);
     }
 
-    fluid::RealVector calculatePadded(fluid::RealVector in) { return in.size() + WINDOW_SIZE + HOP_SIZE; }
-
-    fluid::index calculateFrames(fluid::RealVector padded)
+    /** Smallest analysis window holding MIN_PERIODS periods of the lowest analysed frequency. The window and the FFT
+     * have the same size.
+     */
+    static fluid::index getWindowSize(double minFreq, double sampleRate)
     {
-        return static_cast<fluid::index>(floor((padded.size() - WINDOW_SIZE) / HOP_SIZE));
+        auto const minLength{ MIN_PERIODS * sampleRate / std::clamp(minFreq, MIN_FREQ, MAX_FREQ) };
+        auto windowSize{ MIN_WINDOW_SIZE };
+        while (windowSize < MAX_WINDOW_SIZE && static_cast<double>(windowSize) < minLength) {
+            windowSize *= 2;
+        }
+        return windowSize;
     }
 
-    fluid::Slice paddedValue(fluid::RealVector in) { return fluid::Slice(HALF_WINDOW, in.size()); }
-
-    void setFrame(fluid::ComplexVector & frame) { frame.resize(NBINS); }
-
-    void setMagnitude(fluid::RealVector & magnitude) { magnitude.resize(NBINS); }
-
-    //==============================================================================
-    // Stft stuff
-    // Second argument is output
-    void stftProcess(fluid::RealVectorView & window, fluid::ComplexVector & frame)
-    {
-        mStft->processFrame(window, frame);
-    }
-
-    // Second argument is output
-    void stftMagnitude(fluid::ComplexVector & frame, fluid::RealVector & magnitude)
-    {
-        mStft->magnitude(frame, magnitude);
-    }
-
-    static constexpr fluid::index WINDOW_SIZE = 32768;
-    static constexpr fluid::index HALF_WINDOW = WINDOW_SIZE / 2;
+    // Spectral resolutions read from the SpectralFrameCache. Every power of two in between can be used.
+    static constexpr fluid::index MIN_WINDOW_SIZE = 2048;
+    static constexpr fluid::index MAX_WINDOW_SIZE = 32768;
+    static constexpr fluid::index MAX_NBINS = MAX_WINDOW_SIZE / 2 + 1;
 
 private:
     //==============================================================================
     std::unique_ptr<fluid::algorithm::RunningStats> mPitchRunningStats;
     double mDescPitch{};
     std::unique_ptr<fluid::algorithm::YINFFT> mYin;
-    std::unique_ptr<fluid::algorithm::STFT> mStft;
 
-    static constexpr fluid::index FFT_SIZE = 32768;
-    static constexpr fluid::index HOP_SIZE = 32768;
-    static constexpr fluid::index NBINS = 16385;
     static constexpr double MIN_FREQ = 20.0;
     static constexpr double MAX_FREQ = 10000.0;
+    static constexpr double MIN_PERIODS = 8.0;
+
+    // A YINFFT frame of n bins works on the squared magnitudes (n), their symmetric spectrum (2n), the difference
+    // function and its flipped copy (2n), the peaks (2n) and the best one (2).
+    static constexpr size_t FRAME_ARENA_SIZE{ FrameArena::getRequiredBytes<double>(7 * MAX_NBINS + 2, 6) };
+    FrameArena mFrameArena;
+
+    double mMinFreq{ MIN_FREQ };
+    double mMaxFreq{ MAX_FREQ };
 
-    fluid::RealVector mPitchStats;
     fluid::RealVector mPitchMeanRes;
     fluid::RealVector mPitchStdDevRes;
 
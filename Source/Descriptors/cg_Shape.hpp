@@ -23,6 +23,8 @@
 #pragma once
 
 #include "cg_Descriptors.hpp"
+#include "cg_FrameArena.hpp"
+#include "cg_Stats.hpp"
 
 namespace gris
 {
@@ -34,10 +36,17 @@ public:
     void reset() override
     {
         mShape.reset(new fluid::algorithm::SpectralShape(fluid::FluidDefaultAllocator()));
-        mStft.reset(new fluid::algorithm::STFT{ WINDOW_SIZE, FFT_SIZE, HOP_SIZE });
+        mFrameArena.reset(FRAME_ARENA_SIZE);
     }
 
-    void shapeProcess(fluid::RealVector & magnitude, fluid::RealVector & shapeDesc, double sampleRate)
+    /** Frees what reset() allocated. reset() must be called again before the next use. */
+    void release()
+    {
+        mShape.reset();
+        mFrameArena.release();
+    }
+
+    void shapeProcess(fluid::RealVectorView magnitude, fluid::RealVector & shapeDesc, double sampleRate)
     {
         mShape->processFrame(magnitude,
                              shapeDesc,
@@ -47,50 +56,21 @@ public:
                              0.95,
                              true,
                              true,
-                             fluid::FluidDefaultAllocator());
+                             mFrameArena.getAllocator());
     }
 
     fluid::algorithm::SpectralShape * getShape() const { return mShape.get(); }
 
-    fluid::RealVector process(fluid::RealMatrix & matrix, fluid::algorithm::MultiStats & stats)
-    {
-        return computeStats(matrix, stats);
-    }
-
-    fluid::RealVectorView calculateWindow(fluid::RealVector & padded, int & i)
+    // Writes the mean of each shape descriptor in shapeStats, in the SpectralShape output order.
+    void process(fluid::RealMatrixView matrix, StatsD & stats, fluid::RealVector & shapeStats)
     {
-        return padded(fluid::Slice(i * HOP_SIZE, WINDOW_SIZE));
-    }
-
-    fluid::RealVector calculatePadded(fluid::RealVector in) { return in.size() + WINDOW_SIZE + HOP_SIZE; }
-
-    fluid::index calculateFrames(fluid::RealVector padded)
-    {
-        return static_cast<fluid::index>(floor((padded.size() - WINDOW_SIZE) / HOP_SIZE));
-    }
-
-    fluid::Slice paddedValue(fluid::RealVector in) { return fluid::Slice(HALF_WINDOW, in.size()); }
-
-    void setFrame(fluid::ComplexVector & frame) { frame.resize(NBINS); }
-
-    void setMagnitude(fluid::RealVector & magnitude) { magnitude.resize(NBINS); }
-
-    //==============================================================================
-    // Stft stuff
-    // Second argument is output
-    void stftProcess(fluid::RealVectorView & window, fluid::ComplexVector & frame)
-    {
-        mStft->processFrame(window, frame);
-    }
-
-    // Second argument is output
-    void stftMagnitude(fluid::ComplexVector & frame, fluid::RealVector & magnitude)
-    {
-        mStft->magnitude(frame, magnitude);
+        shapeStats <<= stats.computeMeans(matrix);
     }
 
+    // Spectral resolution read from the SpectralFrameCache.
     static constexpr fluid::index WINDOW_SIZE = 4096;
-    static constexpr fluid::index HALF_WINDOW = WINDOW_SIZE / 2;
+    static constexpr fluid::index FFT_SIZE = 8192;
+    static constexpr fluid::index NBINS = FFT_SIZE / 2 + 1;
 
 private:
     //==============================================================================
@@ -98,14 +78,14 @@ private:
     double getValue() override { return 0; }
 
     std::unique_ptr<fluid::algorithm::SpectralShape> mShape;
-    std::unique_ptr<fluid::algorithm::STFT> mStft;
 
-    static constexpr fluid::index NBINS = 4097;
-    static constexpr fluid::index HOP_SIZE = 512;
-    static constexpr fluid::index FFT_SIZE = 8192;
     static constexpr double MIN_FREQ = 20.0;
     static constexpr double MAX_FREQ = 20000.0;
 
+    // A SpectralShape frame copies the magnitudes and derives the amplitudes and the bin frequencies from them.
+    static constexpr size_t FRAME_ARENA_SIZE{ FrameArena::getRequiredBytes<double>(4 * NBINS, 4) };
+    FrameArena mFrameArena;
+
     //==============================================================================
     JUCE_LEAK_DETECTOR(ShapeD)
 };
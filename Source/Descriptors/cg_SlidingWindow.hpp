@@ -0,0 +1,93 @@
+/*
+ This file is part of ControlGris.
+
+ Developers: Hicheme BEN GAIED, Gaël LANE LÉPINE
+
+ ControlGris is free software: you can redistribute it and/or modify
+ it under the terms of the GNU Lesser General Public License as
+ published by the Free Software Foundation, either version 3 of the
+ License, or (at your option) any later version.
+
+ ControlGris is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with ControlGris.  If not, see
+ <http://www.gnu.org/licenses/>.
+*/
+
+//==============================================================================
+
+#pragma once
+
+#include "cg_Descriptors.hpp"
+
+namespace gris
+{
+//==============================================================================
+/** Circular history of the analysed signal from which the most recent analysis window can be read at any time.
+ *
+ * The history is stored twice in a row (mirrored) so that the most recent window is always a contiguous slice and
+ * can be given to fluid::algorithm::STFT::processFrame() without any staging copy. Nothing is allocated after
+ * reset().
+ */
+class SlidingWindow
+{
+public:
+    //==============================================================================
+    SlidingWindow() = default;
+
+    void reset(fluid::index windowSize)
+    {
+        jassert(windowSize > 0);
+
+        mWindowSize = windowSize;
+        mHistory.resize(mWindowSize * 2);
+        clear();
+    }
+
+    /** Frees the history. reset() must be called again before the next use. */
+    void release()
+    {
+        mHistory = fluid::RealVector{};
+        mWindowSize = 1;
+        mWritePosition = 0;
+    }
+
+    void clear()
+    {
+        std::fill(mHistory.begin(), mHistory.end(), 0.0);
+        mWritePosition = 0;
+    }
+
+    /** Writes new samples in the history. */
+    void write(double const * data, int numSamples)
+    {
+        for (int i{}; i < numSamples; ++i) {
+            auto const sample{ data[i] };
+            mHistory[mWritePosition] = sample;
+            mHistory[mWritePosition + mWindowSize] = sample;
+
+            if (++mWritePosition == mWindowSize) {
+                mWritePosition = 0;
+            }
+        }
+    }
+
+    /** The last windowSize samples, oldest first. */
+    fluid::RealVectorView getWindow() { return mHistory(fluid::Slice(mWritePosition, mWindowSize)); }
+
+    fluid::index getWindowSize() const { return mWindowSize; }
+
+private:
+    //==============================================================================
+    fluid::RealVector mHistory;
+    fluid::index mWindowSize{ 1 };
+    fluid::index mWritePosition{};
+
+    //==============================================================================
+    JUCE_LEAK_DETECTOR(SlidingWindow)
+};
+} // namespace gris
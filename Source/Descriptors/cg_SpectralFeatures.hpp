@@ -0,0 +1,160 @@
+/*
+ This file is part of ControlGris.
+
+ Developers: Hicheme BEN GAIED, Gaël LANE LÉPINE
+
+ ControlGris is free software: you can redistribute it and/or modify
+ it under the terms of the GNU Lesser General Public License as
+ published by the Free Software Foundation, either version 3 of the
+ License, or (at your option) any later version.
+
+ ControlGris is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with ControlGris.  If not, see
+ <http://www.gnu.org/licenses/>.
+*/
+
+//==============================================================================
+
+#pragma once
+
+#include "cg_Descriptors.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace gris
+{
+//==============================================================================
+/** Spectral flux, rolloff, crest and band energies of a magnitude spectrum, all normalized to [0, 1].
+ *
+ * The features are derived from the spectrum already computed for the shape descriptors: a single pass over the bins
+ * accumulates every sum and the cumulative power, from which the rolloff is then found by bisection. No FFT is
+ * involved.
+ * - the flux is the half-wave rectified increase of the magnitudes since the previous frame, relative to the current
+ *   magnitudes;
+ * - the rolloff is the frequency under which ROLLOFF_RATIO of the power lies, on a logarithmic axis from MIN_FREQ to
+ *   the Nyquist frequency;
+ * - the crest is the ratio of the peak power to the mean power, in decibels relative to the largest possible ratio;
+ * - the band energies are the parts of the power below LOW_BAND_MAX_FREQ, between the two limits and above
+ *   MID_BAND_MAX_FREQ.
+ *
+ * Nothing is allocated by process() after reset().
+ */
+class SpectralFeatures
+{
+public:
+    //==============================================================================
+    static constexpr double MIN_FREQ{ 20.0 };
+    static constexpr double ROLLOFF_RATIO{ 0.95 };
+    static constexpr double LOW_BAND_MAX_FREQ{ 250.0 };
+    static constexpr double MID_BAND_MAX_FREQ{ 4000.0 };
+
+    //==============================================================================
+    SpectralFeatures() = default;
+
+    void reset(fluid::index numBins)
+    {
+        mPreviousMagnitude.resize(numBins);
+        mPreviousMagnitude.fill(0.0);
+        mCumulativePower.resize(numBins);
+        mCumulativePower.fill(0.0);
+        mValues.fill(0.0);
+    }
+
+    /** Frees what reset() allocated. reset() must be called again before the next use. */
+    void release()
+    {
+        mPreviousMagnitude = fluid::RealVector{};
+        mCumulativePower = fluid::RealVector{};
+    }
+
+    void process(fluid::RealVectorView magnitude, double sampleRate) noexcept
+    {
+        auto const numBins{ magnitude.size() };
+        jassert(numBins == mPreviousMagnitude.size() && numBins > 1);
+
+        auto const binHz{ sampleRate / (2.0 * static_cast<double>(numBins - 1)) };
+        auto const firstBin{ std::min(static_cast<fluid::index>(std::ceil(MIN_FREQ / binHz)), numBins - 1) };
+        auto const lowBandEnd{ std::clamp(static_cast<fluid::index>(LOW_BAND_MAX_FREQ / binHz), firstBin, numBins) };
+        auto const midBandEnd{ std::clamp(static_cast<fluid::index>(MID_BAND_MAX_FREQ / binHz), lowBandEnd, numBins) };
+
+        double magnitudeSum{};
+        double fluxSum{};
+        double powerSum{};
+        double maxPower{};
+        double lowBandPower{};
+        double midBandPower{};
+        for (fluid::index bin{ firstBin }; bin < numBins; ++bin) {
+            auto const value{ magnitude(bin) };
+            auto const power{ value * value };
+
+            magnitudeSum += value;
+            fluxSum += std::max(value - mPreviousMagnitude(bin), 0.0);
+            mPreviousMagnitude(bin) = value;
+
+            powerSum += power;
+            mCumulativePower(bin) = powerSum;
+            maxPower = std::max(maxPower, power);
+            if (bin < lowBandEnd) {
+                lowBandPower += power;
+            } else if (bin < midBandEnd) {
+                midBandPower += power;
+            }
+        }
+
+        if (powerSum <= SILENCE_POWER) {
+            mValues.fill(0.0);
+            return;
+        }
+
+        auto const numAnalysedBins{ static_cast<double>(numBins - firstBin) };
+
+        set(DescriptorID::flux, fluxSum / magnitudeSum);
+
+        auto const * cumulativePower{ mCumulativePower.data() };
+        auto const rolloffBin{ std::lower_bound(cumulativePower + firstBin,
+                                                cumulativePower + numBins,
+                                                powerSum * ROLLOFF_RATIO)
+                               - cumulativePower };
+        auto const rolloffHz{ std::max(static_cast<double>(rolloffBin) * binHz, MIN_FREQ) };
+        set(DescriptorID::rolloff, std::log(rolloffHz / MIN_FREQ) / std::log(sampleRate / 2.0 / MIN_FREQ));
+
+        set(DescriptorID::crest, std::log(maxPower * numAnalysedBins / powerSum) / std::log(numAnalysedBins));
+
+        set(DescriptorID::lowBandEnergy, lowBandPower / powerSum);
+        set(DescriptorID::midBandEnergy, midBandPower / powerSum);
+        set(DescriptorID::highBandEnergy, (powerSum - lowBandPower - midBandPower) / powerSum);
+    }
+
+    /** Value of the last process() for a spectral feature descriptor. */
+    double getValue(DescriptorID descID) const noexcept { return mValues[getIndex(descID)]; }
+
+private:
+    //==============================================================================
+    static constexpr size_t NUM_FEATURES{ static_cast<size_t>(DescriptorID::highBandEnergy)
+                                          - static_cast<size_t>(DescriptorID::flux) + 1 };
+    static constexpr double SILENCE_POWER{ 1e-20 };
+
+    static size_t getIndex(DescriptorID descID) noexcept
+    {
+        jassert(Descriptor::isSpectralFeature(descID));
+        return static_cast<size_t>(descID) - static_cast<size_t>(DescriptorID::flux);
+    }
+
+    void set(DescriptorID descID, double value) noexcept { mValues[getIndex(descID)] = juce::jlimit(0.0, 1.0, value); }
+
+    //==============================================================================
+    fluid::RealVector mPreviousMagnitude;
+    fluid::RealVector mCumulativePower;
+    std::array<double, NUM_FEATURES> mValues{};
+
+    //==============================================================================
+    JUCE_LEAK_DETECTOR(SpectralFeatures)
+};
+} // namespace gris
@@ -0,0 +1,148 @@
+/*
+ This file is part of ControlGris.
+
+ Developers: Hicheme BEN GAIED, Gaël LANE LÉPINE
+
+ ControlGris is free software: you can redistribute it and/or modify
+ it under the terms of the GNU Lesser General Public License as
+ published by the Free Software Foundation, either version 3 of the
+ License, or (at your option) any later version.
+
+ ControlGris is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with ControlGris.  If not, see
+ <http://www.gnu.org/licenses/>.
+*/
+
+//==============================================================================
+
+#pragma once
+
+#include "cg_Pitch.hpp"
+#include "cg_Shape.hpp"
+#include "cg_SlidingWindow.hpp"
+
+namespace gris
+{
+//==============================================================================
+enum class SpectralResolution { shape = 0, pitch, count };
+
+//==============================================================================
+/** Magnitude spectra shared by every spectral descriptor.
+ *
+ * All resolutions read the same sliding history, which receives every input sample. A spectrum is only computed when
+ * a descriptor asks for it with analyse(), so each descriptor chooses its own analysis rate.
+ *
+ * The pitch resolution follows the lowest frequency the pitch descriptor has to track, among power-of-two sizes that
+ * all fit in the buffers allocated by reset(). The shape spectrum always has its own window, so the centroid, spread,
+ * flatness and spectral features do not change with the pitch range.
+ */
+class SpectralFrameCache
+{
+public:
+    //==============================================================================
+    SpectralFrameCache() = default;
+
+    void reset()
+    {
+        mHistory.reset(PitchD::MAX_WINDOW_SIZE);
+
+        // The hops are never used: frames are given to the STFTs one at a time.
+        mPitchStft.reset(new fluid::algorithm::STFT{ PitchD::MAX_WINDOW_SIZE,
+                                                     PitchD::MAX_WINDOW_SIZE,
+                                                     PitchD::MAX_WINDOW_SIZE });
+        mShapeStft.reset(new fluid::algorithm::STFT{ ShapeD::WINDOW_SIZE, ShapeD::FFT_SIZE, ShapeD::WINDOW_SIZE });
+
+        mPitchFrame.resize(PitchD::MAX_NBINS);
+        mShapeFrame.resize(ShapeD::NBINS);
+        mPitchMagnitude.resize(PitchD::MAX_NBINS);
+        mShapeMagnitude.resize(ShapeD::NBINS);
+
+        mPitchWindowSize = 0;
+        setPitchWindowSize(PitchD::MAX_WINDOW_SIZE);
+    }
+
+    /** Frees what reset() allocated. reset() must be called again before the next use. */
+    void release()
+    {
+        mHistory.release();
+        mPitchStft.reset();
+        mShapeStft.reset();
+        mPitchFrame = fluid::ComplexVector{};
+        mShapeFrame = fluid::ComplexVector{};
+        mPitchMagnitude = fluid::RealVector{};
+        mShapeMagnitude = fluid::RealVector{};
+        mPitchWindowSize = 0;
+    }
+
+    /** Does not allocate. The size must be a power of two between PitchD::MIN_WINDOW_SIZE and
+     * PitchD::MAX_WINDOW_SIZE.
+     */
+    void setPitchWindowSize(fluid::index windowSize)
+    {
+        jassert(windowSize >= PitchD::MIN_WINDOW_SIZE && windowSize <= PitchD::MAX_WINDOW_SIZE);
+
+        if (windowSize == mPitchWindowSize) {
+            return;
+        }
+
+        mPitchWindowSize = windowSize;
+        mPitchStft->resize(windowSize, windowSize, windowSize);
+    }
+
+    /** Writes new samples in the shared history. Must be called with every input sample. */
+    void write(double const * data, int numSamples)
+    {
+        mHistory.write(data, numSamples);
+    }
+
+    /** Computes the magnitude spectrum of the most recent window at the given resolution. */
+    void analyse(SpectralResolution resolution)
+    {
+        auto window{ mHistory.getWindow() };
+
+        if (resolution == SpectralResolution::pitch) {
+            auto pitchWindow{ window(fluid::Slice(PitchD::MAX_WINDOW_SIZE - mPitchWindowSize, mPitchWindowSize)) };
+            auto pitchFrame{ mPitchFrame(fluid::Slice(0, getNumPitchBins())) };
+            mPitchStft->processFrame(pitchWindow, pitchFrame);
+            mPitchStft->magnitude(pitchFrame, getMagnitude(SpectralResolution::pitch));
+        } else {
+            auto shapeWindow{
+                window(fluid::Slice(PitchD::MAX_WINDOW_SIZE - ShapeD::WINDOW_SIZE, ShapeD::WINDOW_SIZE))
+            };
+            mShapeStft->processFrame(shapeWindow, mShapeFrame);
+            mShapeStft->magnitude(mShapeFrame, mShapeMagnitude);
+        }
+    }
+
+    fluid::RealVectorView getMagnitude(SpectralResolution resolution)
+    {
+        return resolution == SpectralResolution::pitch ? mPitchMagnitude(fluid::Slice(0, getNumPitchBins()))
+                                                       : mShapeMagnitude(fluid::Slice(0, ShapeD::NBINS));
+    }
+
+private:
+    //==============================================================================
+    fluid::index getNumPitchBins() const { return mPitchWindowSize / 2 + 1; }
+
+    //==============================================================================
+    static_assert(PitchD::MAX_WINDOW_SIZE >= ShapeD::WINDOW_SIZE && ShapeD::FFT_SIZE >= ShapeD::WINDOW_SIZE);
+
+    SlidingWindow mHistory;
+
+    std::unique_ptr<fluid::algorithm::STFT> mPitchStft;
+    std::unique_ptr<fluid::algorithm::STFT> mShapeStft;
+    fluid::ComplexVector mPitchFrame;
+    fluid::ComplexVector mShapeFrame;
+    fluid::RealVector mPitchMagnitude;
+    fluid::RealVector mShapeMagnitude;
+    fluid::index mPitchWindowSize{};
+
+    //==============================================================================
+    JUCE_LEAK_DETECTOR(SpectralFrameCache)
+};
+} // namespace gris
@@ -44,7 +44,7 @@ public:
         // we don't really need mean and stdDev...
         // fluid::RealVector spreadMeanRes = fluid::RealVector(1);
         // fluid::RealVector spreadStdDevRes = fluid::RealVector(1);
-        fluid::RealVectorView spreadData = fluid::RealVectorView(shapeStats(fluid::Slice(1 * 7, 1)));
+        fluid::RealVectorView spreadData = fluid::RealVectorView(shapeStats(fluid::Slice(1, 1)));
         // fluid::RealVectorView spreadMeanOut = fluid::RealVectorView(spreadMeanRes);
         // fluid::RealVectorView spreadStdDevOut = fluid::RealVectorView(spreadStdDevRes);
         // mSpreadRunningStats->process(spreadData, spreadMeanOut, spreadStdDevOut);
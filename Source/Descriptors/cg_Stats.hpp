@@ -31,18 +31,39 @@ class StatsD : public Descriptor
 {
 public:
     //==============================================================================
-    void reset() override { mStats.reset(new fluid::algorithm::MultiStats()); }
+    void reset() override { std::fill(mColumnMeans.begin(), mColumnMeans.end(), 0.0); }
 
-    void init() override { mStats->init(0, 0, 50, 100); }
+    void init() override {}
 
-    fluid::algorithm::MultiStats * getStats() const { return mStats.get(); }
+    /** Sizes the engine for matrices of at most maxNumColumns columns. Nothing is allocated by computeMeans(). */
+    void prepare(fluid::index maxNumColumns) { mColumnMeans.resize(maxNumColumns); }
+
+    /** Mean of each column of a (frames x descriptors) matrix. The mean is the only statistic read by the
+     * descriptors, so the other ones are not computed. The returned view is valid until the next call.
+     */
+    fluid::RealVectorView computeMeans(fluid::RealMatrixView matrix)
+    {
+        auto const numFrames{ matrix.rows() };
+        auto const numColumns{ matrix.cols() };
+        jassert(numFrames > 0 && numColumns <= mColumnMeans.size());
+
+        for (fluid::index j{}; j < numColumns; ++j) {
+            double sum{};
+            for (fluid::index i{}; i < numFrames; ++i) {
+                sum += matrix(i, j);
+            }
+            mColumnMeans[j] = sum / static_cast<double>(numFrames);
+        }
+
+        return mColumnMeans(fluid::Slice(0, numColumns));
+    }
 
 private:
     //==============================================================================
     double getValue() override { return 0; }
 
     //==============================================================================
-    std::unique_ptr<fluid::algorithm::MultiStats> mStats;
+    fluid::RealVector mColumnMeans;
 
     //==============================================================================
     JUCE_LEAK_DETECTOR(StatsD)
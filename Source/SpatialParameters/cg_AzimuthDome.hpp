@@ -41,6 +41,7 @@ public:
 
     void process(const DescriptorID & descID, double valueToProcess) override
     {
+        auto const & settings{ getAudioSettings() };
         auto range{ 0.0 };
         auto offset{ 0.0 };
         // auto lap{ 1.0 };
@@ -48,36 +49,47 @@ public:
 
         switch (descID) {
         case DescriptorID::loudness:
-            range = paramRangeLoudness;
-            offset = paramOffsetLoudness;
-            // lap = paramLapLoudness;
+            range = settings.rangeLoudness;
+            offset = settings.offsetLoudness;
+            // lap = settings.lapLoudness;
             smooth = processLoudness(valueToProcess);
             break;
         case DescriptorID::pitch:
-            range = paramRangePitch;
-            // lap = paramLapPitch;
+            range = settings.rangePitch;
+            // lap = settings.lapPitch;
             smooth = processPitch(valueToProcess);
             break;
         case DescriptorID::centroid:
-            range = paramRangeCentroid;
-            // lap = paramLapCentroid;
+            range = settings.rangeCentroid;
+            // lap = settings.lapCentroid;
             smooth = processCentroid(valueToProcess);
             break;
         case DescriptorID::spread:
-            range = paramRangeSpread;
-            offset = paramOffsetSpread;
-            // lap = paramLapSpread;
+            range = settings.rangeSpread;
+            offset = settings.offsetSpread;
+            // lap = settings.lapSpread;
             smooth = processSpread(valueToProcess);
             break;
         case DescriptorID::noise:
-            range = paramRangeNoise;
-            offset = paramOffsetNoise;
-            // lap = paramLapNoise;
+            range = settings.rangeNoise;
+            offset = settings.offsetNoise;
+            // lap = settings.lapNoise;
             smooth = processNoise(valueToProcess);
             break;
+        case DescriptorID::flux:
+        case DescriptorID::rolloff:
+        case DescriptorID::crest:
+        case DescriptorID::lowBandEnergy:
+        case DescriptorID::midBandEnergy:
+        case DescriptorID::highBandEnergy:
+            range = settings.rangeSpectralFeature;
+            offset = settings.offsetSpectralFeature;
+            // lap = settings.lapSpectralFeature;
+            smooth = processSpectralFeature(valueToProcess);
+            break;
         case DescriptorID::iterationsSpeed:
-            range = paramRangeOD;
-            // lap = paramLapOD;
+            range = settings.rangeOD;
+            // lap = settings.lapOD;
             smooth = processSmoothedOnsetDetection(valueToProcess);
             break;
         case DescriptorID::invalid:
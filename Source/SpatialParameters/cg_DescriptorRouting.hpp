@@ -0,0 +1,113 @@
+/*
+ This file is part of ControlGris.
+
+ Developers: Hicheme BEN GAIED, Gaël LANE LÉPINE
+
+ ControlGris is free software: you can redistribute it and/or modify
+ it under the terms of the GNU Lesser General Public License as
+ published by the Free Software Foundation, either version 3 of the
+ License, or (at your option) any later version.
+
+ ControlGris is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with ControlGris.  If not, see
+ <http://www.gnu.org/licenses/>.
+*/
+
+//==============================================================================
+
+#pragma once
+
+#include "cg_SpatialParameter.h"
+
+#include <array>
+
+namespace gris
+{
+//==============================================================================
+/** A spatial parameter driven by a descriptor. */
+struct DescriptorRoute {
+    SpatialParameter * parameter{};
+    // Where the variation of the parameter is accumulated for processParameterValues().
+    double * diffValue{};
+    // Index of the parameter in the spatial parameters of the current SpatMode.
+    size_t parameterIndex{};
+};
+
+//==============================================================================
+/** Dense list, for every descriptor, of the spatial parameters that it currently drives.
+ *
+ * The table is compiled on the message thread whenever a setting that decides whether a parameter follows a
+ * descriptor changes, so that the audio thread only iterates over the active routes.
+ */
+class DescriptorRoutingTable
+{
+public:
+    //==============================================================================
+    static constexpr size_t NUM_DESCRIPTORS{ NUM_DESCRIPTOR_IDS };
+    // A spatial parameter follows a single descriptor, so a descriptor never has more routes than there are parameters.
+    static constexpr size_t MAX_ROUTES_PER_DESCRIPTOR{ 5 };
+
+    //==============================================================================
+    DescriptorRoutingTable() = default;
+
+    void clear() { mNumRoutes.fill(0); }
+
+    void addRoute(DescriptorID descID, DescriptorRoute const & route)
+    {
+        auto const descriptor{ static_cast<size_t>(descID) };
+        jassert(mNumRoutes[descriptor] < MAX_ROUTES_PER_DESCRIPTOR);
+        mRoutes[descriptor][mNumRoutes[descriptor]++] = route;
+    }
+
+    /** Calls callback(DescriptorRoute const &) on every route of a descriptor. */
+    template<typename Callback>
+    void forEachRoute(DescriptorID descID, Callback && callback) const
+    {
+        auto const descriptor{ static_cast<size_t>(descID) };
+        for (size_t i{}; i < mNumRoutes[descriptor]; ++i) {
+            callback(mRoutes[descriptor][i]);
+        }
+    }
+
+    bool hasRoutes(DescriptorID descID) const { return mNumRoutes[static_cast<size_t>(descID)] > 0; }
+
+    /** One bit per DescriptorID that has at least one route. */
+    juce::uint32 getDescriptorMask() const
+    {
+        juce::uint32 mask{};
+        for (size_t descriptor{}; descriptor < NUM_DESCRIPTORS; ++descriptor) {
+            if (mNumRoutes[descriptor] > 0) {
+                mask |= 1u << descriptor;
+            }
+        }
+        return mask;
+    }
+
+    /** One bit per parameter index driven by the iterations speed. */
+    juce::uint32 getOnsetDetectionMask() const
+    {
+        juce::uint32 mask{};
+        forEachRoute(DescriptorID::iterationsSpeed,
+                     [&mask](DescriptorRoute const & route) { mask |= 1u << route.parameterIndex; });
+        return mask;
+    }
+
+    static bool isInMask(juce::uint32 mask, DescriptorID descID)
+    {
+        return (mask & (1u << static_cast<juce::uint32>(descID))) != 0;
+    }
+
+private:
+    //==============================================================================
+    std::array<std::array<DescriptorRoute, MAX_ROUTES_PER_DESCRIPTOR>, NUM_DESCRIPTORS> mRoutes{};
+    std::array<size_t, NUM_DESCRIPTORS> mNumRoutes{};
+
+    //==============================================================================
+    JUCE_LEAK_DETECTOR(DescriptorRoutingTable)
+};
+} // namespace gris
@@ -27,32 +27,64 @@
 
 namespace gris
 {
-constexpr double SMOOTH_COEFFICIENT{ 0.2 };
 //==============================================================================
+/** One-pole smoother defined by a time constant, so that the motion does not depend on the block size.
+ *
+ * The coefficients are only recomputed when the smoothing setting, the sample rate or the number of samples per call
+ * changes, so a call can advance the smoother by a whole block or by a sub-block.
+ */
 class Smooth
 {
 public:
     //==============================================================================
-    double doSmoothing(double targetValue, double smooth, double /*smoothCoef*/)
+    // The smoothing settings used to be applied once per block. Their time constants are the ones they had with blocks
+    // of 512 samples at 48 kHz.
+    static constexpr double REFERENCE_STEP_MS{ 1000.0 * 512.0 / 48000.0 };
+
+    /** Time constant of a smoothing setting between 0 and 100. Returns 0 when the setting does not smooth at all. */
+    static double getTimeConstantMs(double smooth)
     {
+        static constexpr double SMOOTH_COEFFICIENT{ 0.2 };
+
         smooth = juce::jmap(smooth, 0.0, 100.0, 0.0, 200.0);
         smooth = std::max(1.0, std::min(smooth, 200.0));
 
-        if (mStartHistory || mSmoothHistory != smooth || smooth <= 1) {
+        auto const stepCoefficient{ SMOOTH_COEFFICIENT / std::log(smooth) };
+        if (smooth <= 1.0 || stepCoefficient >= 1.0) {
+            return 0.0;
+        }
+        return -REFERENCE_STEP_MS / std::log(1.0 - stepCoefficient);
+    }
+
+    //==============================================================================
+    void prepare(double sampleRate)
+    {
+        mSampleRate = sampleRate;
+        updateSampleCoefficient();
+    }
+
+    void setTimeConstantMs(double timeConstantMs)
+    {
+        mTimeConstantMs = std::max(timeConstantMs, 0.0);
+        updateSampleCoefficient();
+    }
+
+    /** Moves the smoothed value towards targetValue over numSamples and returns it. Changing the smoothing setting
+     * jumps straight to the target.
+     */
+    double doSmoothing(double targetValue, double smooth, int numSamples)
+    {
+        if (smooth != mSmoothSetting) {
+            mSmoothSetting = smooth;
+            setTimeConstantMs(getTimeConstantMs(smooth));
+            mStartHistory = true;
+        }
+
+        if (mStartHistory || mTimeConstantMs <= 0.0) {
             mCurrentValue = targetValue;
             mStartHistory = false;
-            mSmoothHistory = smooth;
         } else {
-            // smoothCoef *= 0.01;
-            // smoothCoef = 1 - smoothCoef;
-            // if (smoothCoef == 0) {
-            //     smoothCoef = ALMOST_ZERO;
-            // }
-            double logsmooth = std::log(smooth);
-            double normalizedsmooth = 1.0 / logsmooth;
-            double adjustment = (targetValue - mCurrentValue) * (normalizedsmooth * SMOOTH_COEFFICIENT);
-
-            mCurrentValue += adjustment;
+            mCurrentValue = targetValue + (mCurrentValue - targetValue) * getStepCoefficient(numSamples);
         }
 
         if (std::isnan(mCurrentValue)) {
@@ -64,9 +96,32 @@ public:
 
 private:
     //==============================================================================
-    double mCurrentValue = -1;
-    double mSmoothHistory = -1;
-    bool mStartHistory = true;
+    void updateSampleCoefficient()
+    {
+        mSampleCoefficient = mTimeConstantMs > 0.0 && mSampleRate > 0.0
+                                 ? std::exp(-1000.0 / (mTimeConstantMs * mSampleRate))
+                                 : 0.0;
+        mNumStepSamples = 0;
+    }
+
+    double getStepCoefficient(int numSamples)
+    {
+        if (numSamples != mNumStepSamples) {
+            mNumStepSamples = numSamples;
+            mStepCoefficient = std::pow(mSampleCoefficient, static_cast<double>(numSamples));
+        }
+        return mStepCoefficient;
+    }
+
+    //==============================================================================
+    double mSampleRate{ 48000.0 };
+    double mTimeConstantMs{};
+    double mSmoothSetting{ -1.0 };
+    double mSampleCoefficient{};
+    double mStepCoefficient{};
+    int mNumStepSamples{};
+    double mCurrentValue{ -1.0 };
+    bool mStartHistory{ true };
 
     //==============================================================================
     JUCE_LEAK_DETECTOR(Smooth)
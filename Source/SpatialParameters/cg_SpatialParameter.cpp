@@ -34,6 +34,20 @@ SpatialParameter::SpatialParameter(juce::AudioProcessorValueTreeState & audioPro
 {
 }
 
+//==============================================================================
+void SpatialParameter::prepare(double sampleRate)
+{
+    for (auto * smooth : { &mSmoothLoudness,
+                           &mSmoothPitch,
+                           &mSmoothCentroid,
+                           &mSmoothSpread,
+                           &mSmoothNoise,
+                           &mSmoothSpectralFeature,
+                           &mSmoothOnsetDetection }) {
+        smooth->prepare(sampleRate);
+    }
+}
+
 //==============================================================================
 juce::String const & SpatialParameter::getParameterName() const
 {
@@ -70,7 +84,7 @@ DescriptorID SpatialParameter::getDescriptorToUse()
 //==============================================================================
 double SpatialParameter::processLoudness(double valueToProcess)
 {
-    valueToProcess = valueToProcess * (paramExpanderLoudness * 0.02);
+    valueToProcess = valueToProcess * (getAudioSettings().expanderLoudness * 0.02);
     valueToProcess = processSmoothedLoudness(valueToProcess);
     return valueToProcess;
 }
@@ -79,8 +93,9 @@ double SpatialParameter::processLoudness(double valueToProcess)
 double SpatialParameter::processPitch(double valueToProcess)
 {
     auto val{ 0.0 };
-    double minFreq = mFunctions.frequencyToMidiNoteNumber(paramMinFreqPitch);
-    double maxFreq = mFunctions.frequencyToMidiNoteNumber(paramMaxFreqPitch);
+    auto const & settings{ getAudioSettings() };
+    double minFreq = mFunctions.frequencyToMidiNoteNumber(settings.minFreqPitch);
+    double maxFreq = mFunctions.frequencyToMidiNoteNumber(settings.maxFreqPitch);
     double zmap = mFunctions.zmap(valueToProcess,
                                   minFreq,
                                   maxFreq); // zmap can be nan if frequency range for analysis is not wide enough...
@@ -92,8 +107,9 @@ double SpatialParameter::processPitch(double valueToProcess)
 double SpatialParameter::processCentroid(double valueToProcess)
 {
     auto val{ 0.0 };
-    double minFreq = mFunctions.frequencyToMidiNoteNumber(paramMinFreqCentroid);
-    double maxFreq = mFunctions.frequencyToMidiNoteNumber(paramMaxFreqCentroid);
+    auto const & settings{ getAudioSettings() };
+    double minFreq = mFunctions.frequencyToMidiNoteNumber(settings.minFreqCentroid);
+    double maxFreq = mFunctions.frequencyToMidiNoteNumber(settings.maxFreqCentroid);
     double zmap = mFunctions.zmap(valueToProcess, minFreq, maxFreq);
     val = processSmoothedCentroid(zmap);
     return val;
@@ -103,12 +119,13 @@ double SpatialParameter::processCentroid(double valueToProcess)
 double SpatialParameter::processSpread(double valueToProcess)
 {
     auto val{ 0.0 };
-    double scaleOne = paramExpanderSpread;
+    auto const expanderSpread{ getAudioSettings().expanderSpread };
+    double scaleOne = expanderSpread;
     scaleOne = mFunctions.zmap(scaleOne, 100.0, 500.0);
     scaleOne = 1.0 - scaleOne;
     double power = pow(valueToProcess, scaleOne);
     double scaleExpr = mFunctions.scaleExpr(power);
-    double scaleTwo = paramExpanderSpread;
+    double scaleTwo = expanderSpread;
     scaleTwo = mFunctions.clip(scaleTwo);
     double valueToSmooth = scaleExpr * scaleTwo;
     val = processSmoothedSpread(valueToSmooth);
@@ -118,45 +135,61 @@ double SpatialParameter::processSpread(double valueToProcess)
 //==============================================================================
 double SpatialParameter::processNoise(double valueToProcess)
 {
-    valueToProcess = valueToProcess * (paramExpanderNoise * 0.01);
+    valueToProcess = valueToProcess * (getAudioSettings().expanderNoise * 0.01);
     valueToProcess = processSmoothedNoise(valueToProcess);
     return valueToProcess;
 }
 
+//==============================================================================
+double SpatialParameter::processSpectralFeature(double valueToProcess)
+{
+    valueToProcess = valueToProcess * (getAudioSettings().expanderSpectralFeature * 0.01);
+    valueToProcess = processSmoothedSpectralFeature(valueToProcess);
+    return valueToProcess;
+}
+
 //==============================================================================
 double SpatialParameter::processSmoothedLoudness(double targetValue)
 {
-    return mSmoothLoudness.doSmoothing(targetValue, paramSmoothLoudness, paramSmoothCoefLoudness);
+    return mSmoothLoudness.doSmoothing(targetValue, getAudioSettings().smoothLoudness, mNumSamplesPerStep);
 }
 
 //==============================================================================
 double SpatialParameter::processSmoothedPitch(double targetValue)
 {
-    return mSmoothPitch.doSmoothing(targetValue, paramSmoothPitch, paramSmoothCoefPitch);
+    return mSmoothPitch.doSmoothing(targetValue, getAudioSettings().smoothPitch, mNumSamplesPerStep);
 }
 
 //==============================================================================
 double SpatialParameter::processSmoothedCentroid(double targetValue)
 {
-    return mSmoothCentroid.doSmoothing(targetValue, paramSmoothCentroid, paramSmoothCoefCentroid);
+    return mSmoothCentroid.doSmoothing(targetValue, getAudioSettings().smoothCentroid, mNumSamplesPerStep);
 }
 
 //==============================================================================
 double SpatialParameter::processSmoothedSpread(double targetValue)
 {
-    return mSmoothSpread.doSmoothing(targetValue, paramSmoothSpread, paramSmoothCoefSpread);
+    return mSmoothSpread.doSmoothing(targetValue, getAudioSettings().smoothSpread, mNumSamplesPerStep);
 }
 
 //==============================================================================
 double SpatialParameter::processSmoothedNoise(double targetValue)
 {
-    return mSmoothNoise.doSmoothing(targetValue, paramSmoothNoise, paramSmoothCoefNoise);
+    return mSmoothNoise.doSmoothing(targetValue, getAudioSettings().smoothNoise, mNumSamplesPerStep);
+}
+
+//==============================================================================
+double SpatialParameter::processSmoothedSpectralFeature(double targetValue)
+{
+    return mSmoothSpectralFeature.doSmoothing(targetValue,
+                                              getAudioSettings().smoothSpectralFeature,
+                                              mNumSamplesPerStep);
 }
 
 //==============================================================================
 double SpatialParameter::processSmoothedOnsetDetection(double targetValue)
 {
-    return mSmoothOnsetDetection.doSmoothing(targetValue, paramSmoothOD, paramSmoothCoefOD);
+    return mSmoothOnsetDetection.doSmoothing(targetValue, getAudioSettings().smoothOD, mNumSamplesPerStep);
 }
 
 //====================================================================
@@ -164,18 +197,19 @@ bool SpatialParameter::needsSpectralAnalysis()
 {
     if (mDescriptorToUse == DescriptorID::centroid || mDescriptorToUse == DescriptorID::spread
         || mDescriptorToUse == DescriptorID::noise) {
-        if ((paramRangeCentroid != 0 && paramMaxFreqCentroid > paramMinFreqCentroid)
-            || (paramRangeSpread != 0 && paramExpanderSpread > 0) || (paramRangeNoise != 0 && paramExpanderNoise > 0)) {
+        if ((mSettings.rangeCentroid != 0 && mSettings.maxFreqCentroid > mSettings.minFreqCentroid)
+            || (mSettings.rangeSpread != 0 && mSettings.expanderSpread > 0)
+            || (mSettings.rangeNoise != 0 && mSettings.expanderNoise > 0)) {
             return true;
         }
     }
-    return false;
+    return shouldProcessSpectralFeatureAnalysis();
 }
 
 //==============================================================================
 bool SpatialParameter::shouldProcessLoudnessAnalysis()
 {
-    if (mDescriptorToUse == DescriptorID::loudness && paramExpanderLoudness > 0 && paramRangeLoudness != 0) {
+    if (mDescriptorToUse == DescriptorID::loudness && mSettings.expanderLoudness > 0 && mSettings.rangeLoudness != 0) {
         return true;
     }
     return false;
@@ -184,7 +218,8 @@ bool SpatialParameter::shouldProcessLoudnessAnalysis()
 //==============================================================================
 bool SpatialParameter::shouldProcessPitchAnalysis()
 {
-    if (mDescriptorToUse == DescriptorID::pitch && paramMinFreqPitch < paramMaxFreqPitch && paramRangePitch != 0) {
+    if (mDescriptorToUse == DescriptorID::pitch && mSettings.minFreqPitch < mSettings.maxFreqPitch
+        && mSettings.rangePitch != 0) {
         return true;
     }
     return false;
@@ -193,8 +228,8 @@ bool SpatialParameter::shouldProcessPitchAnalysis()
 //==============================================================================
 bool SpatialParameter::shouldProcessCentroidAnalysis()
 {
-    if (mDescriptorToUse == DescriptorID::centroid && paramMinFreqCentroid < paramMaxFreqCentroid
-        && paramRangeCentroid != 0) {
+    if (mDescriptorToUse == DescriptorID::centroid && mSettings.minFreqCentroid < mSettings.maxFreqCentroid
+        && mSettings.rangeCentroid != 0) {
         return true;
     }
     return false;
@@ -203,7 +238,7 @@ bool SpatialParameter::shouldProcessCentroidAnalysis()
 //==============================================================================
 bool SpatialParameter::shouldProcessSpreadAnalysis()
 {
-    if (mDescriptorToUse == DescriptorID::spread && paramExpanderSpread > 0 && paramRangeSpread != 0) {
+    if (mDescriptorToUse == DescriptorID::spread && mSettings.expanderSpread > 0 && mSettings.rangeSpread != 0) {
         return true;
     }
     return false;
@@ -212,7 +247,17 @@ bool SpatialParameter::shouldProcessSpreadAnalysis()
 //==============================================================================
 bool SpatialParameter::shouldProcessNoiseAnalysis()
 {
-    if (mDescriptorToUse == DescriptorID::noise && paramExpanderNoise > 0 && paramRangeNoise != 0) {
+    if (mDescriptorToUse == DescriptorID::noise && mSettings.expanderNoise > 0 && mSettings.rangeNoise != 0) {
+        return true;
+    }
+    return false;
+}
+
+//==============================================================================
+bool SpatialParameter::shouldProcessSpectralFeatureAnalysis()
+{
+    if (Descriptor::isSpectralFeature(mDescriptorToUse) && mSettings.expanderSpectralFeature > 0
+        && mSettings.rangeSpectralFeature != 0) {
         return true;
     }
     return false;
@@ -221,9 +266,72 @@ bool SpatialParameter::shouldProcessNoiseAnalysis()
 //==============================================================================
 bool SpatialParameter::shouldProcessOnsetDetectionAnalysis()
 {
-    if (mDescriptorToUse == DescriptorID::iterationsSpeed && paramMinTime < paramMaxTime) {
+    if (mDescriptorToUse == DescriptorID::iterationsSpeed && mSettings.minTime < mSettings.maxTime) {
         return true;
     }
     return false;
 }
+
+//==============================================================================
+void SpatialParameter::setSetting(SpatialParameterSetting const setting, double const value)
+{
+    setSpatialParameterSetting(mSettings, setting, value);
+    mDirtySettings |= juce::uint64{ 1 } << static_cast<size_t>(setting);
+    publishSettings();
+}
+
+//==============================================================================
+void SpatialParameter::publishSettings()
+{
+    mAudioSettings.getWriteBuffer() = mSettings;
+    mAudioSettings.publish();
+}
+
+//==============================================================================
+void SpatialParameter::updateParameterState()
+{
+    // A setting missing from the state, e.g. one added after the state was saved, gets its default value.
+    static SpatialParameterSettings const DEFAULT_SETTINGS{};
+    for (size_t i{}; i < NUM_SPATIAL_PARAMETER_SETTINGS; ++i) {
+        auto const setting{ static_cast<SpatialParameterSetting>(i) };
+        auto const & property{ mAPVTS.state.getProperty(mStateIds[i]) };
+        auto const value{ property.isVoid()
+                              ? static_cast<double>(getSpatialParameterSetting(DEFAULT_SETTINGS, setting))
+                              : property.toString().getDoubleValue() };
+        setSpatialParameterSetting(mSettings, setting, value);
+    }
+    mDirtySettings = 0;
+    publishSettings();
+}
+
+//==============================================================================
+void SpatialParameter::setParametersState()
+{
+    // The identifiers are built once, the name of the parameter being known by now.
+    if (mStateIds.front().isNull()) {
+        auto const prefix{ parameterName.removeCharacters(" ") };
+        for (size_t i{}; i < NUM_SPATIAL_PARAMETER_SETTINGS; ++i) {
+            auto const setting{ static_cast<SpatialParameterSetting>(i) };
+            mStateIds[i] = juce::Identifier{ prefix + getSpatialParameterSettingInfo(setting).stateSuffix };
+        }
+    }
+
+    mDirtySettings = ~juce::uint64{};
+    flushParametersState();
+    publishSettings();
+}
+
+//==============================================================================
+void SpatialParameter::flushParametersState()
+{
+    for (size_t i{}; i < NUM_SPATIAL_PARAMETER_SETTINGS && mDirtySettings != 0; ++i) {
+        auto const bit{ juce::uint64{ 1 } << i };
+        if ((mDirtySettings & bit) != 0) {
+            mAPVTS.state.setProperty(mStateIds[i],
+                                     getSpatialParameterSetting(mSettings, static_cast<SpatialParameterSetting>(i)),
+                                     nullptr);
+            mDirtySettings &= ~bit;
+        }
+    }
+}
 } // namespace gris
@@ -31,8 +31,10 @@
 
 #include "../Descriptors/cg_Descriptors.hpp"
 #include "../cg_constants.hpp"
+#include "../cg_TripleBuffer.hpp"
 #include "cg_Smooth.hpp"
 #include "cg_SpatParamHelperFunctions.h"
+#include "cg_SpatialParameterSettings.hpp"
 
 namespace gris
 {
@@ -51,6 +53,16 @@ public:
 
     virtual void process(const DescriptorID & descID, double valueToProcess) = 0;
 
+    void prepare(double sampleRate);
+    /** Audio thread. Picks up the latest settings and sets the number of samples covered by the next calls to
+     * process().
+     */
+    void beginBlock(int numSamples)
+    {
+        mAudioSettings.update();
+        mNumSamplesPerStep = numSamples;
+    }
+
     virtual juce::String const & getParameterName() const;
 
     double getDiffValue();
@@ -64,12 +76,14 @@ public:
     double processCentroid(double valueToProcess);
     double processSpread(double valueToProcess);
     double processNoise(double valueToProcess);
+    double processSpectralFeature(double valueToProcess);
 
     double processSmoothedLoudness(double targetValue);
     double processSmoothedPitch(double targetValue);
     double processSmoothedCentroid(double targetValue);
     double processSmoothedSpread(double targetValue);
     double processSmoothedNoise(double targetValue);
+    double processSmoothedSpectralFeature(double targetValue);
     double processSmoothedOnsetDetection(double targetValue);
 
     //====================================================================
@@ -80,755 +94,231 @@ public:
     bool shouldProcessCentroidAnalysis();
     bool shouldProcessSpreadAnalysis();
     bool shouldProcessNoiseAnalysis();
+    bool shouldProcessSpectralFeatureAnalysis();
     bool shouldProcessOnsetDetectionAnalysis();
 
     //====================================================================
     ParameterID getParameterID() const { return paramID; }
 
-    int getParamDescriptorComboBoxIndex() const { return paramDescriptorComboBoxIndex; }
+    int getParamDescriptorComboBoxIndex() const { return mSettings.descriptorComboBoxIndex; }
 
     void setParamDescriptorComboBoxIndex(int index)
     {
-        paramDescriptorComboBoxIndex = index;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_DescriptorIndex") },
-                                 paramDescriptorComboBoxIndex,
-                                 nullptr);
+        setSetting(SpatialParameterSetting::descriptorComboBoxIndex, index);
     }
 
     //====================================================================
-    double getParamExpanderLoudness() const { return paramExpanderLoudness; }
+    double getParamExpanderLoudness() const { return mSettings.expanderLoudness; }
 
-    double getParamExpanderSpread() const { return paramExpanderSpread; }
+    double getParamExpanderSpread() const { return mSettings.expanderSpread; }
 
-    double getParamExpanderNoise() const { return paramExpanderNoise; }
+    double getParamExpanderNoise() const { return mSettings.expanderNoise; }
 
-    double getParamSmoothLoudness() const { return paramSmoothLoudness; }
+    double getParamExpanderSpectralFeature() const { return mSettings.expanderSpectralFeature; }
 
-    double getParamSmoothPitch() const { return paramSmoothPitch; }
+    double getParamSmoothLoudness() const { return mSettings.smoothLoudness; }
 
-    double getParamSmoothCentroid() const { return paramSmoothCentroid; }
+    double getParamSmoothPitch() const { return mSettings.smoothPitch; }
 
-    double getParamSmoothSpread() const { return paramSmoothSpread; }
+    double getParamSmoothCentroid() const { return mSettings.smoothCentroid; }
 
-    double getParamSmoothNoise() const { return paramSmoothNoise; }
+    double getParamSmoothSpread() const { return mSettings.smoothSpread; }
 
-    double getParamSmoothOnsetDetection() const { return paramSmoothOD; }
+    double getParamSmoothNoise() const { return mSettings.smoothNoise; }
 
-    double getParamSmoothCoefLoudness() const { return paramSmoothCoefLoudness; }
+    double getParamSmoothSpectralFeature() const { return mSettings.smoothSpectralFeature; }
 
-    double getParamSmoothCoefPitch() const { return paramSmoothCoefPitch; }
+    double getParamSmoothOnsetDetection() const { return mSettings.smoothOD; }
 
-    double getParamSmoothCoefCentroid() const { return paramSmoothCoefCentroid; }
+    double getParamSmoothCoefLoudness() const { return mSettings.smoothCoefLoudness; }
 
-    double getParamSmoothCoefSpread() const { return paramSmoothCoefSpread; }
+    double getParamSmoothCoefPitch() const { return mSettings.smoothCoefPitch; }
 
-    double getParamSmoothCoefNoise() const { return paramSmoothCoefNoise; }
+    double getParamSmoothCoefCentroid() const { return mSettings.smoothCoefCentroid; }
 
-    double getParamSmoothCoefOnsetDetection() const { return paramSmoothCoefOD; }
+    double getParamSmoothCoefSpread() const { return mSettings.smoothCoefSpread; }
 
-    double getParamRangeLoudness() const { return paramRangeLoudness; }
+    double getParamSmoothCoefNoise() const { return mSettings.smoothCoefNoise; }
 
-    double getParamRangePitch() const { return paramRangePitch; }
+    double getParamSmoothCoefSpectralFeature() const { return mSettings.smoothCoefSpectralFeature; }
 
-    double getParamRangeCentroid() const { return paramRangeCentroid; }
+    double getParamSmoothCoefOnsetDetection() const { return mSettings.smoothCoefOD; }
 
-    double getParamRangeSpread() const { return paramRangeSpread; }
+    double getParamRangeLoudness() const { return mSettings.rangeLoudness; }
 
-    double getParamRangeNoise() const { return paramRangeNoise; }
+    double getParamRangePitch() const { return mSettings.rangePitch; }
 
-    double getParamRangeOnsetDetection() const { return paramRangeOD; }
+    double getParamRangeCentroid() const { return mSettings.rangeCentroid; }
 
-    double getParamLapLoudness() const { return paramLapLoudness; }
+    double getParamRangeSpread() const { return mSettings.rangeSpread; }
 
-    double getParamLapPitch() const { return paramLapPitch; }
+    double getParamRangeNoise() const { return mSettings.rangeNoise; }
 
-    double getParamLapCentroid() const { return paramLapCentroid; }
+    double getParamRangeSpectralFeature() const { return mSettings.rangeSpectralFeature; }
 
-    double getParamLapSpread() const { return paramLapSpread; }
+    double getParamRangeOnsetDetection() const { return mSettings.rangeOD; }
 
-    double getParamLapNoise() const { return paramLapNoise; }
+    double getParamLapLoudness() const { return mSettings.lapLoudness; }
 
-    double getParamLapOnsetDetection() const { return paramLapOD; }
+    double getParamLapPitch() const { return mSettings.lapPitch; }
 
-    double getParamOffsetLoudness() const { return paramOffsetLoudness; }
+    double getParamLapCentroid() const { return mSettings.lapCentroid; }
 
-    double getParamOffsetPitch() const { return paramOffsetPitch; }
+    double getParamLapSpread() const { return mSettings.lapSpread; }
 
-    double getParamOffsetCentroid() const { return paramOffsetCentroid; }
+    double getParamLapNoise() const { return mSettings.lapNoise; }
 
-    double getParamOffsetSpread() const { return paramOffsetSpread; }
+    double getParamLapSpectralFeature() const { return mSettings.lapSpectralFeature; }
 
-    double getParamOffsetNoise() const { return paramOffsetNoise; }
+    double getParamLapOnsetDetection() const { return mSettings.lapOD; }
 
-    double getParamOffsetOnsetDetection() const { return paramOffsetOD; }
+    double getParamOffsetLoudness() const { return mSettings.offsetLoudness; }
 
-    double getParamMinFreqPitch() const { return paramMinFreqPitch; }
+    double getParamOffsetPitch() const { return mSettings.offsetPitch; }
 
-    double getParamMinFreqCentroid() const { return paramMinFreqCentroid; }
+    double getParamOffsetCentroid() const { return mSettings.offsetCentroid; }
 
-    double getParamMaxFreqPitch() const { return paramMaxFreqPitch; }
+    double getParamOffsetSpread() const { return mSettings.offsetSpread; }
 
-    double getParamMaxFreqCentroid() const { return paramMaxFreqCentroid; }
+    double getParamOffsetNoise() const { return mSettings.offsetNoise; }
 
-    int getParamMetricComboBoxIndex() const { return paramMetricComboBoxIndex; }
+    double getParamOffsetSpectralFeature() const { return mSettings.offsetSpectralFeature; }
 
-    double getParamThreshold() const { return paramThreshold; }
+    double getParamOffsetOnsetDetection() const { return mSettings.offsetOD; }
 
-    double getParamMinTime() const { return paramMinTime; }
+    double getParamMinFreqPitch() const { return mSettings.minFreqPitch; }
 
-    double getParamMaxTime() const { return paramMaxTime; }
+    double getParamMinFreqCentroid() const { return mSettings.minFreqCentroid; }
 
-    void setParamExpanderLoudness(double value)
-    {
-        paramExpanderLoudness = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_ExpanderLoudness") },
-                                 paramExpanderLoudness,
-                                 nullptr);
-    }
+    double getParamMaxFreqPitch() const { return mSettings.maxFreqPitch; }
 
-    void setParamExpanderSpread(double value)
-    {
-        paramExpanderSpread = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_ExpanderSpread") },
-                                 paramExpanderSpread,
-                                 nullptr);
-    }
+    double getParamMaxFreqCentroid() const { return mSettings.maxFreqCentroid; }
 
-    void setParamExpanderNoise(double value)
-    {
-        paramExpanderNoise = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_ExpanderNoise") },
-                                 paramExpanderNoise,
-                                 nullptr);
-    }
+    int getParamMetricComboBoxIndex() const { return mSettings.metricComboBoxIndex; }
 
-    void setParamSmoothLoudness(double value)
-    {
-        paramSmoothLoudness = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothLoudness") },
-                                 paramSmoothLoudness,
-                                 nullptr);
-    }
+    double getParamThreshold() const { return mSettings.threshold; }
 
-    void setParamSmoothPitch(double value)
-    {
-        paramSmoothPitch = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothPitch") },
-                                 paramSmoothPitch,
-                                 nullptr);
-    }
+    double getParamMinTime() const { return mSettings.minTime; }
 
-    void setParamSmoothCentroid(double value)
-    {
-        paramSmoothCentroid = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothCentroid") },
-                                 paramSmoothCentroid,
-                                 nullptr);
-    }
+    double getParamMaxTime() const { return mSettings.maxTime; }
 
-    void setParamSmoothSpread(double value)
-    {
-        paramSmoothSpread = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothSpread") },
-                                 paramSmoothSpread,
-                                 nullptr);
-    }
+    void setParamExpanderLoudness(double value) { setSetting(SpatialParameterSetting::expanderLoudness, value); }
 
-    void setParamSmoothNoise(double value)
-    {
-        paramSmoothNoise = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothNoise") },
-                                 paramSmoothNoise,
-                                 nullptr);
-    }
+    void setParamExpanderSpread(double value) { setSetting(SpatialParameterSetting::expanderSpread, value); }
 
-    void setParamSmoothOnsetDetection(double value)
-    {
-        paramSmoothOD = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothOnsetDetection") },
-                                 paramSmoothOD,
-                                 nullptr);
-    }
+    void setParamExpanderNoise(double value) { setSetting(SpatialParameterSetting::expanderNoise, value); }
 
-    void setParamSmoothCoefLoudness(double value)
+    void setParamExpanderSpectralFeature(double value)
     {
-        paramSmoothCoefLoudness = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothCoefLoudness") },
-                                 paramSmoothCoefLoudness,
-                                 nullptr);
+        setSetting(SpatialParameterSetting::expanderSpectralFeature, value);
     }
 
-    void setParamSmoothCoefPitch(double value)
-    {
-        paramSmoothCoefPitch = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothCoefPitch") },
-                                 paramSmoothCoefPitch,
-                                 nullptr);
-    }
+    void setParamSmoothLoudness(double value) { setSetting(SpatialParameterSetting::smoothLoudness, value); }
 
-    void setParamSmoothCoefCentroid(double value)
-    {
-        paramSmoothCoefCentroid = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothCoefCentroid") },
-                                 paramSmoothCoefCentroid,
-                                 nullptr);
-    }
+    void setParamSmoothPitch(double value) { setSetting(SpatialParameterSetting::smoothPitch, value); }
 
-    void setParamSmoothCoefSpread(double value)
-    {
-        paramSmoothCoefSpread = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothCoefSpread") },
-                                 paramSmoothCoefSpread,
-                                 nullptr);
-    }
+    void setParamSmoothCentroid(double value) { setSetting(SpatialParameterSetting::smoothCentroid, value); }
 
-    void setParamSmoothCoefNoise(double value)
-    {
-        paramSmoothCoefNoise = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothCoefNoise") },
-                                 paramSmoothCoefNoise,
-                                 nullptr);
-    }
+    void setParamSmoothSpread(double value) { setSetting(SpatialParameterSetting::smoothSpread, value); }
 
-    void setParamSmoothCoefOnsetDetection(double value)
-    {
-        paramSmoothCoefOD = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothCoefOnsetDetection") },
-                                 paramSmoothCoefOD,
-                                 nullptr);
-    }
+    void setParamSmoothNoise(double value) { setSetting(SpatialParameterSetting::smoothNoise, value); }
 
-    void setParamRangeLoudness(double value)
+    void setParamSmoothSpectralFeature(double value)
     {
-        paramRangeLoudness = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_RangeLoudness") },
-                                 paramRangeLoudness,
-                                 nullptr);
+        setSetting(SpatialParameterSetting::smoothSpectralFeature, value);
     }
 
-    void setParamRangePitch(double value)
-    {
-        paramRangePitch = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_RangePitch") },
-                                 paramRangePitch,
-                                 nullptr);
-    }
+    void setParamSmoothOnsetDetection(double value) { setSetting(SpatialParameterSetting::smoothOD, value); }
 
-    void setParamRangeCentroid(double value)
-    {
-        paramRangeCentroid = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_RangeCentroid") },
-                                 paramRangeCentroid,
-                                 nullptr);
-    }
+    void setParamSmoothCoefLoudness(double value) { setSetting(SpatialParameterSetting::smoothCoefLoudness, value); }
 
-    void setParamRangeSpread(double value)
-    {
-        paramRangeSpread = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_RangeSpread") },
-                                 paramRangeSpread,
-                                 nullptr);
-    }
+    void setParamSmoothCoefPitch(double value) { setSetting(SpatialParameterSetting::smoothCoefPitch, value); }
 
-    void setParamRangeNoise(double value)
-    {
-        paramRangeNoise = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_RangeNoise") },
-                                 paramRangeNoise,
-                                 nullptr);
-    }
+    void setParamSmoothCoefCentroid(double value) { setSetting(SpatialParameterSetting::smoothCoefCentroid, value); }
 
-    void setParamRangeOnsetDetection(double value)
-    {
-        paramRangeOD = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_RangeOnsetDetection") },
-                                 paramRangeOD,
-                                 nullptr);
-    }
+    void setParamSmoothCoefSpread(double value) { setSetting(SpatialParameterSetting::smoothCoefSpread, value); }
 
-    void setParamLapLoudness(double value)
-    {
-        paramLapLoudness = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_LapLoudness") },
-                                 paramLapLoudness,
-                                 nullptr);
-    }
+    void setParamSmoothCoefNoise(double value) { setSetting(SpatialParameterSetting::smoothCoefNoise, value); }
 
-    void setParamLapPitch(double value)
+    void setParamSmoothCoefSpectralFeature(double value)
     {
-        paramLapPitch = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_LapPitch") },
-                                 paramLapPitch,
-                                 nullptr);
+        setSetting(SpatialParameterSetting::smoothCoefSpectralFeature, value);
     }
 
-    void setParamLapCentroid(double value)
-    {
-        paramLapCentroid = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_LapCentroid") },
-                                 paramLapCentroid,
-                                 nullptr);
-    }
+    void setParamSmoothCoefOnsetDetection(double value) { setSetting(SpatialParameterSetting::smoothCoefOD, value); }
 
-    void setParamLapSpread(double value)
-    {
-        paramLapSpread = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_LapSpread") },
-                                 paramLapSpread,
-                                 nullptr);
-    }
+    void setParamRangeLoudness(double value) { setSetting(SpatialParameterSetting::rangeLoudness, value); }
 
-    void setParamLapNoise(double value)
-    {
-        paramLapNoise = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_LapNoise") },
-                                 paramLapNoise,
-                                 nullptr);
-    }
+    void setParamRangePitch(double value) { setSetting(SpatialParameterSetting::rangePitch, value); }
 
-    void setParamLapOnsetDetection(double value)
-    {
-        paramLapOD = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_LapOnsetDetection") },
-                                 paramLapOD,
-                                 nullptr);
-    }
+    void setParamRangeCentroid(double value) { setSetting(SpatialParameterSetting::rangeCentroid, value); }
 
-    void setParamOffsetLoudness(double value)
-    {
-        paramOffsetLoudness = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_OffsetLoudness") },
-                                 paramOffsetLoudness,
-                                 nullptr);
-    }
+    void setParamRangeSpread(double value) { setSetting(SpatialParameterSetting::rangeSpread, value); }
 
-    void setParamOffsetPitch(double value)
-    {
-        paramOffsetPitch = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_OffsetPitch") },
-                                 paramOffsetPitch,
-                                 nullptr);
-    }
+    void setParamRangeNoise(double value) { setSetting(SpatialParameterSetting::rangeNoise, value); }
 
-    void setParamOffsetCentroid(double value)
+    void setParamRangeSpectralFeature(double value)
     {
-        paramOffsetCentroid = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_OffsetCentroid") },
-                                 paramOffsetCentroid,
-                                 nullptr);
+        setSetting(SpatialParameterSetting::rangeSpectralFeature, value);
     }
 
-    void setParamOffsetSpread(double value)
-    {
-        paramOffsetSpread = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_OffsetSpread") },
-                                 paramOffsetSpread,
-                                 nullptr);
-    }
+    void setParamRangeOnsetDetection(double value) { setSetting(SpatialParameterSetting::rangeOD, value); }
 
-    void setParamOffsetNoise(double value)
-    {
-        paramOffsetNoise = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_OffsetNoise") },
-                                 paramOffsetNoise,
-                                 nullptr);
-    }
+    void setParamLapLoudness(double value) { setSetting(SpatialParameterSetting::lapLoudness, value); }
 
-    void setParamOffsetOnsetDetection(double value)
-    {
-        paramOffsetOD = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_OffsetOnsetDetection") },
-                                 paramOffsetOD,
-                                 nullptr);
-    }
+    void setParamLapPitch(double value) { setSetting(SpatialParameterSetting::lapPitch, value); }
 
-    void setParamMinFreqPitch(double value)
-    {
-        paramMinFreqPitch = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_MinFreqPitch") },
-                                 paramMinFreqPitch,
-                                 nullptr);
-    }
+    void setParamLapCentroid(double value) { setSetting(SpatialParameterSetting::lapCentroid, value); }
 
-    void setParamMinFreqCentroid(double value)
-    {
-        paramMinFreqCentroid = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_MinFreqCentroid") },
-                                 paramMinFreqCentroid,
-                                 nullptr);
-    }
+    void setParamLapSpread(double value) { setSetting(SpatialParameterSetting::lapSpread, value); }
 
-    void setParamMaxFreqPitch(double value)
-    {
-        paramMaxFreqPitch = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_MaxFreqPitch") },
-                                 paramMaxFreqPitch,
-                                 nullptr);
-    }
+    void setParamLapNoise(double value) { setSetting(SpatialParameterSetting::lapNoise, value); }
 
-    void setParamMaxFreqCentroid(double value)
-    {
-        paramMaxFreqCentroid = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_MaxFreqCentroid") },
-                                 paramMaxFreqCentroid,
-                                 nullptr);
-    }
+    void setParamLapSpectralFeature(double value) { setSetting(SpatialParameterSetting::lapSpectralFeature, value); }
 
-    void setParamMetricComboboxIndex(int value)
-    {
-        paramMetricComboBoxIndex = value;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_MetricOD") },
-                                 paramMetricComboBoxIndex,
-                                 nullptr);
-    }
+    void setParamLapOnsetDetection(double value) { setSetting(SpatialParameterSetting::lapOD, value); }
 
-    void setParamThreshold(double threshold)
-    {
-        paramThreshold = threshold;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_ThresholdOD") },
-                                 paramThreshold,
-                                 nullptr);
-    }
+    void setParamOffsetLoudness(double value) { setSetting(SpatialParameterSetting::offsetLoudness, value); }
 
-    void setParamMinTime(double minTime)
-    {
-        paramMinTime = minTime;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_MinTimeOD") },
-                                 paramMinTime,
-                                 nullptr);
-    }
+    void setParamOffsetPitch(double value) { setSetting(SpatialParameterSetting::offsetPitch, value); }
 
-    void setParamMaxTime(double maxTime)
-    {
-        paramMaxTime = maxTime;
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_MaxTimeOD") },
-                                 paramMaxTime,
-                                 nullptr);
-    }
+    void setParamOffsetCentroid(double value) { setSetting(SpatialParameterSetting::offsetCentroid, value); }
 
-    //====================================================================
-    void updateParameterState()
-    {
-        paramDescriptorComboBoxIndex
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_DescriptorIndex") })
-                  .toString()
-                  .getIntValue();
-
-        paramExpanderLoudness
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_ExpanderLoudness") })
-                  .toString()
-                  .getDoubleValue();
-        paramExpanderSpread
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_ExpanderSpread") })
-                  .toString()
-                  .getDoubleValue();
-        paramExpanderNoise
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_ExpanderNoise") })
-                  .toString()
-                  .getDoubleValue();
-
-        paramSmoothLoudness
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothLoudness") })
-                  .toString()
-                  .getDoubleValue();
-        paramSmoothPitch
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothPitch") })
-                  .toString()
-                  .getDoubleValue();
-        paramSmoothCentroid
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothCentroid") })
-                  .toString()
-                  .getDoubleValue();
-        paramSmoothSpread
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothSpread") })
-                  .toString()
-                  .getDoubleValue();
-        paramSmoothNoise
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothNoise") })
-                  .toString()
-                  .getDoubleValue();
-        paramSmoothOD
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothOnsetDetection") })
-                  .toString()
-                  .getDoubleValue();
-
-        paramSmoothCoefLoudness
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothCoefLoudness") })
-                  .toString()
-                  .getDoubleValue();
-        paramSmoothCoefPitch
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothCoefPitch") })
-                  .toString()
-                  .getDoubleValue();
-        paramSmoothCoefCentroid
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothCoefCentroid") })
-                  .toString()
-                  .getDoubleValue();
-        paramSmoothCoefSpread
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothCoefSpread") })
-                  .toString()
-                  .getDoubleValue();
-        paramSmoothCoefNoise
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothCoefNoise") })
-                  .toString()
-                  .getDoubleValue();
-        paramSmoothCoefOD
-            = mAPVTS.state
-                  .getProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothCoefOnsetDetection") })
-                  .toString()
-                  .getDoubleValue();
-
-        paramRangeLoudness
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_RangeLoudness") })
-                  .toString()
-                  .getDoubleValue();
-        paramRangePitch
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_RangePitch") })
-                  .toString()
-                  .getDoubleValue();
-        paramRangeCentroid
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_RangeCentroid") })
-                  .toString()
-                  .getDoubleValue();
-        paramRangeSpread
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_RangeSpread") })
-                  .toString()
-                  .getDoubleValue();
-        paramRangeNoise
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_RangeNoise") })
-                  .toString()
-                  .getDoubleValue();
-        paramRangeOD
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_RangeOnsetDetection") })
-                  .toString()
-                  .getDoubleValue();
-
-        paramLapLoudness
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_LapLoudness") })
-                  .toString()
-                  .getDoubleValue();
-        paramLapPitch = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_LapPitch") })
-                            .toString()
-                            .getDoubleValue();
-        paramLapCentroid
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_LapCentroid") })
-                  .toString()
-                  .getDoubleValue();
-        paramLapSpread = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_LapSpread") })
-                             .toString()
-                             .getDoubleValue();
-        paramLapNoise = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_LapNoise") })
-                            .toString()
-                            .getDoubleValue();
-        paramLapOD
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_LapOnsetDetection") })
-                  .toString()
-                  .getDoubleValue();
-
-        paramOffsetLoudness
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_OffsetLoudness") })
-                  .toString()
-                  .getDoubleValue();
-        paramOffsetPitch
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_OffsetPitch") })
-                  .toString()
-                  .getDoubleValue();
-        paramOffsetCentroid
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_OffsetCentroid") })
-                  .toString()
-                  .getDoubleValue();
-        paramOffsetSpread
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_OffsetSpread") })
-                  .toString()
-                  .getDoubleValue();
-        paramOffsetNoise
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_OffsetNoise") })
-                  .toString()
-                  .getDoubleValue();
-        paramOffsetOD
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_OffsetOnsetDetection") })
-                  .toString()
-                  .getDoubleValue();
-
-        paramMinFreqPitch
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_MinFreqPitch") })
-                  .toString()
-                  .getDoubleValue();
-        paramMinFreqCentroid
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_MinFreqCentroid") })
-                  .toString()
-                  .getDoubleValue();
-
-        paramMaxFreqPitch
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_MaxFreqPitch") })
-                  .toString()
-                  .getDoubleValue();
-        paramMaxFreqCentroid
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_MaxFreqCentroid") })
-                  .toString()
-                  .getDoubleValue();
-
-        paramMetricComboBoxIndex
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_MetricOD") })
-                  .toString()
-                  .getIntValue();
-
-        paramThreshold
-            = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_ThresholdOD") })
-                  .toString()
-                  .getDoubleValue();
-
-        paramMinTime = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_MinTimeOD") })
-                           .toString()
-                           .getDoubleValue();
-
-        paramMaxTime = mAPVTS.state.getProperty({ juce::String(parameterName.removeCharacters(" ") + "_MaxTimeOD") })
-                           .toString()
-                           .getDoubleValue();
-    }
+    void setParamOffsetSpread(double value) { setSetting(SpatialParameterSetting::offsetSpread, value); }
+
+    void setParamOffsetNoise(double value) { setSetting(SpatialParameterSetting::offsetNoise, value); }
 
-    void setParametersState()
+    void setParamOffsetSpectralFeature(double value)
     {
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_DescriptorIndex") },
-                                 paramDescriptorComboBoxIndex,
-                                 nullptr);
-
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_ExpanderLoudness") },
-                                 paramExpanderLoudness,
-                                 nullptr);
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_ExpanderSpread") },
-                                 paramExpanderSpread,
-                                 nullptr);
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_ExpanderNoise") },
-                                 paramExpanderNoise,
-                                 nullptr);
-
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothLoudness") },
-                                 paramSmoothLoudness,
-                                 nullptr);
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothPitch") },
-                                 paramSmoothPitch,
-                                 nullptr);
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothCentroid") },
-                                 paramSmoothCentroid,
-                                 nullptr);
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothSpread") },
-                                 paramSmoothSpread,
-                                 nullptr);
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothNoise") },
-                                 paramSmoothNoise,
-                                 nullptr);
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothOnsetDetection") },
-                                 paramSmoothOD,
-                                 nullptr);
-
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothCoefLoudness") },
-                                 paramSmoothCoefLoudness,
-                                 nullptr);
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothCoefPitch") },
-                                 paramSmoothCoefPitch,
-                                 nullptr);
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothCoefCentroid") },
-                                 paramSmoothCoefCentroid,
-                                 nullptr);
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothCoefSpread") },
-                                 paramSmoothCoefSpread,
-                                 nullptr);
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothCoefNoise") },
-                                 paramSmoothCoefNoise,
-                                 nullptr);
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_SmoothCoefOnsetDetection") },
-                                 paramSmoothCoefOD,
-                                 nullptr);
-
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_RangeLoudness") },
-                                 paramRangeLoudness,
-                                 nullptr);
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_RangePitch") },
-                                 paramRangePitch,
-                                 nullptr);
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_RangeCentroid") },
-                                 paramRangeCentroid,
-                                 nullptr);
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_RangeSpread") },
-                                 paramRangeSpread,
-                                 nullptr);
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_RangeNoise") },
-                                 paramRangeNoise,
-                                 nullptr);
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_RangeOnsetDetection") },
-                                 paramRangeOD,
-                                 nullptr);
-
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_LapLoudness") },
-                                 paramLapLoudness,
-                                 nullptr);
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_LapPitch") },
-                                 paramLapPitch,
-                                 nullptr);
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_LapCentroid") },
-                                 paramLapCentroid,
-                                 nullptr);
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_LapSpread") },
-                                 paramLapSpread,
-                                 nullptr);
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_LapNoise") },
-                                 paramLapNoise,
-                                 nullptr);
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_LapOnsetDetection") },
-                                 paramLapOD,
-                                 nullptr);
-
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_OffsetLoudness") },
-                                 paramOffsetLoudness,
-                                 nullptr);
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_OffsetPitch") },
-                                 paramOffsetPitch,
-                                 nullptr);
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_OffsetCentroid") },
-                                 paramOffsetCentroid,
-                                 nullptr);
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_OffsetSpread") },
-                                 paramOffsetSpread,
-                                 nullptr);
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_OffsetNoise") },
-                                 paramOffsetNoise,
-                                 nullptr);
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_OffsetOnsetDetection") },
-                                 paramOffsetOD,
-                                 nullptr);
-
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_MinFreqPitch") },
-                                 paramMinFreqPitch,
-                                 nullptr);
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_MinFreqCentroid") },
-                                 paramMinFreqCentroid,
-                                 nullptr);
-
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_MaxFreqPitch") },
-                                 paramMaxFreqPitch,
-                                 nullptr);
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_MaxFreqCentroid") },
-                                 paramMaxFreqCentroid,
-                                 nullptr);
-
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_MetricOD") },
-                                 paramMetricComboBoxIndex,
-                                 nullptr);
-
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_ThresholdOD") },
-                                 paramThreshold,
-                                 nullptr);
-
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_MinTimeOD") },
-                                 paramMinTime,
-                                 nullptr);
-
-        mAPVTS.state.setProperty({ juce::String(parameterName.removeCharacters(" ") + "_MaxTimeOD") },
-                                 paramMaxTime,
-                                 nullptr);
+        setSetting(SpatialParameterSetting::offsetSpectralFeature, value);
     }
 
+    void setParamOffsetOnsetDetection(double value) { setSetting(SpatialParameterSetting::offsetOD, value); }
+
+    void setParamMinFreqPitch(double value) { setSetting(SpatialParameterSetting::minFreqPitch, value); }
+
+    void setParamMinFreqCentroid(double value) { setSetting(SpatialParameterSetting::minFreqCentroid, value); }
+
+    void setParamMaxFreqPitch(double value) { setSetting(SpatialParameterSetting::maxFreqPitch, value); }
+
+    void setParamMaxFreqCentroid(double value) { setSetting(SpatialParameterSetting::maxFreqCentroid, value); }
+
+    void setParamMetricComboboxIndex(int value) { setSetting(SpatialParameterSetting::metricComboBoxIndex, value); }
+
+    void setParamThreshold(double value) { setSetting(SpatialParameterSetting::threshold, value); }
+
+    void setParamMinTime(double value) { setSetting(SpatialParameterSetting::minTime, value); }
+
+    void setParamMaxTime(double value) { setSetting(SpatialParameterSetting::maxTime, value); }
+
+    //====================================================================
+    /** Reads every setting from the state, e.g. after the state was replaced. */
+    void updateParameterState();
+    /** Writes every setting to the state. */
+    void setParametersState();
+    /** Writes the settings changed since the last call to the state. Message thread only. */
+    void flushParametersState();
+
 protected:
     //==============================================================================
     juce::AudioProcessorValueTreeState & mAPVTS;
@@ -844,64 +334,29 @@ protected:
     Smooth mSmoothCentroid;
     Smooth mSmoothSpread;
     Smooth mSmoothNoise;
+    Smooth mSmoothSpectralFeature;
     Smooth mSmoothOnsetDetection;
+    int mNumSamplesPerStep{ 1 };
+
+    // Written by the setters, on the message thread.
+    SpatialParameterSettings mSettings{};
 
-    int paramDescriptorComboBoxIndex = 1;
-
-    double paramExpanderLoudness = 100.0;
-    double paramExpanderSpread = 100.0;
-    double paramExpanderNoise = 100.0;
-
-    double paramSmoothLoudness = 5.0;
-    double paramSmoothPitch = 5.0;
-    double paramSmoothCentroid = 5.0;
-    double paramSmoothSpread = 5.0;
-    double paramSmoothNoise = 5.0;
-    double paramSmoothOD = 5.0;
-
-    double paramSmoothCoefLoudness = 0.0;
-    double paramSmoothCoefPitch = 0.0;
-    double paramSmoothCoefCentroid = 0.0;
-    double paramSmoothCoefSpread = 0.0;
-    double paramSmoothCoefNoise = 0.0;
-    double paramSmoothCoefOD = 0.0;
-
-    double paramRangeLoudness = 100.0;
-    double paramRangePitch = 100.0;
-    double paramRangeCentroid = 100.0;
-    double paramRangeSpread = 100.0;
-    double paramRangeNoise = 100.0;
-    double paramRangeOD = 100.0;
-
-    double paramLapLoudness = 1.0;
-    double paramLapPitch = 1.0;
-    double paramLapCentroid = 1.0;
-    double paramLapSpread = 1.0;
-    double paramLapNoise = 1.0;
-    double paramLapOD = 1.0;
-
-    double paramOffsetLoudness = 0.0;
-    double paramOffsetPitch = 0.0;
-    double paramOffsetCentroid = 0.0;
-    double paramOffsetSpread = 0.0;
-    double paramOffsetNoise = 0.0;
-    double paramOffsetOD = 0.0;
-
-    double paramMinFreqPitch = 20.0;
-    double paramMinFreqCentroid = 20.0;
-
-    double paramMaxFreqPitch = 5000.0;
-    double paramMaxFreqCentroid = 10000.0;
-
-    int paramMetricComboBoxIndex = 4;
-    double paramThreshold = 0.1;
-    double paramMinTime = 0.1;
-    double paramMaxTime = 10.0;
+    /** The settings as seen by the audio thread, refreshed by beginBlock(). */
+    SpatialParameterSettings const & getAudioSettings() const { return mAudioSettings.getReadBuffer(); }
 
 private:
     //==============================================================================
     // std::vector<PanelView *> mObservers;
 
+    TripleBuffer<SpatialParameterSettings> mAudioSettings{};
+    std::array<juce::Identifier, NUM_SPATIAL_PARAMETER_SETTINGS> mStateIds{};
+    // One bit per SpatialParameterSetting not yet written to the state.
+    juce::uint64 mDirtySettings{};
+
+    //==============================================================================
+    void setSetting(SpatialParameterSetting setting, double value);
+    void publishSettings();
+
     //==============================================================================
     JUCE_LEAK_DETECTOR(SpatialParameter)
 };
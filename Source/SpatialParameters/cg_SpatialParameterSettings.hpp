@@ -0,0 +1,232 @@
+/*
+ This file is part of ControlGris.
+
+ Developers: Hicheme BEN GAIED, Gaël LANE LÉPINE
+
+ ControlGris is free software: you can redistribute it and/or modify
+ it under the terms of the GNU Lesser General Public License as
+ published by the Free Software Foundation, either version 3 of the
+ License, or (at your option) any later version.
+
+ ControlGris is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with ControlGris.  If not, see
+ <http://www.gnu.org/licenses/>.
+*/
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <array>
+
+namespace gris
+{
+//==============================================================================
+/** The user settings of a spatial parameter, in the order of SpatialParameterSettings. */
+enum class SpatialParameterSetting {
+    descriptorComboBoxIndex = 0,
+    expanderLoudness,
+    expanderSpread,
+    expanderNoise,
+    expanderSpectralFeature,
+    smoothLoudness,
+    smoothPitch,
+    smoothCentroid,
+    smoothSpread,
+    smoothNoise,
+    smoothSpectralFeature,
+    smoothOD,
+    smoothCoefLoudness,
+    smoothCoefPitch,
+    smoothCoefCentroid,
+    smoothCoefSpread,
+    smoothCoefNoise,
+    smoothCoefSpectralFeature,
+    smoothCoefOD,
+    rangeLoudness,
+    rangePitch,
+    rangeCentroid,
+    rangeSpread,
+    rangeNoise,
+    rangeSpectralFeature,
+    rangeOD,
+    lapLoudness,
+    lapPitch,
+    lapCentroid,
+    lapSpread,
+    lapNoise,
+    lapSpectralFeature,
+    lapOD,
+    offsetLoudness,
+    offsetPitch,
+    offsetCentroid,
+    offsetSpread,
+    offsetNoise,
+    offsetSpectralFeature,
+    offsetOD,
+    minFreqPitch,
+    minFreqCentroid,
+    maxFreqPitch,
+    maxFreqCentroid,
+    metricComboBoxIndex,
+    threshold,
+    minTime,
+    maxTime,
+    count
+};
+
+static constexpr size_t NUM_SPATIAL_PARAMETER_SETTINGS{ static_cast<size_t>(SpatialParameterSetting::count) };
+
+//==============================================================================
+/** Plain copyable block holding every user setting of a spatial parameter. */
+struct SpatialParameterSettings {
+    int descriptorComboBoxIndex{ 1 };
+    double expanderLoudness{ 100.0 };
+    double expanderSpread{ 100.0 };
+    double expanderNoise{ 100.0 };
+    double expanderSpectralFeature{ 100.0 };
+    double smoothLoudness{ 5.0 };
+    double smoothPitch{ 5.0 };
+    double smoothCentroid{ 5.0 };
+    double smoothSpread{ 5.0 };
+    double smoothNoise{ 5.0 };
+    double smoothSpectralFeature{ 5.0 };
+    double smoothOD{ 5.0 };
+    double smoothCoefLoudness{ 0.0 };
+    double smoothCoefPitch{ 0.0 };
+    double smoothCoefCentroid{ 0.0 };
+    double smoothCoefSpread{ 0.0 };
+    double smoothCoefNoise{ 0.0 };
+    double smoothCoefSpectralFeature{ 0.0 };
+    double smoothCoefOD{ 0.0 };
+    double rangeLoudness{ 100.0 };
+    double rangePitch{ 100.0 };
+    double rangeCentroid{ 100.0 };
+    double rangeSpread{ 100.0 };
+    double rangeNoise{ 100.0 };
+    double rangeSpectralFeature{ 100.0 };
+    double rangeOD{ 100.0 };
+    double lapLoudness{ 1.0 };
+    double lapPitch{ 1.0 };
+    double lapCentroid{ 1.0 };
+    double lapSpread{ 1.0 };
+    double lapNoise{ 1.0 };
+    double lapSpectralFeature{ 1.0 };
+    double lapOD{ 1.0 };
+    double offsetLoudness{ 0.0 };
+    double offsetPitch{ 0.0 };
+    double offsetCentroid{ 0.0 };
+    double offsetSpread{ 0.0 };
+    double offsetNoise{ 0.0 };
+    double offsetSpectralFeature{ 0.0 };
+    double offsetOD{ 0.0 };
+    double minFreqPitch{ 20.0 };
+    double minFreqCentroid{ 20.0 };
+    double maxFreqPitch{ 5000.0 };
+    double maxFreqCentroid{ 10000.0 };
+    int metricComboBoxIndex{ 4 };
+    double threshold{ 0.1 };
+    double minTime{ 0.1 };
+    double maxTime{ 10.0 };
+};
+
+//==============================================================================
+/** Suffix of the state property of a setting and the member holding it. Exactly one of the members is set. */
+struct SpatialParameterSettingInfo {
+    char const * stateSuffix{};
+    double SpatialParameterSettings::*doubleMember{};
+    int SpatialParameterSettings::*intMember{};
+};
+
+inline SpatialParameterSettingInfo const & getSpatialParameterSettingInfo(SpatialParameterSetting const setting)
+{
+    static constexpr std::array<SpatialParameterSettingInfo, NUM_SPATIAL_PARAMETER_SETTINGS> INFOS{ {
+        SpatialParameterSettingInfo{ "_DescriptorIndex", nullptr, &SpatialParameterSettings::descriptorComboBoxIndex },
+        SpatialParameterSettingInfo{ "_ExpanderLoudness", &SpatialParameterSettings::expanderLoudness, nullptr },
+        SpatialParameterSettingInfo{ "_ExpanderSpread", &SpatialParameterSettings::expanderSpread, nullptr },
+        SpatialParameterSettingInfo{ "_ExpanderNoise", &SpatialParameterSettings::expanderNoise, nullptr },
+        SpatialParameterSettingInfo{ "_ExpanderSpectralFeature",
+                                      &SpatialParameterSettings::expanderSpectralFeature,
+                                      nullptr },
+        SpatialParameterSettingInfo{ "_SmoothLoudness", &SpatialParameterSettings::smoothLoudness, nullptr },
+        SpatialParameterSettingInfo{ "_SmoothPitch", &SpatialParameterSettings::smoothPitch, nullptr },
+        SpatialParameterSettingInfo{ "_SmoothCentroid", &SpatialParameterSettings::smoothCentroid, nullptr },
+        SpatialParameterSettingInfo{ "_SmoothSpread", &SpatialParameterSettings::smoothSpread, nullptr },
+        SpatialParameterSettingInfo{ "_SmoothNoise", &SpatialParameterSettings::smoothNoise, nullptr },
+        SpatialParameterSettingInfo{ "_SmoothSpectralFeature",
+                                      &SpatialParameterSettings::smoothSpectralFeature,
+                                      nullptr },
+        SpatialParameterSettingInfo{ "_SmoothOnsetDetection", &SpatialParameterSettings::smoothOD, nullptr },
+        SpatialParameterSettingInfo{ "_SmoothCoefLoudness", &SpatialParameterSettings::smoothCoefLoudness, nullptr },
+        SpatialParameterSettingInfo{ "_SmoothCoefPitch", &SpatialParameterSettings::smoothCoefPitch, nullptr },
+        SpatialParameterSettingInfo{ "_SmoothCoefCentroid", &SpatialParameterSettings::smoothCoefCentroid, nullptr },
+        SpatialParameterSettingInfo{ "_SmoothCoefSpread", &SpatialParameterSettings::smoothCoefSpread, nullptr },
+        SpatialParameterSettingInfo{ "_SmoothCoefNoise", &SpatialParameterSettings::smoothCoefNoise, nullptr },
+        SpatialParameterSettingInfo{ "_SmoothCoefSpectralFeature",
+                                      &SpatialParameterSettings::smoothCoefSpectralFeature,
+                                      nullptr },
+        SpatialParameterSettingInfo{ "_SmoothCoefOnsetDetection", &SpatialParameterSettings::smoothCoefOD, nullptr },
+        SpatialParameterSettingInfo{ "_RangeLoudness", &SpatialParameterSettings::rangeLoudness, nullptr },
+        SpatialParameterSettingInfo{ "_RangePitch", &SpatialParameterSettings::rangePitch, nullptr },
+        SpatialParameterSettingInfo{ "_RangeCentroid", &SpatialParameterSettings::rangeCentroid, nullptr },
+        SpatialParameterSettingInfo{ "_RangeSpread", &SpatialParameterSettings::rangeSpread, nullptr },
+        SpatialParameterSettingInfo{ "_RangeNoise", &SpatialParameterSettings::rangeNoise, nullptr },
+        SpatialParameterSettingInfo{ "_RangeSpectralFeature",
+                                      &SpatialParameterSettings::rangeSpectralFeature,
+                                      nullptr },
+        SpatialParameterSettingInfo{ "_RangeOnsetDetection", &SpatialParameterSettings::rangeOD, nullptr },
+        SpatialParameterSettingInfo{ "_LapLoudness", &SpatialParameterSettings::lapLoudness, nullptr },
+        SpatialParameterSettingInfo{ "_LapPitch", &SpatialParameterSettings::lapPitch, nullptr },
+        SpatialParameterSettingInfo{ "_LapCentroid", &SpatialParameterSettings::lapCentroid, nullptr },
+        SpatialParameterSettingInfo{ "_LapSpread", &SpatialParameterSettings::lapSpread, nullptr },
+        SpatialParameterSettingInfo{ "_LapNoise", &SpatialParameterSettings::lapNoise, nullptr },
+        SpatialParameterSettingInfo{ "_LapSpectralFeature", &SpatialParameterSettings::lapSpectralFeature, nullptr },
+        SpatialParameterSettingInfo{ "_LapOnsetDetection", &SpatialParameterSettings::lapOD, nullptr },
+        SpatialParameterSettingInfo{ "_OffsetLoudness", &SpatialParameterSettings::offsetLoudness, nullptr },
+        SpatialParameterSettingInfo{ "_OffsetPitch", &SpatialParameterSettings::offsetPitch, nullptr },
+        SpatialParameterSettingInfo{ "_OffsetCentroid", &SpatialParameterSettings::offsetCentroid, nullptr },
+        SpatialParameterSettingInfo{ "_OffsetSpread", &SpatialParameterSettings::offsetSpread, nullptr },
+        SpatialParameterSettingInfo{ "_OffsetNoise", &SpatialParameterSettings::offsetNoise, nullptr },
+        SpatialParameterSettingInfo{ "_OffsetSpectralFeature",
+                                      &SpatialParameterSettings::offsetSpectralFeature,
+                                      nullptr },
+        SpatialParameterSettingInfo{ "_OffsetOnsetDetection", &SpatialParameterSettings::offsetOD, nullptr },
+        SpatialParameterSettingInfo{ "_MinFreqPitch", &SpatialParameterSettings::minFreqPitch, nullptr },
+        SpatialParameterSettingInfo{ "_MinFreqCentroid", &SpatialParameterSettings::minFreqCentroid, nullptr },
+        SpatialParameterSettingInfo{ "_MaxFreqPitch", &SpatialParameterSettings::maxFreqPitch, nullptr },
+        SpatialParameterSettingInfo{ "_MaxFreqCentroid", &SpatialParameterSettings::maxFreqCentroid, nullptr },
+        SpatialParameterSettingInfo{ "_MetricOD", nullptr, &SpatialParameterSettings::metricComboBoxIndex },
+        SpatialParameterSettingInfo{ "_ThresholdOD", &SpatialParameterSettings::threshold, nullptr },
+        SpatialParameterSettingInfo{ "_MinTimeOD", &SpatialParameterSettings::minTime, nullptr },
+        SpatialParameterSettingInfo{ "_MaxTimeOD", &SpatialParameterSettings::maxTime, nullptr },
+    } };
+    return INFOS[static_cast<size_t>(setting)];
+}
+
+/** Value of a setting, as stored in the state. */
+inline juce::var getSpatialParameterSetting(SpatialParameterSettings const & settings,
+                                            SpatialParameterSetting const setting)
+{
+    auto const & info{ getSpatialParameterSettingInfo(setting) };
+    return info.intMember != nullptr ? juce::var{ settings.*info.intMember } : juce::var{ settings.*info.doubleMember };
+}
+
+inline void setSpatialParameterSetting(SpatialParameterSettings & settings,
+                                       SpatialParameterSetting const setting,
+                                       double const value)
+{
+    auto const & info{ getSpatialParameterSettingInfo(setting) };
+    if (info.intMember != nullptr) {
+        settings.*info.intMember = static_cast<int>(value);
+    } else {
+        settings.*info.doubleMember = value;
+    }
+}
+} // namespace gris
@@ -41,36 +41,47 @@ public:
 
     void process(const DescriptorID & descID, double valueToProcess) override
     {
+        auto const & settings{ getAudioSettings() };
         auto range{ 0.0 };
         auto offset{ 0.0 };
         auto smooth{ 0.0 };
 
         switch (descID) {
         case DescriptorID::loudness:
-            range = paramRangeLoudness;
-            offset = paramOffsetLoudness;
+            range = settings.rangeLoudness;
+            offset = settings.offsetLoudness;
             smooth = processLoudness(valueToProcess);
             break;
         case DescriptorID::pitch:
-            range = paramRangePitch;
+            range = settings.rangePitch;
             smooth = processPitch(valueToProcess);
             break;
         case DescriptorID::centroid:
-            range = paramRangeCentroid;
+            range = settings.rangeCentroid;
             smooth = processCentroid(valueToProcess);
             break;
         case DescriptorID::spread:
-            range = paramRangeSpread;
-            offset = paramOffsetSpread;
+            range = settings.rangeSpread;
+            offset = settings.offsetSpread;
             smooth = processSpread(valueToProcess);
             break;
         case DescriptorID::noise:
-            range = paramRangeNoise;
-            offset = paramOffsetNoise;
+            range = settings.rangeNoise;
+            offset = settings.offsetNoise;
             smooth = processNoise(valueToProcess);
             break;
+        case DescriptorID::flux:
+        case DescriptorID::rolloff:
+        case DescriptorID::crest:
+        case DescriptorID::lowBandEnergy:
+        case DescriptorID::midBandEnergy:
+        case DescriptorID::highBandEnergy:
+            range = settings.rangeSpectralFeature;
+            offset = settings.offsetSpectralFeature;
+            smooth = processSpectralFeature(valueToProcess);
+            break;
         case DescriptorID::iterationsSpeed:
-            range = paramRangeOD;
+            range = settings.rangeOD;
             smooth = processSmoothedOnsetDetection(valueToProcess);
             break;
         case DescriptorID::invalid:
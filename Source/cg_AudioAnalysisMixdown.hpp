@@ -0,0 +1,165 @@
+/*
+ This file is part of ControlGris.
+
+ Developers: Hicheme BEN GAIED, Gaël LANE LÉPINE
+
+ ControlGris is free software: you can redistribute it and/or modify
+ it under the terms of the GNU Lesser General Public License as
+ published by the Free Software Foundation, either version 3 of the
+ License, or (at your option) any later version.
+
+ ControlGris is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with ControlGris.  If not, see
+ <http://www.gnu.org/licenses/>.
+*/
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <array>
+#include <atomic>
+
+namespace gris
+{
+//==============================================================================
+/** Weighted mixdown of the input channels into the mono signal given to the audio descriptors.
+ *
+ * Each channel has a weight and can be left out of the mix. The weights are normalised so that, with the default
+ * settings, the mix is the mean of all the input channels. Channels past MAX_NUM_WEIGHTED_CHANNELS always have a
+ * weight of 1. Settings can be changed from any thread, mix() is meant for the audio thread.
+ */
+class AudioAnalysisMixdown
+{
+public:
+    //==============================================================================
+    static constexpr int MAX_NUM_WEIGHTED_CHANNELS{ 256 };
+
+    //==============================================================================
+    AudioAnalysisMixdown() { reset(); }
+
+    void reset()
+    {
+        for (auto & weight : mWeights) {
+            weight.store(1.0f, std::memory_order_relaxed);
+        }
+        for (auto & isEnabled : mEnabledChannels) {
+            isEnabled.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    void setChannelWeight(int channel, float weight)
+    {
+        if (juce::isPositiveAndBelow(channel, MAX_NUM_WEIGHTED_CHANNELS)) {
+            mWeights[static_cast<size_t>(channel)].store(std::max(weight, 0.0f), std::memory_order_relaxed);
+        }
+    }
+
+    float getChannelWeight(int channel) const
+    {
+        return juce::isPositiveAndBelow(channel, MAX_NUM_WEIGHTED_CHANNELS)
+                   ? mWeights[static_cast<size_t>(channel)].load(std::memory_order_relaxed)
+                   : 1.0f;
+    }
+
+    void setChannelEnabled(int channel, bool shouldBeEnabled)
+    {
+        if (juce::isPositiveAndBelow(channel, MAX_NUM_WEIGHTED_CHANNELS)) {
+            mEnabledChannels[static_cast<size_t>(channel)].store(shouldBeEnabled, std::memory_order_relaxed);
+        }
+    }
+
+    bool isChannelEnabled(int channel) const
+    {
+        return !juce::isPositiveAndBelow(channel, MAX_NUM_WEIGHTED_CHANNELS)
+               || mEnabledChannels[static_cast<size_t>(channel)].load(std::memory_order_relaxed);
+    }
+
+    //==============================================================================
+    /** Writes gain * (sum of w_i * x_i) / (sum of w_i) over the enabled channels in destination, from startSample of
+     * input. Every channel is read exactly once, with vectorised operations.
+     */
+    void mix(juce::AudioBuffer<float> const & input,
+             int numChannels,
+             int startSample,
+             float * destination,
+             int numSamples,
+             float gain) const noexcept
+    {
+        float totalWeight{};
+        for (int channel{}; channel < numChannels; ++channel) {
+            totalWeight += getEffectiveWeight(channel);
+        }
+
+        if (totalWeight <= 0.0f) {
+            juce::FloatVectorOperations::clear(destination, numSamples);
+            return;
+        }
+
+        auto const normalisation{ gain / totalWeight };
+        auto isFirstChannel{ true };
+        for (int channel{}; channel < numChannels; ++channel) {
+            auto const weight{ getEffectiveWeight(channel) };
+            if (weight <= 0.0f) {
+                continue;
+            }
+            auto const * source{ input.getReadPointer(channel, startSample) };
+            if (isFirstChannel) {
+                juce::FloatVectorOperations::copyWithMultiply(destination, source, weight * normalisation, numSamples);
+                isFirstChannel = false;
+            } else {
+                juce::FloatVectorOperations::addWithMultiply(destination, source, weight * normalisation, numSamples);
+            }
+        }
+    }
+
+    //==============================================================================
+    /** Space separated weights. The weight of a disabled channel is prefixed with a minus sign. */
+    juce::String toString() const
+    {
+        // Trailing default channels are not written.
+        auto numChannels{ MAX_NUM_WEIGHTED_CHANNELS };
+        while (numChannels > 0 && isChannelEnabled(numChannels - 1) && getChannelWeight(numChannels - 1) == 1.0f) {
+            --numChannels;
+        }
+
+        juce::StringArray tokens;
+        for (int channel{}; channel < numChannels; ++channel) {
+            tokens.add((isChannelEnabled(channel) ? "" : "-") + juce::String{ getChannelWeight(channel) });
+        }
+        return tokens.joinIntoString(" ");
+    }
+
+    void fromString(juce::String const & string)
+    {
+        reset();
+        auto const tokens{ juce::StringArray::fromTokens(string, false) };
+        for (int channel{}; channel < std::min(tokens.size(), MAX_NUM_WEIGHTED_CHANNELS); ++channel) {
+            auto const & token{ tokens[channel] };
+            setChannelEnabled(channel, !token.startsWithChar('-'));
+            setChannelWeight(channel, std::abs(token.getFloatValue()));
+        }
+    }
+
+private:
+    //==============================================================================
+    float getEffectiveWeight(int channel) const noexcept
+    {
+        return isChannelEnabled(channel) ? getChannelWeight(channel) : 0.0f;
+    }
+
+    //==============================================================================
+    std::array<std::atomic<float>, MAX_NUM_WEIGHTED_CHANNELS> mWeights{};
+    std::array<std::atomic<bool>, MAX_NUM_WEIGHTED_CHANNELS> mEnabledChannels{};
+
+    //==============================================================================
+    JUCE_LEAK_DETECTOR(AudioAnalysisMixdown)
+};
+} // namespace gris
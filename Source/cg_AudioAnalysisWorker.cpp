@@ -0,0 +1,132 @@
+/*
+ This file is part of ControlGris.
+
+ Developers: Hicheme BEN GAIED, Gaël LANE LÉPINE
+
+ ControlGris is free software: you can redistribute it and/or modify
+ it under the terms of the GNU Lesser General Public License as
+ published by the Free Software Foundation, either version 3 of the
+ License, or (at your option) any later version.
+
+ ControlGris is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with ControlGris.  If not, see
+ <http://www.gnu.org/licenses/>.
+*/
+
+//==============================================================================
+
+#include "cg_AudioAnalysisWorker.hpp"
+
+#include "cg_ControlGrisAudioProcessor.hpp"
+
+namespace gris
+{
+//==============================================================================
+AudioAnalysisWorker::AudioAnalysisWorker(ControlGrisAudioProcessor & processor)
+    : juce::Thread("ControlGris audio analysis")
+    , mProcessor(processor)
+{
+}
+
+//==============================================================================
+AudioAnalysisWorker::~AudioAnalysisWorker()
+{
+    stop();
+}
+
+//==============================================================================
+void AudioAnalysisWorker::prepare(double const sampleRate, int const blockSize)
+{
+    jassert(!isRunning());
+
+    mSampleRate = sampleRate;
+    mBlockSize = blockSize;
+
+    // One second of audio, so that a slow analysis frame does not make the audio thread drop samples.
+    auto const capacity{ std::max(static_cast<int>(sampleRate), blockSize * 8) };
+    mFifoData.assign(static_cast<size_t>(capacity), 0.0f);
+    mFifo.setTotalSize(capacity);
+    mAnalysisBuffer.setSize(1, blockSize);
+}
+
+//==============================================================================
+void AudioAnalysisWorker::start()
+{
+    if (isRunning() || mBlockSize <= 0) {
+        return;
+    }
+
+    mFifo.reset();
+    mSnapshots.reset({});
+    mNumPushedSamples = 0;
+    mNumAnalysedSamples = 0;
+    mLatencyMs.store(0.0, std::memory_order_relaxed);
+
+    startThread();
+}
+
+//==============================================================================
+void AudioAnalysisWorker::stop()
+{
+    stopThread(STOP_TIMEOUT_MS);
+}
+
+//==============================================================================
+void AudioAnalysisWorker::pushSamples(float const * data, int const numSamples) noexcept
+{
+    int start1, size1, start2, size2;
+    mFifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+    // When the worker falls behind, the samples that do not fit are dropped.
+    std::copy_n(data, size1, mFifoData.data() + start1);
+    std::copy_n(data + size1, size2, mFifoData.data() + start2);
+    mFifo.finishedWrite(size1 + size2);
+
+    mNumPushedSamples += static_cast<juce::uint64>(size1 + size2);
+}
+
+//==============================================================================
+bool AudioAnalysisWorker::pullSnapshot(AudioDescriptorSnapshot & snapshot) noexcept
+{
+    if (!mSnapshots.update()) {
+        return false;
+    }
+
+    snapshot = mSnapshots.getReadBuffer();
+
+    auto const pendingSamples{ static_cast<double>(mNumPushedSamples - snapshot.numAnalysedSamples) };
+    mLatencyMs.store(pendingSamples / mSampleRate * 1000.0, std::memory_order_relaxed);
+
+    return true;
+}
+
+//==============================================================================
+void AudioAnalysisWorker::run()
+{
+    while (!threadShouldExit()) {
+        if (mFifo.getNumReady() < mBlockSize) {
+            wait(WAIT_TIMEOUT_MS);
+            continue;
+        }
+
+        int start1, size1, start2, size2;
+        mFifo.prepareToRead(mBlockSize, start1, size1, start2, size2);
+        auto * channelData{ mAnalysisBuffer.getWritePointer(0) };
+        std::copy_n(mFifoData.data() + start1, size1, channelData);
+        std::copy_n(mFifoData.data() + start2, size2, channelData + size1);
+        mFifo.finishedRead(size1 + size2);
+        mNumAnalysedSamples += static_cast<juce::uint64>(mBlockSize);
+
+        auto & snapshot{ mSnapshots.getWriteBuffer() };
+        mProcessor.analyseAudioDescriptors(mAnalysisBuffer, mBlockSize, snapshot);
+        snapshot.numAnalysedSamples = mNumAnalysedSamples;
+        mSnapshots.publish();
+    }
+}
+
+} // namespace gris
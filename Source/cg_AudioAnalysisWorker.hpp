@@ -0,0 +1,113 @@
+/*
+ This file is part of ControlGris.
+
+ Developers: Hicheme BEN GAIED, Gaël LANE LÉPINE
+
+ ControlGris is free software: you can redistribute it and/or modify
+ it under the terms of the GNU Lesser General Public License as
+ published by the Free Software Foundation, either version 3 of the
+ License, or (at your option) any later version.
+
+ ControlGris is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with ControlGris.  If not, see
+ <http://www.gnu.org/licenses/>.
+*/
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "cg_TripleBuffer.hpp"
+
+namespace gris
+{
+class ControlGrisAudioProcessor;
+
+//==============================================================================
+/** Values produced by one pass of the audio descriptors chain, ready to be given to the spatial parameters. */
+struct AudioDescriptorSnapshot {
+    double loudness{};
+    double pitch{};
+    double centroid{};
+    double spread{};
+    double flatness{};
+    double flux{};
+    double rolloff{};
+    double crest{};
+    double lowBandEnergy{};
+    double midBandEnergy{};
+    double highBandEnergy{};
+    // Indexed like the spatial parameters of the current SpatMode.
+    std::array<double, 5> onsetDetection{};
+    // Number of input samples analysed when this snapshot was produced.
+    juce::uint64 numAnalysedSamples{};
+};
+
+//==============================================================================
+/** Runs the audio descriptors chain away from the audio thread.
+ *
+ * The audio thread only pushes the mono analysis signal in a wait-free FIFO and pulls the latest snapshot. The worker
+ * thread analyses the FIFO content one block at a time with ControlGrisAudioProcessor::analyseAudioDescriptors() and
+ * publishes its results through a triple buffer.
+ */
+class AudioAnalysisWorker final : private juce::Thread
+{
+    //==============================================================================
+    ControlGrisAudioProcessor & mProcessor;
+
+    double mSampleRate{};
+    int mBlockSize{};
+
+    juce::AbstractFifo mFifo{ 1 };
+    std::vector<float> mFifoData{};
+    juce::AudioBuffer<float> mAnalysisBuffer{};
+    TripleBuffer<AudioDescriptorSnapshot> mSnapshots{};
+
+    juce::uint64 mNumPushedSamples{};   // audio thread
+    juce::uint64 mNumAnalysedSamples{}; // worker thread
+    std::atomic<double> mLatencyMs{};
+
+    static constexpr int WAIT_TIMEOUT_MS{ 1 };
+    static constexpr int STOP_TIMEOUT_MS{ 1000 };
+
+public:
+    //==============================================================================
+    AudioAnalysisWorker() = delete;
+    ~AudioAnalysisWorker() override;
+
+    AudioAnalysisWorker(AudioAnalysisWorker const &) = delete;
+    AudioAnalysisWorker(AudioAnalysisWorker &&) = delete;
+
+    AudioAnalysisWorker & operator=(AudioAnalysisWorker const &) = delete;
+    AudioAnalysisWorker & operator=(AudioAnalysisWorker &&) = delete;
+    //==============================================================================
+    explicit AudioAnalysisWorker(ControlGrisAudioProcessor & processor);
+
+    //==============================================================================
+    // Message thread. The worker must be stopped while the analysis chain is prepared.
+    void prepare(double sampleRate, int blockSize);
+    void start();
+    void stop();
+    [[nodiscard]] bool isRunning() const { return isThreadRunning(); }
+    [[nodiscard]] double getLatencyMs() const { return mLatencyMs.load(std::memory_order_relaxed); }
+
+    //==============================================================================
+    // Audio thread
+    void pushSamples(float const * data, int numSamples) noexcept;
+    bool pullSnapshot(AudioDescriptorSnapshot & snapshot) noexcept;
+
+private:
+    //==============================================================================
+    void run() override;
+
+    //==============================================================================
+    JUCE_LEAK_DETECTOR(AudioAnalysisWorker)
+};
+} // namespace gris
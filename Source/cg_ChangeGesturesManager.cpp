@@ -22,6 +22,19 @@
 
 namespace gris
 {
+//==============================================================================
+ChangeGesturesManager::ChangeGesturesManager(juce::AudioProcessorValueTreeState & audioProcessorValueTreeState)
+    : mAudioProcessorValueTreeState(audioProcessorValueTreeState)
+{
+    // Every parameter gets its entry up front, so that beginGesture() never inserts in the map (and allocates) when
+    // called from the audio thread.
+    for (auto * parameter : audioProcessorValueTreeState.processor.getParameters()) {
+        if (auto const * parameterWithId{ dynamic_cast<juce::AudioProcessorParameterWithID *>(parameter) }) {
+            mGestureStates.set(parameterWithId->paramID, 0);
+        }
+    }
+}
+
 //==============================================================================
 ChangeGesturesManager::ScopedLock::ScopedLock(ChangeGesturesManager & manager, juce::String const & parameterName)
     : mManager(manager)
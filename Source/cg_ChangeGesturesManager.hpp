@@ -78,10 +78,7 @@ public:
     ChangeGesturesManager & operator=(ChangeGesturesManager const &) = delete;
     ChangeGesturesManager & operator=(ChangeGesturesManager &&) = delete;
     //==============================================================================
-    explicit ChangeGesturesManager(juce::AudioProcessorValueTreeState & audioProcessorValueTreeState)
-        : mAudioProcessorValueTreeState(audioProcessorValueTreeState)
-    {
-    }
+    explicit ChangeGesturesManager(juce::AudioProcessorValueTreeState & audioProcessorValueTreeState);
     //==============================================================================
 
     void beginGesture(juce::String const & parameterName);
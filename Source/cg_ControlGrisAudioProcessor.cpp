@@ -232,6 +232,13 @@ ControlGrisAudioProcessor::ControlGrisAudioProcessor()
     mAudioProcessorValueTreeState.addParameterListener(Automation::Ids::POSITION_SPEED_SLIDER, this);
     mAudioProcessorValueTreeState.addParameterListener(Automation::Ids::ELEVATION_SPEED_SLIDER, this);
 
+    // Initialization on play only for Logic, Reaper, Live, Pro Tools and Digital Performer, which are not calling
+    // prepareToPlay every time the sequence starts.
+    juce::PluginHostType const hostType;
+    mHostNeedsInitializationOnPlay
+        = hostType.isLogic() || hostType.isReaper() || hostType.isAbletonLive() || hostType.isDigitalPerformer()
+          || hostType.isProTools() || juce::String(hostType.getHostDescription()).compare(juce::String("Unknown")) == 0;
+
     // The timer's callback send OSC messages periodically.
     //-----------------------------------------------------
     startTimerHz(50);
@@ -240,6 +247,7 @@ ControlGrisAudioProcessor::ControlGrisAudioProcessor()
 //==============================================================================
 ControlGrisAudioProcessor::~ControlGrisAudioProcessor()
 {
+    mAudioAnalysisWorker.stop();
     [[maybe_unused]] auto const success{ disconnectOsc() };
 }
 
@@ -395,6 +403,9 @@ void ControlGrisAudioProcessor::setSpatMode(SpatMode const spatMode)
                                                    SourceLinkEnforcer::OriginOfChange::automation);
     }
 
+    // Only the spatial parameters of the current SpatMode follow the descriptors.
+    updateAudioAnalysisRouting();
+
     auto * editor{ dynamic_cast<ControlGrisAudioProcessorEditor *>(getActiveEditor()) };
     if (editor) {
         editor->setSpatMode(spatMode);
@@ -878,11 +889,13 @@ void ControlGrisAudioProcessor::sendOscOutputMessage()
 
     auto const pluginInstance = juce::String{ "/controlgris/" } + juce::String{ getOscOutputPluginId() };
 
-    auto const trajectoryHandlePosition{ (mSources.getPrimarySource().getPos() + juce::Point<float>{ 1.0f, 1.0f })
+    // While a trajectory plays, these are the points last published by the audio thread.
+    auto const trajectoryHandlePosition{ (mPositionTrajectoryManager.getCurrentTrajectoryPoint()
+                                          + juce::Point<float>{ 1.0f, 1.0f })
                                          / 2.0f };
     auto const trajectory1x = trajectoryHandlePosition.getX();
     auto const trajectory1y = 1.0f - trajectoryHandlePosition.getY();
-    auto const trajectory1z = 1.0f - mSources.getPrimarySource().getNormalizedElevation().get();
+    auto const trajectory1z = 1.0f - (mElevationTrajectoryManager.getCurrentTrajectoryPoint().getY() + 1.0f) / 2.0f;
 
     if (mLastTrajectoryX != trajectory1x) {
         message.setAddressPattern(juce::OSCAddressPattern(pluginInstance + "/traj/1/x"));
@@ -1013,18 +1026,32 @@ void ControlGrisAudioProcessor::timerCallback()
 {
     auto * editor{ dynamic_cast<ControlGrisAudioProcessorEditor *>(getActiveEditor()) };
 
-    // automation
-    if (mLastTimerTime != getCurrentTime() && mSelectedSoundTrajectoriesTabIdx == 1) {
-        auto const deltaTime{ getCurrentTime() - getInitTimeOnPlay() };
-        if (mPositionTrajectoryManager.getPositionActivateState()) {
-            mPositionTrajectoryManager.setTrajectoryDeltaTime(deltaTime);
-        }
-        if (mSpatMode == SpatMode::cube && mElevationTrajectoryManager.getPositionActivateState()) {
-            mElevationTrajectoryManager.setTrajectoryDeltaTime(deltaTime);
+    // deal with trajectory recording gestures, before the played points below change the parameters
+    bool const isPositionTrajectoryActive{ mPositionTrajectoryManager.getPositionActivateState() };
+    bool const isElevationTrajectoryActive{ mElevationTrajectoryManager.getPositionActivateState() };
+
+    if (isPositionTrajectoryActive && mIsPlaying && !mPositionGestureStarted) {
+        mPositionGestureStarted = true;
+        mChangeGesturesManager.beginGesture(Automation::Ids::X);
+        mChangeGesturesManager.beginGesture(Automation::Ids::Y);
+    } else if ((!isPositionTrajectoryActive || !mIsPlaying) && mPositionGestureStarted) {
+        mPositionGestureStarted = false;
+        mChangeGesturesManager.endGesture(Automation::Ids::X);
+        mChangeGesturesManager.endGesture(Automation::Ids::Y);
+    }
+    if (mSpatMode == SpatMode::cube) {
+        if (isElevationTrajectoryActive && mIsPlaying && !mElevationGestureStarted) {
+            mElevationGestureStarted = true;
+            mChangeGesturesManager.beginGesture(Automation::Ids::Z);
+        } else if ((!isElevationTrajectoryActive || !mIsPlaying) && mElevationGestureStarted) {
+            mElevationGestureStarted = false;
+            mChangeGesturesManager.endGesture(Automation::Ids::Z);
         }
     }
 
-    mLastTimerTime = getCurrentTime();
+    // automation: processBlock() evaluates the trajectories, the sources follow the points it reached
+    mPositionTrajectoryManager.exchangePlaybackState();
+    mElevationTrajectoryManager.exchangePlaybackState();
 
     if (mCanStopActivate && !mIsPlaying) {
         bool positionActivateAlwaysOn{ mAudioProcessorValueTreeState.state.getProperty(
@@ -1047,12 +1074,21 @@ void ControlGrisAudioProcessor::timerCallback()
         }
     }
 
+    drainTelemetry();
+    flushSpatialParametersState();
+    mAnalysisResources.update(
+        getRequiredAnalysisResources(),
+        juce::Time::getMillisecondCounterHiRes(),
+        [this](AnalysisResource const resource) { allocateAnalysisResource(resource); },
+        [this](AnalysisResource const resource) { releaseAnalysisResource(resource); });
+
     if (editor != nullptr) {
         editor->refresh();
     }
 
     sendOscMessage();
     sendOscOutputMessage();
+    sendOscMonitorMessage();
 }
 
 //==============================================================================
@@ -1196,7 +1232,6 @@ void ControlGrisAudioProcessor::initialize()
     }
 
     mNeedsInitialization = true;
-    mLastTime = mLastTimerTime = 10000000.0;
     mCanStopActivate = true;
 }
 
@@ -1204,30 +1239,20 @@ void ControlGrisAudioProcessor::initialize()
 void ControlGrisAudioProcessor::prepareToPlay([[maybe_unused]] double const sampleRate,
                                               [[maybe_unused]] int const samplesPerBlock)
 {
+    mAudioAnalysisWorker.stop();
+
     mSampleRate = sampleRate;
     mBlockSize = samplesPerBlock;
 
-    mPitch.reset();
-    mLoudness.reset();
     mStats.reset();
-    mShape.reset();
-    mCentroid.reset();
-    mSpread.reset();
-    mFlatness.reset();
-    mOnsetDetectionAzimuth.reset(samplesPerBlock);
-    mOnsetDetectionElevation.reset(samplesPerBlock);
-    mOnsetDetectionHSpan.reset(samplesPerBlock);
-    mOnsetDetectionVSpan.reset(samplesPerBlock);
-    mOnsetDetectionX.reset(samplesPerBlock);
-    mOnsetDetectionY.reset(samplesPerBlock);
-    mOnsetDetectionZ.reset(samplesPerBlock);
-
-    mPitch.init();
-    mLoudness.init(mSampleRate);
     mStats.init();
-    mCentroid.init();
-    mSpread.init();
-    mFlatness.init();
+    mOnsetDetectionAzimuth.reset();
+    mOnsetDetectionElevation.reset();
+    mOnsetDetectionHSpan.reset();
+    mOnsetDetectionVSpan.reset();
+    mOnsetDetectionX.reset();
+    mOnsetDetectionY.reset();
+    mOnsetDetectionZ.reset();
     mOnsetDetectionAzimuth.init();
     mOnsetDetectionElevation.init();
     mOnsetDetectionHSpan.init();
@@ -1236,28 +1261,41 @@ void ControlGrisAudioProcessor::prepareToPlay([[maybe_unused]] double const samp
     mOnsetDetectionY.init();
     mOnsetDetectionZ.init();
 
-    mInLoudness.resize(mBlockSize);
-    mPaddedLoudness = mLoudness.calculatePadded(mInLoudness);
-    mNFramesLoudness = mLoudness.calculateFrames(mPaddedLoudness);
-    mLoudnessMat = fluid::RealMatrix(mNFramesLoudness, 2);
-    mLoudnessDesc.resize(2);
+    mAnalysisSignal.resize(mBlockSize);
 
-    mInPitch.resize(mBlockSize);
-    mPaddedPitch = mPitch.calculatePadded(mInPitch);
-    mNFramesPitch = mPitch.calculateFrames(mPaddedPitch);
-    mPitchMat = fluid::RealMatrix(mNFramesPitch, 2);
+    mDescriptorScheduler.prepare(mSampleRate);
+    mMultiChannelAnalysis.prepare(mSampleRate);
+    for (auto * spatParam : mSpatParametersDomeRefs) {
+        spatParam->prepare(mSampleRate);
+    }
+    for (auto * spatParam : mSpatParametersCubeRefs) {
+        spatParam->prepare(mSampleRate);
+    }
+    mNumProcessedSamples = 0;
+    mTrajectoryClock.prepare(mSampleRate);
+
+    // A scheduled spectral descriptor analyses a single frame each time it runs.
+    mPitchMat = fluid::RealMatrix(1, 2);
     mCalculatedPitchDesc.resize(2);
-    mPitch.setFrame(mFramePitch);
-    mPitch.setMagnitude(mMagnitudePitch);
 
-    mInSpectral.resize(mBlockSize);
-    mPaddedSpectral = mShape.calculatePadded(mInSpectral);
-    mNFramesSpectral = mShape.calculateFrames(mPaddedSpectral);
-    mShapeMat = fluid::RealMatrix(mNFramesSpectral, 7);
+    mShapeMat = fluid::RealMatrix(1, 7);
+    mShapeStats = fluid::RealVector(7); // shape stats stay at zero until the first frame is analysed
     mCalculatedShapeDesc.resize(7);
     mDescriptorsBuffer.setSize(1, mBlockSize);
-    mShape.setFrame(nFrameSpectral);
-    mShape.setMagnitude(mMagnitudeSpectral);
+
+    mStats.prepare(std::max(mPitchMat.cols(), mShapeMat.cols()));
+
+    // The descriptors only get their buffers once a spatial parameter follows them, most instances never analyse.
+    mAnalysisResources.prepare(
+        getRequiredAnalysisResources(),
+        juce::Time::getMillisecondCounterHiRes(),
+        [this](AnalysisResource const resource) { allocateAnalysisResource(resource); },
+        [this](AnalysisResource const resource) { releaseAnalysisResource(resource); });
+
+    mAudioAnalysisWorker.prepare(mSampleRate, mBlockSize);
+    if (isAudioAnalysisAsync()) {
+        mAudioAnalysisWorker.start();
+    }
 
     juce::MessageManager::callAsync([this] {
         auto * editor{ dynamic_cast<ControlGrisAudioProcessorEditor *>(getActiveEditor()) };
@@ -1290,59 +1328,40 @@ void ControlGrisAudioProcessor::processBlock([[maybe_unused]] juce::AudioBuffer<
                                              [[maybe_unused]] juce::MidiBuffer & midiMessages) [[clang::nonblocking]]
 {
     auto const wasPlaying{ mIsPlaying };
+    TrajectoryClockTick trajectoryTick{};
+    auto hasTrajectoryTick{ false };
     juce::AudioPlayHead * audioPlayHead = getPlayHead();
     if (audioPlayHead != nullptr) {
         auto currentPositionInfo = audioPlayHead->getPosition();
         mIsPlaying = currentPositionInfo->getIsPlaying();
         mBpm = currentPositionInfo->getBpm().orFallback(120.0);
         if (mNeedsInitialization) {
-            auto timeInSeconds = currentPositionInfo->getTimeInSeconds().orFallback(0.0);
-            mCurrentTime = (timeInSeconds < 0.0) ? 0.0 : timeInSeconds;
-            mInitTimeOnPlay = mCurrentTime;
+            mTrajectoryClock.restart();
             mNeedsInitialization = false;
-        } else {
-            mCurrentTime = currentPositionInfo->getTimeInSeconds().orFallback(0.0);
-            if (mInitTimeOnPlay > mCurrentTime) {
-                mInitTimeOnPlay = mCurrentTime;
-            }
         }
+        auto const timeInSeconds{ currentPositionInfo->getTimeInSeconds().orFallback(0.0) };
+        hasTrajectoryTick = mTrajectoryClock.advance(
+            currentPositionInfo->getTimeInSamples().orFallback(
+                static_cast<juce::int64>(std::llround(timeInSeconds * mSampleRate))),
+            trajectoryTick);
     }
 
-    if (!wasPlaying
-        && mIsPlaying) { // Initialization here only for Logic, Reaper, Live, Pro Tools and Digital Performer,
-        juce::PluginHostType const hostType; // which are not calling prepareToPlay every time the sequence starts.
-        if (hostType.isLogic() || hostType.isReaper() || hostType.isAbletonLive() || hostType.isDigitalPerformer()
-            || hostType.isProTools()
-            || juce::String(hostType.getHostDescription()).compare(juce::String("Unknown")) == 0) {
-            initialize();
-        }
+    if (!wasPlaying && mIsPlaying && mHostNeedsInitializationOnPlay) {
+        initialize();
     }
 
-    // deal with trajectory recording gestures
     bool const isPositionTrajectoryActive{ mPositionTrajectoryManager.getPositionActivateState() };
     bool const isElevationTrajectoryActive{ mElevationTrajectoryManager.getPositionActivateState() };
 
-    if (isPositionTrajectoryActive && mIsPlaying && !mPositionGestureStarted) {
-        mPositionGestureStarted = true;
-        mChangeGesturesManager.beginGesture(Automation::Ids::X);
-        mChangeGesturesManager.beginGesture(Automation::Ids::Y);
-    } else if ((!isPositionTrajectoryActive || !mIsPlaying) && mPositionGestureStarted) {
-        mPositionGestureStarted = false;
-        mChangeGesturesManager.endGesture(Automation::Ids::X);
-        mChangeGesturesManager.endGesture(Automation::Ids::Y);
-    }
-    if (mSpatMode == SpatMode::cube) {
-        if (isElevationTrajectoryActive && mIsPlaying && !mElevationGestureStarted) {
-            mElevationGestureStarted = true;
-            mChangeGesturesManager.beginGesture(Automation::Ids::Z);
-        } else if ((!isElevationTrajectoryActive || !mIsPlaying) && mElevationGestureStarted) {
-            mElevationGestureStarted = false;
-            mChangeGesturesManager.endGesture(Automation::Ids::Z);
+    if (hasTrajectoryTick && mSelectedSoundTrajectoriesTabIdx == 1) {
+        if (isPositionTrajectoryActive) {
+            mPositionTrajectoryManager.setTrajectoryDeltaTime(trajectoryTick.timeFromPlayS);
+        }
+        if (mSpatMode == SpatMode::cube && isElevationTrajectoryActive) {
+            mElevationTrajectoryManager.setTrajectoryDeltaTime(trajectoryTick.timeFromPlayS);
         }
     }
 
-    mLastTime = mCurrentTime;
-
     // Audio Descriptors section
     if (mShouldProcessAudioAnalysis) {
         mAzimuthDomeValue = 0.0;
@@ -1363,220 +1382,467 @@ void ControlGrisAudioProcessor::processBlock([[maybe_unused]] juce::AudioBuffer<
         for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
             buffer.clear(i, 0, buffer.getNumSamples());
 
-        mDescriptorsBuffer.clear();
-        if (mChannelToAnalyse > totalNumInputChannels) {
-            // Mix all channels
-            for (int i{}; i < totalNumInputChannels; ++i) {
-                mDescriptorsBuffer.addFrom(0, 0, buffer, i, 0, buffer.getNumSamples());
-            }
-            mDescriptorsBuffer.applyGain((1.0f / totalNumInputChannels)
-                                         * static_cast<float>(mAudioAnalysisInputGainMultiplier));
-        } else {
-            mDescriptorsBuffer.addFrom(0, 0, buffer, mChannelToAnalyse - 1, 0, buffer.getNumSamples());
-            mDescriptorsBuffer.applyGain(1.0f * static_cast<float>(mAudioAnalysisInputGainMultiplier));
+        auto const isAudioAnalysisAsync{ mAudioAnalysisAsync.load(std::memory_order_acquire) };
+        if (isAudioAnalysisAsync != mWasAudioAnalysisAsync) {
+            mWasAudioAnalysisAsync = isAudioAnalysisAsync;
+            mHasAudioDescriptorSnapshot = false;
         }
 
-        auto bufferMagnitude = mDescriptorsBuffer.getMagnitude(0, mDescriptorsBuffer.getNumSamples());
-        auto * channelData = mDescriptorsBuffer.getReadPointer(0);
-
-        // FLUCOMA
-        if (shouldProcessDomeLoudnessAnalysis() || shouldProcessCubeLoudnessAnalysis()) {
-            for (int i{}; i < mDescriptorsBuffer.getNumSamples(); ++i) {
-                mInLoudness[i] = channelData[i];
+        // Hosts may send blocks larger than the size given to prepareToPlay(): they are analysed in chunks of at most
+        // that size. Only the samples of the block are analysed, so short blocks do not feed silence to the
+        // streaming descriptors.
+        auto const analysisGain{ static_cast<float>(mAudioAnalysisInputGainMultiplier) };
+        auto const maxChunkSize{ mDescriptorsBuffer.getNumSamples() };
+        for (int chunkStart{}; chunkStart < buffer.getNumSamples() && maxChunkSize > 0; chunkStart += maxChunkSize) {
+            auto const chunkSize{ std::min(maxChunkSize, buffer.getNumSamples() - chunkStart) };
+            if (mChannelToAnalyse > totalNumInputChannels) {
+                // Mix all channels
+                mAudioAnalysisMixdown.mix(buffer,
+                                          totalNumInputChannels,
+                                          chunkStart,
+                                          mDescriptorsBuffer.getWritePointer(0),
+                                          chunkSize,
+                                          analysisGain);
+            } else {
+                juce::FloatVectorOperations::copyWithMultiply(mDescriptorsBuffer.getWritePointer(0),
+                                                              buffer.getReadPointer(mChannelToAnalyse - 1, chunkStart),
+                                                              analysisGain,
+                                                              chunkSize);
             }
 
-            mLoudnessMat.fill(0.0);
-            std::fill(mPaddedLoudness.begin(), mPaddedLoudness.end(), 0);
-            // Note: this and the other intsances of padding do not pad with a symmetric amount of zeroes. Maybe this is
-            // fine ?
-            std::copy(mInLoudness.begin(), mInLoudness.end(), mPaddedLoudness.begin() + mLoudness.HALF_WINDOW);
-            std::fill(mLoudnessDesc.begin(), mLoudnessDesc.end(), 0); // necessary?
-            for (int i{}; i < mNFramesLoudness; i++) {
-                fluid::RealVectorView windowLoudness = mLoudness.calculateWindow(mPaddedLoudness, i);
-                mLoudness.loudnessProcess(windowLoudness, mLoudnessDesc);
-                mLoudnessMat.row(i) <<= mLoudnessDesc;
+            if (isAudioAnalysisAsync) {
+                // The descriptors are analysed by the worker thread. The spatial parameters use its latest results,
+                // which are late by the amount reported by getAudioAnalysisLatencyMs().
+                mAudioAnalysisWorker.pushSamples(mDescriptorsBuffer.getReadPointer(0), chunkSize);
+            } else {
+                analyseAudioDescriptors(mDescriptorsBuffer, chunkSize, mAudioDescriptorSnapshot);
+                mHasAudioDescriptorSnapshot = true;
             }
+        }
+        if (isAudioAnalysisAsync && mAudioAnalysisWorker.pullSnapshot(mAudioDescriptorSnapshot)) {
+            mHasAudioDescriptorSnapshot = true;
+        }
 
-            mLoudness.process(mLoudnessMat, *mStats.getStats());
-            double loudnessValue = mLoudness.getValue();
-            loudnessValue = juce::Decibels::decibelsToGain(loudnessValue);
+        if (mHasAudioDescriptorSnapshot) {
+            applyAudioDescriptorSnapshot(mAudioDescriptorSnapshot, buffer.getNumSamples());
+        }
+        processParameterValues();
 
-            if (mSpatMode == SpatMode::dome) {
-                for (int i{}; i < mSpatParametersDomeRefs.size(); ++i) {
-                    if (mSpatParametersDomeRefs[i]->shouldProcessLoudnessAnalysis()) {
-                        mSpatParametersDomeRefs[i]->process(mLoudness.getID(), loudnessValue);
-                        *mSpatParametersDomeValueRefs[i] = mSpatParametersDomeRefs[i]->getDiffValue();
-                    }
-                }
-            } else {
-                for (int i{}; i < mSpatParametersCubeRefs.size(); ++i) {
-                    if (mSpatParametersCubeRefs[i]->shouldProcessLoudnessAnalysis()) {
-                        mSpatParametersCubeRefs[i]->process(mLoudness.getID(), loudnessValue);
-                        *mSpatParametersCubeValueRefs[i] = mSpatParametersCubeRefs[i]->getDiffValue();
-                    }
-                }
-            }
+        if (mHasAudioDescriptorSnapshot) {
+            publishTelemetry(mAudioDescriptorSnapshot);
+        }
+    }
+
+    if (mSelectedSoundTrajectoriesTabIdx == 0 && isPerSourceAnalysisOn()) {
+        juce::ScopedNoDenormals noDenormals;
+        processPerSourceAnalysis(buffer);
+    }
+
+    mNumProcessedSamples += static_cast<juce::uint64>(buffer.getNumSamples());
+}
+
+//==============================================================================
+void ControlGrisAudioProcessor::analyseAudioDescriptors(juce::AudioBuffer<float> & descriptorsBuffer,
+                                                        int numSamples,
+                                                        AudioDescriptorSnapshot & snapshot)
+{
+    jassert(numSamples <= descriptorsBuffer.getNumSamples() && numSamples <= mAnalysisSignal.size());
+    numSamples = std::min({ numSamples, descriptorsBuffer.getNumSamples(), static_cast<int>(mAnalysisSignal.size()) });
+    auto bufferMagnitude = descriptorsBuffer.getMagnitude(0, numSamples);
+
+    // The only float to double conversion of the analysis chain.
+    auto * channelData = descriptorsBuffer.getReadPointer(0);
+    auto * analysisSignal = mAnalysisSignal.data();
+    for (int i{}; i < numSamples; ++i) {
+        analysisSignal[i] = static_cast<double>(channelData[i]);
+    }
+
+    // A descriptor whose resources have not been handed over yet keeps its last value.
+    AnalysisResources::ScopedAnalysis const analysis{ mAnalysisResources };
+    auto const isUsable = [this](AnalysisResource const resource) { return mAnalysisResources.isUsable(resource); };
+    auto const activeDescriptors{ mActiveDescriptors.load(std::memory_order_relaxed) };
+    auto const isActive = [activeDescriptors](DescriptorID const descID) {
+        return DescriptorRoutingTable::isInMask(activeDescriptors, descID);
+    };
+    auto const shouldProcessLoudness{ isActive(DescriptorID::loudness) && isUsable(AnalysisResource::loudness) };
+    auto const shouldProcessPitch{ isActive(DescriptorID::pitch) && isUsable(AnalysisResource::spectralFrames)
+                                   && isUsable(AnalysisResource::pitch) };
+    auto const shouldProcessSpectral{ (isActive(DescriptorID::centroid) || isActive(DescriptorID::spread)
+                                       || isActive(DescriptorID::noise))
+                                      && isUsable(AnalysisResource::spectralFrames)
+                                      && isUsable(AnalysisResource::shape) };
+    auto const shouldProcessSpectralFeatures{ (isActive(DescriptorID::flux) || isActive(DescriptorID::rolloff)
+                                               || isActive(DescriptorID::crest) || isActive(DescriptorID::lowBandEnergy)
+                                               || isActive(DescriptorID::midBandEnergy)
+                                               || isActive(DescriptorID::highBandEnergy))
+                                              && isUsable(AnalysisResource::spectralFrames)
+                                              && isUsable(AnalysisResource::spectralFeatures) };
+
+    // Each spectral descriptor runs at its own control rate, within the CPU budget of the block. When a descriptor does
+    // not run, its last value is kept so the spatial parameters keep smoothing towards it.
+    mDescriptorScheduler.setActive(ScheduledDescriptor::pitch, shouldProcessPitch);
+    mDescriptorScheduler.setActive(ScheduledDescriptor::shape, shouldProcessSpectral || shouldProcessSpectralFeatures);
+    mDescriptorScheduler.beginBlock(numSamples);
+
+    // The loudness meter is streaming: it has to see every sample, so it is not scheduled.
+    if (shouldProcessLoudness) {
+        mLoudness.setWindow(mLoudnessWindow.load(std::memory_order_relaxed));
+        mLoudness.process(analysisSignal, numSamples);
+        snapshot.loudness = juce::Decibels::decibelsToGain(mLoudness.getValue());
+    }
+
+    // Pitch and spectral shape read the same history, each with its own window.
+    if (shouldProcessPitch || shouldProcessSpectral || shouldProcessSpectralFeatures) {
+        mSpectralFrameCache.write(analysisSignal, numSamples);
+    }
+
+    if (shouldProcessPitch) {
+        if (mDescriptorScheduler.shouldRun(ScheduledDescriptor::pitch)) {
+            DescriptorScheduler::ScopedJob const job{ mDescriptorScheduler, ScheduledDescriptor::pitch };
+            updatePitchAnalysisRange();
+            mSpectralFrameCache.analyse(SpectralResolution::pitch);
+            std::fill(mCalculatedPitchDesc.begin(), mCalculatedPitchDesc.end(), 0);
+            mPitch.yinProcess(mSpectralFrameCache.getMagnitude(SpectralResolution::pitch),
+                              mCalculatedPitchDesc,
+                              mSampleRate);
+            mPitchMat.row(0) <<= mCalculatedPitchDesc;
+            mPitch.process(mPitchMat, mStats);
         }
+        snapshot.pitch = mParamFunctions.frequencyToMidiNoteNumber(mPitch.getValue());
+    }
 
-        if (shouldProcessDomePitchAnalysis() || shouldProcessCubePitchAnalysis()) {
-            for (int i{}; i < mDescriptorsBuffer.getNumSamples(); ++i) {
-                mInPitch[i] = channelData[i];
+    if (shouldProcessSpectral || shouldProcessSpectralFeatures) {
+        if (mDescriptorScheduler.shouldRun(ScheduledDescriptor::shape)) {
+            DescriptorScheduler::ScopedJob const job{ mDescriptorScheduler, ScheduledDescriptor::shape };
+            mSpectralFrameCache.analyse(SpectralResolution::shape);
+            if (shouldProcessSpectral) {
+                std::fill(mCalculatedShapeDesc.begin(), mCalculatedShapeDesc.end(), 0);
+                mShape.shapeProcess(mSpectralFrameCache.getMagnitude(SpectralResolution::shape),
+                                    mCalculatedShapeDesc,
+                                    mSampleRate);
+                mShapeMat.row(0) <<= mCalculatedShapeDesc;
+                mShape.process(mShapeMat, mStats, mShapeStats);
+            }
+            // The spectral features only add a linear scan of the spectrum computed for the shape.
+            if (shouldProcessSpectralFeatures) {
+                mSpectralFeatures.process(mSpectralFrameCache.getMagnitude(SpectralResolution::shape), mSampleRate);
             }
+        }
 
-            mPitchMat.fill(0.0);
-            std::fill(mPaddedPitch.begin(), mPaddedPitch.end(), 0);
-            std::copy(mInPitch.begin(), mInPitch.end(), mPaddedPitch.begin() + mPitch.HALF_WINDOW);
+        if (shouldProcessSpectralFeatures) {
+            snapshot.flux = mSpectralFeatures.getValue(DescriptorID::flux);
+            snapshot.rolloff = mSpectralFeatures.getValue(DescriptorID::rolloff);
+            snapshot.crest = mSpectralFeatures.getValue(DescriptorID::crest);
+            snapshot.lowBandEnergy = mSpectralFeatures.getValue(DescriptorID::lowBandEnergy);
+            snapshot.midBandEnergy = mSpectralFeatures.getValue(DescriptorID::midBandEnergy);
+            snapshot.highBandEnergy = mSpectralFeatures.getValue(DescriptorID::highBandEnergy);
+        }
 
-            for (int i{}; i < mNFramesPitch; i++) {
-                std::fill(mCalculatedPitchDesc.begin(), mCalculatedPitchDesc.end(), 0);
-                fluid::RealVectorView windowPitch = mPitch.calculateWindow(mPaddedPitch, i);
-                windowPitch = mPitch.calculateWindow(mPaddedPitch, i);
+        if (shouldProcessSpectral && isActive(DescriptorID::centroid)) {
+            mCentroid.process(mShapeStats);
+            double centroidValue = mCentroid.getValue(); // centroidValue when silence = 118.02870609942256
+            if (bufferMagnitude == 0.0f) {
+                centroidValue = 0.0;
+            }
+            snapshot.centroid = centroidValue;
+        }
 
-                mPitch.stftProcess(windowPitch, mFramePitch);
-                mPitch.stftMagnitude(mFramePitch, mMagnitudePitch);
-                mPitch.yinProcess(mMagnitudePitch, mCalculatedPitchDesc, mSampleRate);
-                mPitchMat.row(i) <<= mCalculatedPitchDesc;
+        if (shouldProcessSpectral && isActive(DescriptorID::spread)) {
+            mSpread.process(mShapeStats);
+            double spreadValue = mSpread.getValue(); // spreadValue when silence  = 16.520351353896057
+            if (bufferMagnitude == 0.0f) {
+                spreadValue = 0.0;
             }
+            snapshot.spread = mParamFunctions.zmap(spreadValue, 0.0, 16.0);
+        }
 
-            mPitch.process(mPitchMat, *mStats.getStats());
-            double pitchValue = mPitch.getValue();
-            pitchValue = mParamFunctions.frequencyToMidiNoteNumber(pitchValue);
+        if (shouldProcessSpectral && isActive(DescriptorID::noise)) {
+            mFlatness.process(mShapeStats);
+            double flatnessValue = mFlatness.getValue(); // flatnessValue when silence = -6.9624443085150120e-13
+            if (bufferMagnitude == 0.0f) {
+                flatnessValue = -160.0;
+            }
+            flatnessValue = juce::Decibels::decibelsToGain(flatnessValue);
+            flatnessValue = mParamFunctions.zmap(flatnessValue, 0.0, 0.5);
+            snapshot.flatness = mParamFunctions.power(flatnessValue);
+        }
+    }
 
-            if (mSpatMode == SpatMode::dome) {
-                for (int i{}; i < mSpatParametersDomeRefs.size(); ++i) {
-                    if (mSpatParametersDomeRefs[i]->shouldProcessPitchAnalysis()) {
-                        mSpatParametersDomeRefs[i]->process(mPitch.getID(), pitchValue);
-                        *mSpatParametersDomeValueRefs[i] = mSpatParametersDomeRefs[i]->getDiffValue();
+    if (isActive(DescriptorID::iterationsSpeed) && isUsable(AnalysisResource::onsetDetection)) {
+        // The onset detection function of each metric in use is computed once and shared by every spatial parameter.
+        auto const onsetDetectionParameters{ mOnsetDetectionParameters.load(std::memory_order_relaxed) };
+        auto const forEachOnsetDetection = [this, onsetDetectionParameters](auto && callback) {
+            auto const forEachActive = [onsetDetectionParameters, &callback](auto const & onsetDetectionRefs) {
+                for (size_t i{}; i < onsetDetectionRefs.size(); ++i) {
+                    if ((onsetDetectionParameters & (1u << i)) != 0) {
+                        callback(*onsetDetectionRefs[i], i);
                     }
                 }
+            };
+            if (mSpatMode == SpatMode::dome) {
+                forEachActive(mDomeOnsetDetectionRefs);
             } else {
-                for (int i{}; i < mSpatParametersCubeRefs.size(); ++i) {
-                    if (mSpatParametersCubeRefs[i]->shouldProcessPitchAnalysis()) {
-                        mSpatParametersCubeRefs[i]->process(mPitch.getID(), pitchValue);
-                        *mSpatParametersCubeValueRefs[i] = mSpatParametersCubeRefs[i]->getDiffValue();
-                    }
-                }
+                forEachActive(mCubeOnsetDetectionRefs);
             }
+        };
+
+        mOnsetDetectionFunctionCache.clearSubscriptions();
+        forEachOnsetDetection([this](OnsetDetectionD const & onsetDetection, size_t) {
+            mOnsetDetectionFunctionCache.setSubscribed(onsetDetection.getOnsetDetectionMetric(), true);
+        });
+        mOnsetDetectionFunctionCache.push(analysisSignal, numSamples);
+        forEachOnsetDetection([this, &snapshot, numSamples](OnsetDetectionD & onsetDetection, size_t index) {
+            onsetDetection.process(mOnsetDetectionFunctionCache, mSampleRate, numSamples);
+            snapshot.onsetDetection[index] = onsetDetection.getValue();
+        });
+    }
+}
+
+//==============================================================================
+void ControlGrisAudioProcessor::updatePitchAnalysisRange()
+{
+    // The range is computed by updateAudioAnalysisRouting(), the settings it reads belonging to the message thread.
+    auto const minFreq{ mPitchAnalysisMinFreq.load(std::memory_order_relaxed) };
+    auto const maxFreq{ mPitchAnalysisMaxFreq.load(std::memory_order_relaxed) };
+    if (maxFreq <= 0.0) {
+        return;
+    }
+
+    mPitch.setFrequencyRange(minFreq, maxFreq);
+    mSpectralFrameCache.setPitchWindowSize(PitchD::getWindowSize(minFreq, mSampleRate));
+}
+
+//==============================================================================
+void ControlGrisAudioProcessor::applyAudioDescriptorSnapshot(AudioDescriptorSnapshot const & snapshot,
+                                                             int const numSamples)
+{
+    // The spatial parameters pick up their latest settings and their smoothers advance by the duration of the block,
+    // whatever its size.
+    for (auto * spatParam : mSpatParametersDomeRefs) {
+        spatParam->beginBlock(numSamples);
+    }
+    for (auto * spatParam : mSpatParametersCubeRefs) {
+        spatParam->beginBlock(numSamples);
+    }
+
+    mDescriptorRouting.update();
+    auto const & routing{ mDescriptorRouting.getReadBuffer() };
+
+    auto const applyToSpatialParameters = [&routing](DescriptorID const descID, auto && getValue) {
+        routing.forEachRoute(descID, [&getValue, descID](DescriptorRoute const & route) {
+            route.parameter->process(descID, getValue(route));
+            *route.diffValue = route.parameter->getDiffValue();
+        });
+    };
+
+    applyToSpatialParameters(DescriptorID::loudness,
+                             [&snapshot](DescriptorRoute const &) { return snapshot.loudness; });
+    applyToSpatialParameters(DescriptorID::pitch, [&snapshot](DescriptorRoute const &) { return snapshot.pitch; });
+    applyToSpatialParameters(DescriptorID::centroid,
+                             [&snapshot](DescriptorRoute const &) { return snapshot.centroid; });
+    applyToSpatialParameters(DescriptorID::spread, [&snapshot](DescriptorRoute const &) { return snapshot.spread; });
+    applyToSpatialParameters(DescriptorID::noise, [&snapshot](DescriptorRoute const &) { return snapshot.flatness; });
+    applyToSpatialParameters(DescriptorID::flux, [&snapshot](DescriptorRoute const &) { return snapshot.flux; });
+    applyToSpatialParameters(DescriptorID::rolloff, [&snapshot](DescriptorRoute const &) { return snapshot.rolloff; });
+    applyToSpatialParameters(DescriptorID::crest, [&snapshot](DescriptorRoute const &) { return snapshot.crest; });
+    applyToSpatialParameters(DescriptorID::lowBandEnergy,
+                             [&snapshot](DescriptorRoute const &) { return snapshot.lowBandEnergy; });
+    applyToSpatialParameters(DescriptorID::midBandEnergy,
+                             [&snapshot](DescriptorRoute const &) { return snapshot.midBandEnergy; });
+    applyToSpatialParameters(DescriptorID::highBandEnergy,
+                             [&snapshot](DescriptorRoute const &) { return snapshot.highBandEnergy; });
+    applyToSpatialParameters(DescriptorID::iterationsSpeed, [&snapshot](DescriptorRoute const & route) {
+        return snapshot.onsetDetection[route.parameterIndex];
+    });
+}
+
+//==============================================================================
+void ControlGrisAudioProcessor::publishTelemetry(AudioDescriptorSnapshot const & snapshot) noexcept
+{
+    auto const publish = [this](TelemetrySignal const signal, double const value) {
+        mTelemetryBus.publish(signal, static_cast<float>(value), mNumProcessedSamples);
+    };
+
+    publish(TelemetrySignal::loudness, snapshot.loudness);
+    publish(TelemetrySignal::pitch, snapshot.pitch);
+    publish(TelemetrySignal::centroid, snapshot.centroid);
+    publish(TelemetrySignal::spread, snapshot.spread);
+    publish(TelemetrySignal::flatness, snapshot.flatness);
+    publish(TelemetrySignal::flux, snapshot.flux);
+    publish(TelemetrySignal::rolloff, snapshot.rolloff);
+    publish(TelemetrySignal::crest, snapshot.crest);
+    publish(TelemetrySignal::lowBandEnergy, snapshot.lowBandEnergy);
+    publish(TelemetrySignal::midBandEnergy, snapshot.midBandEnergy);
+    publish(TelemetrySignal::highBandEnergy, snapshot.highBandEnergy);
+
+    if (mSpatMode == SpatMode::dome) {
+        for (auto * spatParam : mSpatParametersDomeRefs) {
+            publish(toTelemetrySignal(spatParam->getParameterID()), spatParam->getValue());
+        }
+    } else {
+        for (auto * spatParam : mSpatParametersCubeRefs) {
+            publish(toTelemetrySignal(spatParam->getParameterID()), spatParam->getValue());
         }
+    }
+}
 
-        if (shouldProcessDomeSpectralAnalysis() || shouldProcessCubeSpectralAnalysis()) {
-            for (int i{}; i < mDescriptorsBuffer.getNumSamples(); ++i) {
-                mInSpectral[i] = channelData[i];
-            }
+//==============================================================================
+juce::uint32 ControlGrisAudioProcessor::getRequiredAnalysisResources() const
+{
+    return mShouldProcessAudioAnalysis
+               ? AnalysisResources::getRequiredResources(mActiveDescriptors.load(std::memory_order_relaxed))
+               : 0u;
+}
 
-            mShapeMat.fill(0.0);
-            std::fill(mPaddedSpectral.begin(), mPaddedSpectral.end(), 0);
-            std::copy(mInSpectral.begin(), mInSpectral.end(), mPaddedSpectral.begin() + mShape.HALF_WINDOW);
+//==============================================================================
+void ControlGrisAudioProcessor::allocateAnalysisResource(AnalysisResource const resource)
+{
+    switch (resource) {
+    case AnalysisResource::loudness:
+        mLoudness.reset();
+        mLoudness.init(mSampleRate);
+        break;
+    case AnalysisResource::spectralFrames:
+        mSpectralFrameCache.reset();
+        break;
+    case AnalysisResource::pitch:
+        mPitch.reset();
+        mPitch.init();
+        break;
+    case AnalysisResource::shape:
+        mShape.reset();
+        mCentroid.reset();
+        mSpread.reset();
+        mFlatness.reset();
+        mCentroid.init();
+        mSpread.init();
+        mFlatness.init();
+        break;
+    case AnalysisResource::spectralFeatures:
+        mSpectralFeatures.reset(ShapeD::NBINS);
+        break;
+    case AnalysisResource::onsetDetection:
+        mOnsetDetectionFunctionCache.reset(mBlockSize);
+        break;
+    case AnalysisResource::count:
+    default:
+        jassertfalse;
+        break;
+    }
+}
 
-            for (int i{}; i < mNFramesSpectral; i++) {
-                std::fill(mCalculatedShapeDesc.begin(), mCalculatedShapeDesc.end(), 0);
-                fluid::RealVectorView windowSpectral = mShape.calculateWindow(mPaddedSpectral, i);
-                mShape.stftProcess(windowSpectral, nFrameSpectral);
-                mShape.stftMagnitude(nFrameSpectral, mMagnitudeSpectral);
-                mShape.shapeProcess(mMagnitudeSpectral, mCalculatedShapeDesc, mSampleRate);
-                mShapeMat.row(i) <<= mCalculatedShapeDesc;
-            }
+//==============================================================================
+void ControlGrisAudioProcessor::releaseAnalysisResource(AnalysisResource const resource)
+{
+    switch (resource) {
+    case AnalysisResource::loudness:
+        mLoudness.release();
+        break;
+    case AnalysisResource::spectralFrames:
+        mSpectralFrameCache.release();
+        break;
+    case AnalysisResource::pitch:
+        mPitch.release();
+        break;
+    case AnalysisResource::shape:
+        mShape.release();
+        break;
+    case AnalysisResource::spectralFeatures:
+        mSpectralFeatures.release();
+        break;
+    case AnalysisResource::onsetDetection:
+        mOnsetDetectionFunctionCache.release();
+        break;
+    case AnalysisResource::count:
+    default:
+        jassertfalse;
+        break;
+    }
+}
 
-            mShapeStats = mShape.process(mShapeMat, *mStats.getStats());
+//==============================================================================
+void ControlGrisAudioProcessor::setTrajectoryControlPeriodMs(double periodMs)
+{
+    mAudioProcessorValueTreeState.state.setProperty("trajectoryControlPeriodMs", periodMs, nullptr);
+    mTrajectoryClock.setControlPeriodMs(periodMs);
+}
 
-            if (shouldProcessDomeCentroidAnalysis() || shouldProcessCubeCentroidAnalysis()) {
-                mCentroid.process(mShapeStats);
-                double centroidValue = mCentroid.getValue(); // centroidValue when silence = 118.02870609942256
-                if (bufferMagnitude == 0.0f) {
-                    centroidValue = 0.0;
-                }
-                if (mSpatMode == SpatMode::dome) {
-                    for (int i{}; i < mSpatParametersDomeRefs.size(); ++i) {
-                        if (mSpatParametersDomeRefs[i]->shouldProcessCentroidAnalysis()) {
-                            mSpatParametersDomeRefs[i]->process(mCentroid.getID(), centroidValue);
-                            *mSpatParametersDomeValueRefs[i] = mSpatParametersDomeRefs[i]->getDiffValue();
-                        }
-                    }
-                } else {
-                    for (int i{}; i < mSpatParametersCubeRefs.size(); ++i) {
-                        if (mSpatParametersCubeRefs[i]->shouldProcessCentroidAnalysis()) {
-                            mSpatParametersCubeRefs[i]->process(mCentroid.getID(), centroidValue);
-                            *mSpatParametersCubeValueRefs[i] = mSpatParametersCubeRefs[i]->getDiffValue();
-                        }
-                    }
-                }
-            }
+//==============================================================================
+void ControlGrisAudioProcessor::setPositionTrajectoryConstantSpeed(bool shouldBeConstantSpeed)
+{
+    mAudioProcessorValueTreeState.state.setProperty("positionTrajectoryConstantSpeed", shouldBeConstantSpeed, nullptr);
+    mPositionTrajectoryManager.setConstantSpeed(shouldBeConstantSpeed);
+}
 
-            if (shouldProcessDomeSpreadAnalysis() || shouldProcessCubeSpreadAnalysis()) {
-                mSpread.process(mShapeStats);
-                double spreadValue = mSpread.getValue(); // spreadValue when silence  = 16.520351353896057
-                if (bufferMagnitude == 0.0f) {
-                    spreadValue = 0.0;
-                }
-                spreadValue = mParamFunctions.zmap(spreadValue, 0.0, 16.0);
-
-                if (mSpatMode == SpatMode::dome) {
-                    for (int i{}; i < mSpatParametersDomeRefs.size(); ++i) {
-                        if (mSpatParametersDomeRefs[i]->shouldProcessSpreadAnalysis()) {
-                            mSpatParametersDomeRefs[i]->process(mSpread.getID(), spreadValue);
-                            *mSpatParametersDomeValueRefs[i] = mSpatParametersDomeRefs[i]->getDiffValue();
-                        }
-                    }
-                } else {
-                    for (int i{}; i < mSpatParametersCubeRefs.size(); ++i) {
-                        if (mSpatParametersCubeRefs[i]->shouldProcessSpreadAnalysis()) {
-                            mSpatParametersCubeRefs[i]->process(mSpread.getID(), spreadValue);
-                            *mSpatParametersCubeValueRefs[i] = mSpatParametersCubeRefs[i]->getDiffValue();
-                        }
-                    }
-                }
-            }
+//==============================================================================
+void ControlGrisAudioProcessor::setTrajectoryDrawingTolerance(double tolerance)
+{
+    mAudioProcessorValueTreeState.state.setProperty("trajectoryDrawingTolerance", tolerance, nullptr);
+    mPositionTrajectoryManager.setRecordingTolerance(static_cast<float>(tolerance));
+    mElevationTrajectoryManager.setRecordingTolerance(static_cast<float>(tolerance));
+}
 
-            if (shouldProcessDomeNoiseAnalysis() || shouldProcessCubeNoiseAnalysis()) {
-                mFlatness.process(mShapeStats);
-                double flatnessValue = mFlatness.getValue(); // flatnessValue when silence = -6.9624443085150120e-13
-                if (bufferMagnitude == 0.0f) {
-                    flatnessValue = -160.0;
-                }
-                flatnessValue = juce::Decibels::decibelsToGain(flatnessValue);
-                flatnessValue = mParamFunctions.zmap(flatnessValue, 0.0, 0.5);
-                flatnessValue = mParamFunctions.power(flatnessValue);
-
-                if (mSpatMode == SpatMode::dome) {
-                    for (int i{}; i < mSpatParametersDomeRefs.size(); ++i) {
-                        if (mSpatParametersDomeRefs[i]->shouldProcessNoiseAnalysis()) {
-                            mSpatParametersDomeRefs[i]->process(mFlatness.getID(), flatnessValue);
-                            *mSpatParametersDomeValueRefs[i] = mSpatParametersDomeRefs[i]->getDiffValue();
-                        }
-                    }
-                } else {
-                    for (int i{}; i < mSpatParametersCubeRefs.size(); ++i) {
-                        if (mSpatParametersCubeRefs[i]->shouldProcessNoiseAnalysis()) {
-                            mSpatParametersCubeRefs[i]->process(mFlatness.getID(), flatnessValue);
-                            *mSpatParametersCubeValueRefs[i] = mSpatParametersCubeRefs[i]->getDiffValue();
-                        }
-                    }
-                }
-            }
+//==============================================================================
+void ControlGrisAudioProcessor::flushSpatialParametersState()
+{
+    // The setters only touch the settings, the state properties are written here at the timer rate.
+    for (auto * spatParam : mSpatParametersDomeRefs) {
+        spatParam->flushParametersState();
+    }
+    for (auto * spatParam : mSpatParametersCubeRefs) {
+        spatParam->flushParametersState();
+    }
+}
+
+//==============================================================================
+void ControlGrisAudioProcessor::drainTelemetry()
+{
+    mTelemetrySums.fill(0.0);
+    mTelemetryCounts.fill(0);
+
+    mTelemetryBus.drain([this](TelemetryEvent const & event) {
+        auto const index{ static_cast<size_t>(event.signal) };
+        mTelemetrySums[index] += static_cast<double>(event.value);
+        ++mTelemetryCounts[index];
+    });
+
+    for (size_t i{}; i < mTelemetryValues.size(); ++i) {
+        if (mTelemetryCounts[i] > 0) {
+            mTelemetryValues[i] = mTelemetrySums[i] / static_cast<double>(mTelemetryCounts[i]);
         }
+    }
+}
 
-        if (shouldProcessDomeOnsetDetectionAnalysis() || shouldProcessCubeOnsetDetectionAnalysis()) {
-            if (mSpatMode == SpatMode::dome) {
-                for (int i{}; i < mSpatParametersDomeRefs.size(); ++i) {
-                    if (mSpatParametersDomeRefs[i]->shouldProcessOnsetDetectionAnalysis()) {
-                        mDomeOnsetDetectionRefs[i]->process(mDescriptorsBuffer, mSampleRate, mBlockSize);
-                        mSpatParametersDomeRefs[i]->process(mDomeOnsetDetectionRefs[i]->getID(),
-                                                            mDomeOnsetDetectionRefs[i]->getValue());
-                        *mSpatParametersDomeValueRefs[i] = mSpatParametersDomeRefs[i]->getDiffValue();
-                    }
-                }
-            } else {
-                for (int i{}; i < mSpatParametersCubeRefs.size(); ++i) {
-                    if (mSpatParametersCubeRefs[i]->shouldProcessOnsetDetectionAnalysis()) {
-                        mCubeOnsetDetectionRefs[i]->process(mDescriptorsBuffer, mSampleRate, mBlockSize);
-                        mSpatParametersCubeRefs[i]->process(mCubeOnsetDetectionRefs[i]->getID(),
-                                                            mCubeOnsetDetectionRefs[i]->getValue());
-                        *mSpatParametersCubeValueRefs[i] = mSpatParametersCubeRefs[i]->getDiffValue();
-                    }
-                }
-            }
+//==============================================================================
+void ControlGrisAudioProcessor::setOscMonitorOn(bool shouldBeOn)
+{
+    mAudioProcessorValueTreeState.state.setProperty("oscDescriptorMonitor", shouldBeOn, nullptr);
+}
+
+//==============================================================================
+bool ControlGrisAudioProcessor::isOscMonitorOn() const
+{
+    return mAudioProcessorValueTreeState.state.getProperty("oscDescriptorMonitor", false);
+}
+
+//==============================================================================
+void ControlGrisAudioProcessor::sendOscMonitorMessage()
+{
+    if (!mOscOutputConnected || !isOscMonitorOn()) {
+        return;
+    }
+
+    // Only the values that changed during the last timer tick are sent, each as the mean of its published values.
+    auto const monitorAddress{ juce::String{ "/controlgris/" } + juce::String{ getOscOutputPluginId() }
+                               + "/monitor/" };
+    for (size_t i{}; i < mTelemetryValues.size(); ++i) {
+        if (mTelemetryCounts[i] == 0) {
+            continue;
         }
-        processParameterValues();
+        juce::OSCMessage message(juce::OSCAddressPattern(
+            monitorAddress + getTelemetrySignalName(static_cast<TelemetrySignal>(i))));
+        message.addFloat32(static_cast<float>(mTelemetryValues[i]));
+        mOscOutputSender.send(message);
     }
 }
 
@@ -1611,6 +1877,7 @@ void ControlGrisAudioProcessor::getStateInformation(juce::MemoryBlock & destData
     }
 
     mAudioProcessorValueTreeState.state.setProperty("soundTrajSelTab", mSelectedSoundTrajectoriesTabIdx, nullptr);
+    flushSpatialParametersState();
 
     auto const state{ mAudioProcessorValueTreeState.copyState() };
 
@@ -1708,7 +1975,30 @@ void ControlGrisAudioProcessor::setStateInformation(void const * data, int const
             setOnsetDetectionMinTime(spatParam->getParameterID(), spatParam->getParamMinTime());
             setOnsetDetectionMaxTime(spatParam->getParameterID(), spatParam->getParamMaxTime());
         }
+        updateAudioAnalysisRouting();
         setXYParamLink(mAudioProcessorValueTreeState.state.getProperty("XYParamLinked"));
+        setAudioAnalysisAsync(mAudioProcessorValueTreeState.state.getProperty("audioAnalysisAsync"));
+        setAudioAnalysisBudgetUs(mAudioProcessorValueTreeState.state.getProperty(
+            "audioAnalysisBudgetUs",
+            DescriptorScheduler::DEFAULT_BUDGET_US));
+        setAudioAnalysisLoudnessWindow(static_cast<LoudnessWindow>(
+            static_cast<int>(mAudioProcessorValueTreeState.state.getProperty("audioAnalysisLoudnessWindow"))));
+        setTrajectoryControlPeriodMs(mAudioProcessorValueTreeState.state.getProperty(
+            "trajectoryControlPeriodMs",
+            TrajectoryClock::DEFAULT_CONTROL_PERIOD_MS));
+        // Sessions saved before drawings could play at a constant speed keep their original timing.
+        setPositionTrajectoryConstantSpeed(
+            mAudioProcessorValueTreeState.state.getProperty("positionTrajectoryConstantSpeed", false));
+        setTrajectoryDrawingTolerance(mAudioProcessorValueTreeState.state.getProperty(
+            "trajectoryDrawingTolerance",
+            TrajectoryManager::DEFAULT_RECORDING_TOLERANCE));
+        mAudioAnalysisMixdown.fromString(
+            mAudioProcessorValueTreeState.state.getProperty("audioAnalysisChannelWeights").toString());
+        setPerSourceAnalysisOn(mAudioProcessorValueTreeState.state.getProperty("audioAnalysisPerSource"));
+        setPerSourceAnalysisDescriptor(static_cast<PerSourceDescriptor>(
+            static_cast<int>(mAudioProcessorValueTreeState.state.getProperty("audioAnalysisPerSourceDescriptor"))));
+        setPerSourceAnalysisTarget(static_cast<PerSourceTarget>(
+            static_cast<int>(mAudioProcessorValueTreeState.state.getProperty("audioAnalysisPerSourceTarget"))));
     }
 
     setSourcePositionsFromState();
@@ -1732,7 +2022,7 @@ void ControlGrisAudioProcessor::sourceChanged(Source & source,
      */
     jassert(changeType == Source::ChangeType::position || changeType == Source::ChangeType::elevation);
 
-    const juce::ScopedTryLock tryLock(mLock);
+    const RealtimeTryLock::ScopedTryLock tryLock(mLock);
     if (tryLock.isLocked()) {
         auto & trajectoryManager{ changeType == Source::ChangeType::position
                                       ? static_cast<TrajectoryManager &>(mPositionTrajectoryManager)
@@ -1804,6 +2094,9 @@ void ControlGrisAudioProcessor::sourceChanged(Source & source,
             sourceLinkEnforcer.sourceMoved(source);
             updatePrimarySourceParameters(changeType);
             return;
+        case Source::OriginOfChange::audioAnalysisPerSource:
+            // Every source follows its own input channel, the link would only fight the analysis.
+            return;
         }
         jassertfalse;
     }
@@ -1863,7 +2156,7 @@ void ControlGrisAudioProcessor::setChannelForAudioAnalysis(int channel)
 void ControlGrisAudioProcessor::setSelectedSoundTrajectoriesTab(int newCurrentTabIndex)
 {
     mSelectedSoundTrajectoriesTabIdx = newCurrentTabIndex;
-    setShouldProcessAudioAnalysis();
+    updateAudioAnalysisRouting();
 }
 
 //==============================================================================
@@ -2058,6 +2351,118 @@ void ControlGrisAudioProcessor::setAudioAnalysisState(bool state)
     }
 }
 
+//==============================================================================
+void ControlGrisAudioProcessor::setAudioAnalysisAsync(bool shouldBeAsync)
+{
+    mAudioProcessorValueTreeState.state.setProperty("audioAnalysisAsync", shouldBeAsync, nullptr);
+
+    if (shouldBeAsync == isAudioAnalysisAsync()) {
+        return;
+    }
+
+    // The descriptors must never be analysed by both threads at once. The worker only starts analysing samples pushed
+    // after the switch, and it is stopped before the audio thread goes back to analysing them itself.
+    if (shouldBeAsync) {
+        mAudioAnalysisWorker.start();
+        mAudioAnalysisAsync.store(true, std::memory_order_release);
+    } else {
+        mAudioAnalysisWorker.stop();
+        mAudioAnalysisAsync.store(false, std::memory_order_release);
+    }
+}
+
+//==============================================================================
+double ControlGrisAudioProcessor::getAudioAnalysisLatencyMs() const
+{
+    return isAudioAnalysisAsync() ? mAudioAnalysisWorker.getLatencyMs() : 0.0;
+}
+
+//==============================================================================
+void ControlGrisAudioProcessor::setAudioAnalysisChannelWeight(int channel, float weight)
+{
+    mAudioAnalysisMixdown.setChannelWeight(channel, weight);
+    mAudioProcessorValueTreeState.state.setProperty("audioAnalysisChannelWeights",
+                                                    mAudioAnalysisMixdown.toString(),
+                                                    nullptr);
+}
+
+//==============================================================================
+void ControlGrisAudioProcessor::setAudioAnalysisChannelEnabled(int channel, bool shouldBeEnabled)
+{
+    mAudioAnalysisMixdown.setChannelEnabled(channel, shouldBeEnabled);
+    mAudioProcessorValueTreeState.state.setProperty("audioAnalysisChannelWeights",
+                                                    mAudioAnalysisMixdown.toString(),
+                                                    nullptr);
+}
+
+//==============================================================================
+void ControlGrisAudioProcessor::setPerSourceAnalysisOn(bool shouldBeOn)
+{
+    mAudioProcessorValueTreeState.state.setProperty("audioAnalysisPerSource", shouldBeOn, nullptr);
+    mPerSourceAnalysisOn.store(shouldBeOn, std::memory_order_relaxed);
+}
+
+//==============================================================================
+void ControlGrisAudioProcessor::setPerSourceAnalysisDescriptor(PerSourceDescriptor descriptor)
+{
+    mAudioProcessorValueTreeState.state.setProperty("audioAnalysisPerSourceDescriptor",
+                                                    static_cast<int>(descriptor),
+                                                    nullptr);
+    mMultiChannelAnalysis.setDescriptor(descriptor);
+}
+
+//==============================================================================
+void ControlGrisAudioProcessor::setAudioAnalysisBudgetUs(double budgetUs)
+{
+    mDescriptorScheduler.setBudgetUs(budgetUs);
+    mAudioProcessorValueTreeState.state.setProperty("audioAnalysisBudgetUs", getAudioAnalysisBudgetUs(), nullptr);
+}
+
+//==============================================================================
+void ControlGrisAudioProcessor::setAudioAnalysisLoudnessWindow(LoudnessWindow window)
+{
+    mAudioProcessorValueTreeState.state.setProperty("audioAnalysisLoudnessWindow", static_cast<int>(window), nullptr);
+    mLoudnessWindow.store(window, std::memory_order_relaxed);
+}
+
+//==============================================================================
+void ControlGrisAudioProcessor::setPerSourceAnalysisTarget(PerSourceTarget target)
+{
+    mAudioProcessorValueTreeState.state.setProperty("audioAnalysisPerSourceTarget", static_cast<int>(target), nullptr);
+    mPerSourceAnalysisTarget.store(target, std::memory_order_relaxed);
+}
+
+//==============================================================================
+void ControlGrisAudioProcessor::processPerSourceAnalysis(juce::AudioBuffer<float> const & buffer)
+{
+    // Input channel i drives source i. The sources past the last input channel are left alone. While the spatial
+    // parameters are driven by the main analysis, the primary source follows them and its channel is only analysed.
+    auto const numChannels{ std::min(getTotalNumInputChannels(), mSources.size()) };
+    mMultiChannelAnalysis.process(buffer, numChannels, static_cast<float>(mAudioAnalysisInputGainMultiplier));
+
+    auto const target{ mPerSourceAnalysisTarget.load(std::memory_order_relaxed) };
+    auto const firstSource{ mShouldProcessAudioAnalysis ? 1 : 0 };
+    for (int i{ firstSource }; i < numChannels; ++i) {
+        auto & source{ mSources[i] };
+        auto const value{ static_cast<float>(mMultiChannelAnalysis.getNormalizedValue(i)) };
+        switch (target) {
+        case PerSourceTarget::elevation:
+            // The louder or brighter the channel, the higher its source.
+            source.setElevation(Normalized{ 1.0f - value }, Source::OriginOfChange::audioAnalysisPerSource);
+            break;
+        case PerSourceTarget::azimuthSpan:
+            source.setAzimuthSpan(Normalized{ value });
+            break;
+        case PerSourceTarget::elevationSpan:
+            source.setElevationSpan(Normalized{ value });
+            break;
+        case PerSourceTarget::azimuth:
+            source.setAzimuth(Normalized{ value }, Source::OriginOfChange::audioAnalysisPerSource);
+            break;
+        }
+    }
+}
+
 //==============================================================================
 AzimuthDome & ControlGrisAudioProcessor::getAzimuthDome()
 {
@@ -2275,199 +2680,75 @@ void ControlGrisAudioProcessor::setOnsetDetectionFromClick(ParameterID paramID,
 }
 
 //==============================================================================
-void ControlGrisAudioProcessor::setShouldProcessAudioAnalysis()
-{
-    mShouldProcessAudioAnalysis
-        = mSelectedSoundTrajectoriesTabIdx == 0
-          && (shouldProcessDomeSpectralAnalysis() || shouldProcessDomeLoudnessAnalysis()
-              || shouldProcessDomePitchAnalysis() || shouldProcessDomeCentroidAnalysis()
-              || shouldProcessDomeSpreadAnalysis() || shouldProcessDomeNoiseAnalysis()
-              || shouldProcessDomeOnsetDetectionAnalysis() || shouldProcessCubeSpectralAnalysis()
-              || shouldProcessCubeLoudnessAnalysis() || shouldProcessCubePitchAnalysis()
-              || shouldProcessCubeCentroidAnalysis() || shouldProcessCubeSpreadAnalysis()
-              || shouldProcessCubeNoiseAnalysis() || shouldProcessCubeOnsetDetectionAnalysis());
-}
-
-//==============================================================================
-bool ControlGrisAudioProcessor::shouldProcessDomeSpectralAnalysis()
-{
-    if (mSpatMode == SpatMode::dome) {
-        for (const auto & spatParam : mSpatParametersDomeRefs) {
-            if (spatParam->needsSpectralAnalysis()) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
-//==============================================================================
-bool ControlGrisAudioProcessor::shouldProcessDomeLoudnessAnalysis()
-{
-    if (mSpatMode == SpatMode::dome) {
-        for (const auto & spatParam : mSpatParametersDomeRefs) {
-            if (spatParam->shouldProcessLoudnessAnalysis()) {
-                return true;
+void ControlGrisAudioProcessor::updateAudioAnalysisRouting()
+{
+    auto & routing{ mDescriptorRouting.getWriteBuffer() };
+    routing.clear();
+
+    auto const addRoutes = [&routing](auto const & spatParametersRefs, auto const & spatParametersValueRefs) {
+        for (size_t i{}; i < spatParametersRefs.size(); ++i) {
+            auto * spatParam{ spatParametersRefs[i] };
+            auto const descID{ spatParam->getDescriptorToUse() };
+            auto isActive{ false };
+            switch (descID) {
+            case DescriptorID::loudness:
+                isActive = spatParam->shouldProcessLoudnessAnalysis();
+                break;
+            case DescriptorID::pitch:
+                isActive = spatParam->shouldProcessPitchAnalysis();
+                break;
+            case DescriptorID::centroid:
+                isActive = spatParam->shouldProcessCentroidAnalysis();
+                break;
+            case DescriptorID::spread:
+                isActive = spatParam->shouldProcessSpreadAnalysis();
+                break;
+            case DescriptorID::noise:
+                isActive = spatParam->shouldProcessNoiseAnalysis();
+                break;
+            case DescriptorID::flux:
+            case DescriptorID::rolloff:
+            case DescriptorID::crest:
+            case DescriptorID::lowBandEnergy:
+            case DescriptorID::midBandEnergy:
+            case DescriptorID::highBandEnergy:
+                isActive = spatParam->shouldProcessSpectralFeatureAnalysis();
+                break;
+            case DescriptorID::iterationsSpeed:
+                isActive = spatParam->shouldProcessOnsetDetectionAnalysis();
+                break;
+            case DescriptorID::invalid:
+            default:
+                break;
             }
-        }
-    }
-    return false;
-}
-
-//==============================================================================
-bool ControlGrisAudioProcessor::shouldProcessDomePitchAnalysis()
-{
-    if (mSpatMode == SpatMode::dome) {
-        for (const auto & spatParam : mSpatParametersDomeRefs) {
-            if (spatParam->shouldProcessPitchAnalysis()) {
-                return true;
+            if (isActive) {
+                routing.addRoute(descID, DescriptorRoute{ spatParam, spatParametersValueRefs[i], i });
             }
         }
-    }
-    return false;
-}
+    };
 
-//==============================================================================
-bool ControlGrisAudioProcessor::shouldProcessDomeCentroidAnalysis()
-{
     if (mSpatMode == SpatMode::dome) {
-        for (const auto & spatParam : mSpatParametersDomeRefs) {
-            if (spatParam->shouldProcessCentroidAnalysis()) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
-//==============================================================================
-bool ControlGrisAudioProcessor::shouldProcessDomeSpreadAnalysis()
-{
-    if (mSpatMode == SpatMode::dome) {
-        for (const auto & spatParam : mSpatParametersDomeRefs) {
-            if (spatParam->shouldProcessSpreadAnalysis()) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
-//==============================================================================
-bool ControlGrisAudioProcessor::shouldProcessDomeNoiseAnalysis()
-{
-    if (mSpatMode == SpatMode::dome) {
-        for (const auto & spatParam : mSpatParametersDomeRefs) {
-            if (spatParam->shouldProcessNoiseAnalysis()) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
-//==============================================================================
-bool ControlGrisAudioProcessor::shouldProcessDomeOnsetDetectionAnalysis()
-{
-    if (mSpatMode == SpatMode::dome) {
-        for (const auto & spatParam : mSpatParametersDomeRefs) {
-            if (spatParam->shouldProcessOnsetDetectionAnalysis()) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
-//==============================================================================
-bool ControlGrisAudioProcessor::shouldProcessCubeSpectralAnalysis()
-{
-    if (mSpatMode == SpatMode::cube) {
-        for (const auto & spatParam : mSpatParametersCubeRefs) {
-            if (spatParam->needsSpectralAnalysis()) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
-//==============================================================================
-bool ControlGrisAudioProcessor::shouldProcessCubeLoudnessAnalysis()
-{
-    if (mSpatMode == SpatMode::cube) {
-        for (const auto & spatParam : mSpatParametersCubeRefs) {
-            if (spatParam->shouldProcessLoudnessAnalysis()) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
-//==============================================================================
-bool ControlGrisAudioProcessor::shouldProcessCubePitchAnalysis()
-{
-    if (mSpatMode == SpatMode::cube) {
-        for (const auto & spatParam : mSpatParametersCubeRefs) {
-            if (spatParam->shouldProcessPitchAnalysis()) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
-//==============================================================================
-bool ControlGrisAudioProcessor::shouldProcessCubeCentroidAnalysis()
-{
-    if (mSpatMode == SpatMode::cube) {
-        for (const auto & spatParam : mSpatParametersCubeRefs) {
-            if (spatParam->shouldProcessCentroidAnalysis()) {
-                return true;
-            }
-        }
+        addRoutes(mSpatParametersDomeRefs, mSpatParametersDomeValueRefs);
+    } else {
+        addRoutes(mSpatParametersCubeRefs, mSpatParametersCubeValueRefs);
     }
-    return false;
-}
 
-//==============================================================================
-bool ControlGrisAudioProcessor::shouldProcessCubeSpreadAnalysis()
-{
-    if (mSpatMode == SpatMode::cube) {
-        for (const auto & spatParam : mSpatParametersCubeRefs) {
-            if (spatParam->shouldProcessSpreadAnalysis()) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
+    // The pitch analysis covers the union of the ranges of every spatial parameter following the pitch.
+    auto minFreq{ std::numeric_limits<double>::max() };
+    auto maxFreq{ 0.0 };
+    routing.forEachRoute(DescriptorID::pitch, [&minFreq, &maxFreq](DescriptorRoute const & route) {
+        minFreq = std::min(minFreq, route.parameter->getParamMinFreqPitch());
+        maxFreq = std::max(maxFreq, route.parameter->getParamMaxFreqPitch());
+    });
+    mPitchAnalysisMinFreq.store(minFreq, std::memory_order_relaxed);
+    mPitchAnalysisMaxFreq.store(maxFreq, std::memory_order_relaxed);
 
-//==============================================================================
-bool ControlGrisAudioProcessor::shouldProcessCubeNoiseAnalysis()
-{
-    if (mSpatMode == SpatMode::cube) {
-        for (const auto & spatParam : mSpatParametersCubeRefs) {
-            if (spatParam->shouldProcessNoiseAnalysis()) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
+    auto const descriptorMask{ routing.getDescriptorMask() };
+    mActiveDescriptors.store(descriptorMask, std::memory_order_relaxed);
+    mOnsetDetectionParameters.store(routing.getOnsetDetectionMask(), std::memory_order_relaxed);
+    mShouldProcessAudioAnalysis = mSelectedSoundTrajectoriesTabIdx == 0 && descriptorMask != 0;
 
-//==============================================================================
-bool ControlGrisAudioProcessor::shouldProcessCubeOnsetDetectionAnalysis()
-{
-    if (mSpatMode == SpatMode::cube) {
-        for (const auto & spatParam : mSpatParametersCubeRefs) {
-            if (spatParam->shouldProcessOnsetDetectionAnalysis()) {
-                return true;
-            }
-        }
-    }
-    return false;
+    mDescriptorRouting.publish();
 }
 
 } // namespace gris
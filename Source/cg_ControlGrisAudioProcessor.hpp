@@ -22,25 +22,38 @@
 
 #include <JuceHeader.h>
 
+#include "cg_AudioAnalysisMixdown.hpp"
+#include "cg_AudioAnalysisWorker.hpp"
 #include "cg_ChangeGesturesManager.hpp"
+#include "cg_MultiChannelAnalysis.hpp"
 #include "cg_PersistentStorage.h"
 #include "cg_PresetsManager.hpp"
 #include "cg_Source.hpp"
 #include "cg_SourceLinkEnforcer.hpp"
+#include "cg_TelemetryBus.hpp"
+#include "cg_TrajectoryClock.hpp"
 #include "cg_TrajectoryManager.hpp"
+#include "cg_TripleBuffer.hpp"
 #include "cg_constants.hpp"
+#include "cg_utilities.hpp"
 
 #include "FluidVersion.hpp"
 
+#include "Descriptors/cg_AnalysisResources.hpp"
 #include "Descriptors/cg_Centroid.hpp"
+#include "Descriptors/cg_DescriptorScheduler.hpp"
 #include "Descriptors/cg_Flatness.hpp"
 #include "Descriptors/cg_Loudness.hpp"
 #include "Descriptors/cg_OnsetDetection.hpp"
+#include "Descriptors/cg_OnsetDetectionFunctionCache.hpp"
 #include "Descriptors/cg_Pitch.hpp"
 #include "Descriptors/cg_Shape.hpp"
+#include "Descriptors/cg_SpectralFeatures.hpp"
+#include "Descriptors/cg_SpectralFrameCache.hpp"
 #include "Descriptors/cg_Spread.hpp"
 #include "Descriptors/cg_Stats.hpp"
 
+#include "SpatialParameters/cg_DescriptorRouting.hpp"
 #include "SpatialParameters/cg_SpatParamHelperFunctions.h"
 
 #include "SpatialParameters/cg_AzimuthDome.hpp"
@@ -82,10 +95,8 @@ class ControlGrisAudioProcessor final
     bool mNeedsInitialization{ true };
     PersistentStorage mPersistentStorage;
 
-    double mInitTimeOnPlay{ 0.0 };
-    double mCurrentTime{ 0.0 };
-    double mLastTime{ 10000000.0 };
-    double mLastTimerTime{ 10000000.0 };
+    // Clocked by processBlock, read by the timer.
+    TrajectoryClock mTrajectoryClock;
 
     bool mIsPlaying{ false };
     bool mCanStopActivate{ false };
@@ -94,8 +105,12 @@ class ControlGrisAudioProcessor final
     bool mPositionGestureStarted{};
     bool mElevationGestureStarted{};
 
+    // Hosts that do not call prepareToPlay every time the sequence starts. Queried once, because juce::PluginHostType
+    // allocates and cannot be built on the audio thread.
+    bool mHostNeedsInitializationOnPlay{};
+
     // juce::Uuid uniqueID{}; // for debugging purposes
-    juce::CriticalSection mLock;
+    RealtimeTryLock mLock;
 
     // OSC stuff
     const float IMPOSSIBLE_NUMBER{ std::numeric_limits<float>::min() };
@@ -141,6 +156,7 @@ class ControlGrisAudioProcessor final
     double mSampleRate{};
     int mBlockSize{};
     juce::AudioBuffer<float> mDescriptorsBuffer;
+    AudioAnalysisMixdown mAudioAnalysisMixdown;
     double mAudioAnalysisInputGainMultiplier{};
     int mChannelToAnalyse{};
     bool mShouldProcessAudioAnalysis{};
@@ -183,6 +199,7 @@ class ControlGrisAudioProcessor final
     OnsetDetectionD mOnsetDetectionX;
     OnsetDetectionD mOnsetDetectionY;
     OnsetDetectionD mOnsetDetectionZ;
+    OnsetDetectionFunctionCache mOnsetDetectionFunctionCache;
 
     SpatParamHelperFunctions mParamFunctions;
 
@@ -207,30 +224,48 @@ class ControlGrisAudioProcessor final
     std::array<OnsetDetectionD *, 4> mDomeOnsetDetectionRefs;
     std::array<OnsetDetectionD *, 5> mCubeOnsetDetectionRefs;
 
+    // Descriptor to spatial parameter routes of the current SpatMode, compiled by updateAudioAnalysisRouting().
+    TripleBuffer<DescriptorRoutingTable> mDescriptorRouting{};
+    // Same information for the analysis, which may run on the worker thread.
+    std::atomic<juce::uint32> mActiveDescriptors{};
+    std::atomic<juce::uint32> mOnsetDetectionParameters{};
+    std::atomic<double> mPitchAnalysisMinFreq{};
+    std::atomic<double> mPitchAnalysisMaxFreq{};
+    std::atomic<LoudnessWindow> mLoudnessWindow{ LoudnessWindow::momentary };
+
     // member variables for audio descriptor calculations
-    fluid::RealVector mInLoudness;
-    fluid::RealVector mPaddedLoudness;
-    fluid::index mNFramesLoudness;
-    fluid::RealMatrix mLoudnessMat;
-    fluid::RealVector mLoudnessDesc;
-
-    fluid::RealVector mInPitch;
-    fluid::RealVector mPaddedPitch;
-    fluid::index mNFramesPitch;
+    // The analysed signal, converted to double once per block and read by every descriptor.
+    fluid::RealVector mAnalysisSignal;
+
+    SpectralFrameCache mSpectralFrameCache;
+    SpectralFeatures mSpectralFeatures;
+    DescriptorScheduler mDescriptorScheduler;
+    AnalysisResources mAnalysisResources;
+
     fluid::RealMatrix mPitchMat;
-    fluid::ComplexVector mFramePitch;
-    fluid::RealVector mMagnitudePitch;
     fluid::RealVector mCalculatedPitchDesc;
 
-    fluid::RealVector mInSpectral;
-    fluid::RealVector mPaddedSpectral;
-    fluid::index mNFramesSpectral;
     fluid::RealMatrix mShapeMat;
     fluid::RealVector mShapeStats;
-    fluid::ComplexVector nFrameSpectral;
-    fluid::RealVector mMagnitudeSpectral;
     fluid::RealVector mCalculatedShapeDesc;
 
+    MultiChannelAnalysis mMultiChannelAnalysis;
+    std::atomic<bool> mPerSourceAnalysisOn{};
+    std::atomic<PerSourceTarget> mPerSourceAnalysisTarget{ PerSourceTarget::elevation };
+
+    // Published by the audio thread, drained by timerCallback() for the GUI and the OSC descriptor monitor.
+    TelemetryBus mTelemetryBus;
+    juce::uint64 mNumProcessedSamples{};
+    std::array<double, static_cast<size_t>(TelemetrySignal::count)> mTelemetrySums{};
+    std::array<int, static_cast<size_t>(TelemetrySignal::count)> mTelemetryCounts{};
+    std::array<double, static_cast<size_t>(TelemetrySignal::count)> mTelemetryValues{};
+
+    AudioDescriptorSnapshot mAudioDescriptorSnapshot;
+    bool mHasAudioDescriptorSnapshot{};
+    std::atomic<bool> mAudioAnalysisAsync{};
+    bool mWasAudioAnalysisAsync{};
+    AudioAnalysisWorker mAudioAnalysisWorker{ *this };
+
 public:
     //==============================================================================
     ControlGrisAudioProcessor();
@@ -301,6 +336,9 @@ public:
     auto & getSources() { return mSources; }
     auto const & getSources() const { return mSources; }
 
+    PositionTrajectoryManager & getPositionTrajectoryManager() { return mPositionTrajectoryManager; }
+    ElevationTrajectoryManager & getElevationTrajectoryManager() { return mElevationTrajectoryManager; }
+
     //==============================================================================
     juce::AudioProcessorValueTreeState const & getValueTreeState() const { return mAudioProcessorValueTreeState; }
     juce::AudioProcessorValueTreeState & getValueTreeState() { return mAudioProcessorValueTreeState; }
@@ -336,8 +374,11 @@ public:
 
     void initialize();
 
-    double getInitTimeOnPlay() const { return std::max(mInitTimeOnPlay, 0.0); }
-    double getCurrentTime() const { return std::max(mCurrentTime, 0.0); }
+    void setTrajectoryControlPeriodMs(double periodMs);
+    double getTrajectoryControlPeriodMs() const { return mTrajectoryClock.getControlPeriodMs(); }
+    void setPositionTrajectoryConstantSpeed(bool shouldBeConstantSpeed);
+    bool isPositionTrajectoryConstantSpeed() const { return mPositionTrajectoryManager.isConstantSpeed(); }
+    void setTrajectoryDrawingTolerance(double tolerance);
 
     bool isPlaying() const { return mIsPlaying; }
     double getBpm() const { return mBpm; }
@@ -384,26 +425,52 @@ public:
     void setOnsetDetectionMaxTime(ParameterID paramID, const double maxTime);
     void setOnsetDetectionFromClick(ParameterID paramID, const double timeValue);
 
+    /** Analyses the first numSamples samples of descriptorsBuffer. */
+    void analyseAudioDescriptors(juce::AudioBuffer<float> & descriptorsBuffer,
+                                 int numSamples,
+                                 AudioDescriptorSnapshot & snapshot);
+    void setAudioAnalysisAsync(bool shouldBeAsync);
+    bool isAudioAnalysisAsync() const { return mAudioAnalysisAsync.load(); }
+    double getAudioAnalysisLatencyMs() const;
+    void setAudioAnalysisBudgetUs(double budgetUs);
+    double getAudioAnalysisBudgetUs() const { return mDescriptorScheduler.getBudgetUs(); }
+    void setAudioAnalysisLoudnessWindow(LoudnessWindow window);
+    LoudnessWindow getAudioAnalysisLoudnessWindow() const { return mLoudnessWindow.load(); }
+    void setAudioAnalysisChannelWeight(int channel, float weight);
+    float getAudioAnalysisChannelWeight(int channel) const { return mAudioAnalysisMixdown.getChannelWeight(channel); }
+    void setAudioAnalysisChannelEnabled(int channel, bool shouldBeEnabled);
+    bool isAudioAnalysisChannelEnabled(int channel) const { return mAudioAnalysisMixdown.isChannelEnabled(channel); }
+
+    void setPerSourceAnalysisOn(bool shouldBeOn);
+    bool isPerSourceAnalysisOn() const { return mPerSourceAnalysisOn.load(std::memory_order_relaxed); }
+    void setPerSourceAnalysisDescriptor(PerSourceDescriptor descriptor);
+    PerSourceDescriptor getPerSourceAnalysisDescriptor() const { return mMultiChannelAnalysis.getDescriptor(); }
+    void setPerSourceAnalysisTarget(PerSourceTarget target);
+    PerSourceTarget getPerSourceAnalysisTarget() const { return mPerSourceAnalysisTarget.load(); }
+
+    /** Mean of the values published since the previous timer tick, or the last known value. Message thread only. */
+    double getTelemetryValue(TelemetrySignal signal) const { return mTelemetryValues[static_cast<size_t>(signal)]; }
+    void setOscMonitorOn(bool shouldBeOn);
+    bool isOscMonitorOn() const;
+
     void setAudioAnalysisAzimuthSpanFlag(bool flag) { mAudioAnalysisAzimuthSpanFlag = flag; }
     void setAudioAnalysisElevationSpanFlag(bool flag) { mAudioAnalysisElevationSpanFlag = flag; }
 
-    void setShouldProcessAudioAnalysis();
-    bool shouldProcessDomeSpectralAnalysis();
-    bool shouldProcessDomeLoudnessAnalysis();
-    bool shouldProcessDomePitchAnalysis();
-    bool shouldProcessDomeCentroidAnalysis();
-    bool shouldProcessDomeSpreadAnalysis();
-    bool shouldProcessDomeNoiseAnalysis();
-    bool shouldProcessDomeOnsetDetectionAnalysis();
-    bool shouldProcessCubeSpectralAnalysis();
-    bool shouldProcessCubeLoudnessAnalysis();
-    bool shouldProcessCubePitchAnalysis();
-    bool shouldProcessCubeCentroidAnalysis();
-    bool shouldProcessCubeSpreadAnalysis();
-    bool shouldProcessCubeNoiseAnalysis();
-    bool shouldProcessCubeOnsetDetectionAnalysis();
+    void updateAudioAnalysisRouting();
 
 private:
+    //==============================================================================
+    void applyAudioDescriptorSnapshot(AudioDescriptorSnapshot const & snapshot, int numSamples);
+    void updatePitchAnalysisRange();
+    void processPerSourceAnalysis(juce::AudioBuffer<float> const & buffer);
+    void publishTelemetry(AudioDescriptorSnapshot const & snapshot) noexcept;
+    juce::uint32 getRequiredAnalysisResources() const;
+    void allocateAnalysisResource(AnalysisResource resource);
+    void releaseAnalysisResource(AnalysisResource resource);
+    void flushSpatialParametersState();
+    void drainTelemetry();
+    void sendOscMonitorMessage();
+
     //==============================================================================
     JUCE_LEAK_DETECTOR(ControlGrisAudioProcessor)
 };
@@ -248,6 +248,7 @@ void ControlGrisAudioProcessorEditor::reloadUiState()
         mAudioProcessorValueTreeState.state.getProperty("oscOutputAddress", "192.168.1.100"));
     mSectionOscController.setOscSendOutputPort(
         mAudioProcessorValueTreeState.state.getProperty("oscOutputPortNumber", 8000));
+    mSectionOscController.setOscMonitorToggleState(mProcessor.isOscMonitorOn());
 
     // Set state for abstraction spatialization box persistent values.
     //------------------------------------------------
@@ -274,6 +275,11 @@ void ControlGrisAudioProcessorEditor::reloadUiState()
     mSectionAbstractTrajectories.setCycleDuration(
         mAudioProcessorValueTreeState.state.getProperty("cycleDuration", 5.0));
     mSectionAbstractTrajectories.setDurationUnit(mAudioProcessorValueTreeState.state.getProperty("durationUnit", 1));
+    mSectionAbstractTrajectories.setDrawingTolerance(mAudioProcessorValueTreeState.state.getProperty(
+        "trajectoryDrawingTolerance",
+        TrajectoryManager::DEFAULT_RECORDING_TOLERANCE));
+    mSectionAbstractTrajectories.setPositionConstantSpeed(mProcessor.isPositionTrajectoryConstantSpeed());
+    mSectionAbstractTrajectories.setControlPeriod(mProcessor.getTrajectoryControlPeriodMs());
 
     // Update the position preset box.
     //--------------------------------
@@ -1244,7 +1250,6 @@ void ControlGrisAudioProcessorEditor::refreshActivateButtonsState()
 //==============================================================================
 void ControlGrisAudioProcessorEditor::addNewParamValueToDataGraph()
 {
-    // called by the audio thread
     mSectionSoundReactiveTrajectories.addNewParamValueToDataGraph();
 }
 
@@ -1326,6 +1331,12 @@ void ControlGrisAudioProcessorEditor::oscOutputConnectionChangedCallback(bool co
     }
 }
 
+//==============================================================================
+void ControlGrisAudioProcessorEditor::oscMonitorChangedCallback(bool const state)
+{
+    mProcessor.setOscMonitorOn(state);
+}
+
 //==============================================================================
 void ControlGrisAudioProcessorEditor::paint(juce::Graphics & g)
 {
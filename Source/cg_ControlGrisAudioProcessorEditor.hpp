@@ -220,6 +220,7 @@ public:
     void oscOutputPluginIdChangedCallback(int value) override;
     void oscInputConnectionChangedCallback(bool state, int oscPort) override;
     void oscOutputConnectionChangedCallback(bool state, juce::String oscAddress, int oscPort) override;
+    void oscMonitorChangedCallback(bool state) override;
 
     void reloadUiState();
     void updateSpanLinkButton(bool state);
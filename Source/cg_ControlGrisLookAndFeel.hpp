@@ -24,22 +24,23 @@
 
 namespace gris
 {
+//==============================================================================
+/** The typeface of the interface, parsed once and shared by the editors of every plugin instance of the process. */
+struct SharedTypeface {
+    juce::Typeface::Ptr typeface{ juce::Typeface::createSystemTypefaceFor(
+        BinaryData::SinkinSans400Regular_otf,
+        static_cast<size_t>(BinaryData::SinkinSans400Regular_otfSize)) };
+};
+
 //==============================================================================
 class GrisLookAndFeel final : public juce::LookAndFeel_V4
 {
     float mFontSize;
-    juce::Font mFont{ juce::FontOptions(BinaryData::SinkinSans400Regular_otf,
-                                        juce::Font::plain,
-                                        static_cast<size_t>(BinaryData::SinkinSans400Regular_otfSize)) };
-    juce::Font mNumSliderFont{ juce::FontOptions(BinaryData::SinkinSans400Regular_otf,
-                                                 juce::Font::plain,
-                                                 static_cast<size_t>(BinaryData::SinkinSans400Regular_otfSize)) };
-    juce::Font mBigFont{ juce::FontOptions(BinaryData::SinkinSans400Regular_otf,
-                                           juce::Font::plain,
-                                           static_cast<size_t>(BinaryData::SinkinSans400Regular_otfSize)) };
-    juce::Font mBiggerFont{ juce::FontOptions(BinaryData::SinkinSans400Regular_otf,
-                                              juce::Font::plain,
-                                              static_cast<size_t>(BinaryData::SinkinSans400Regular_otfSize)) };
+    juce::SharedResourcePointer<SharedTypeface> mTypeface;
+    juce::Font mFont{ juce::FontOptions{ mTypeface->typeface } };
+    juce::Font mNumSliderFont{ juce::FontOptions{ mTypeface->typeface } };
+    juce::Font mBigFont{ juce::FontOptions{ mTypeface->typeface } };
+    juce::Font mBiggerFont{ juce::FontOptions{ mTypeface->typeface } };
 
     juce::Colour mBackgroundAndFieldColor;
     juce::Colour mWinBackgroundAndFieldColor;
@@ -58,6 +58,14 @@ void ElevationDrawingHandle::mouseDrag(juce::MouseEvent const & event)
     mFieldComponent.repaint();
 }
 
+//==============================================================================
+void ElevationDrawingHandle::mouseUp(juce::MouseEvent const & event)
+{
+    mouseDrag(event);
+    mFieldComponent.getAutomationManager().finishRecordingTrajectory();
+    mFieldComponent.repaint();
+}
+
 //==============================================================================
 void ElevationDrawingHandle::updatePositionInParent()
 {
@@ -50,6 +50,7 @@ public:
     //==============================================================================
     void mouseDown(juce::MouseEvent const & event) override;
     void mouseDrag(juce::MouseEvent const & event) override;
+    void mouseUp(juce::MouseEvent const & event) override;
     void updatePositionInParent() override;
 
 private:
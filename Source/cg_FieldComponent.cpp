@@ -25,6 +25,23 @@
 
 namespace gris
 {
+//==============================================================================
+juce::Path const & TrajectoryPathCache::getOutline(Trajectory const & trajectory,
+                                                   juce::Rectangle<float> const & area,
+                                                   SpatMode const spatMode)
+{
+    // Versions start at 1, so the first call always builds the outline.
+    if (trajectory.getVersion() != mVersion || area != mArea || spatMode != mSpatMode) {
+        mOutline.clear();
+        juce::PathStrokeType{ STROKE_THICKNESS }.createStrokedPath(mOutline,
+                                                                   trajectory.getDrawablePath(area, spatMode));
+        mVersion = trajectory.getVersion();
+        mArea = area;
+        mSpatMode = spatMode;
+    }
+    return mOutline;
+}
+
 //==============================================================================
 FieldComponent::FieldComponent(Sources & sources) noexcept : mSources(sources)
 {
@@ -445,9 +462,9 @@ void PositionFieldComponent::paint(juce::Graphics & g)
             g.drawLine(lineInComponentSpace, 0.75f);
         }
         if (mAutomationManager.getTrajectory().has_value()) {
-            auto const trajectoryPath{ mAutomationManager.getTrajectory()->getDrawablePath(getEffectiveArea(),
-                                                                                           mSpatMode) };
-            g.strokePath(trajectoryPath, juce::PathStrokeType(.75f));
+            g.fillPath(mTrajectoryPathCache.getOutline(*mAutomationManager.getTrajectory(),
+                                                       getEffectiveArea(),
+                                                       mSpatMode));
         }
         // position dot
         if (mIsPlaying && !isMouseButtonDown()
@@ -554,6 +571,10 @@ void PositionFieldComponent::mouseDrag(const juce::MouseEvent & event)
 void PositionFieldComponent::mouseUp(const juce::MouseEvent & event)
 {
     mouseDrag(event);
+    if (mAutomationManager.getTrajectoryType() == PositionTrajectoryType::drawing && mShowTrajectory) {
+        mAutomationManager.finishRecordingTrajectory();
+        repaint();
+    }
 }
 
 //==============================================================================
@@ -641,10 +662,9 @@ void ElevationFieldComponent::paint(juce::Graphics & g)
         // Draw recording trajectory path and current position dot.
         g.setColour(juce::Colour::fromRGB(176, 176, 228));
         if (mAutomationManager.getTrajectory().has_value()) {
-            auto const trajectoryPath{ mAutomationManager.getTrajectory()->getDrawablePath(
-                effectiveArea,
-                mSources.getPrimarySource().getSpatMode()) };
-            g.strokePath(trajectoryPath, juce::PathStrokeType{ .75f });
+            g.fillPath(mTrajectoryPathCache.getOutline(*mAutomationManager.getTrajectory(),
+                                                       effectiveArea,
+                                                       mSources.getPrimarySource().getSpatMode()));
         }
         if (mIsPlaying && !isMouseButtonDown()
             && static_cast<ElevationTrajectoryType>(mAutomationManager.getTrajectoryType())
@@ -703,7 +723,7 @@ void ElevationFieldComponent::mouseDrag([[maybe_unused]] const juce::MouseEvent
 void ElevationFieldComponent::mouseUp([[maybe_unused]] const juce::MouseEvent & event)
 {
     if (mAutomationManager.getTrajectoryType() == ElevationTrajectoryType::drawing && mShowTrajectory) {
-        mDrawingHandle.mouseDrag(event);
+        mDrawingHandle.mouseUp(event);
     }
 }
 
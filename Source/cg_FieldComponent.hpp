@@ -48,6 +48,29 @@ namespace gris
 //                             parameter for the LBAP algorithm.
 //==============================================================================
 
+//==============================================================================
+/** The outline of the stroked path of a trajectory, rebuilt only when the trajectory, the area or the spat mode
+ * changes. Filling the outline draws the same pixels as stroking the path.
+ */
+class TrajectoryPathCache
+{
+    juce::Path mOutline{};
+    juce::uint32 mVersion{};
+    juce::Rectangle<float> mArea{};
+    SpatMode mSpatMode{};
+
+public:
+    //==============================================================================
+    static constexpr float STROKE_THICKNESS{ 0.75f };
+    //==============================================================================
+    juce::Path const &
+        getOutline(Trajectory const & trajectory, juce::Rectangle<float> const & area, SpatMode spatMode);
+
+private:
+    //==============================================================================
+    JUCE_LEAK_DETECTOR(TrajectoryPathCache)
+};
+
 //==============================================================================
 class FieldComponent
     : public juce::Component
@@ -86,6 +109,7 @@ protected:
     std::optional<SourceIndex> mOldSelectedSource{};
     bool mDisplayInvalidSourceMoveWarning{};
     bool mShowTrajectory{};
+    TrajectoryPathCache mTrajectoryPathCache{};
 
 public:
     //==============================================================================
@@ -0,0 +1,199 @@
+/*
+ This file is part of ControlGris.
+
+ Developers: Hicheme BEN GAIED, Gaël LANE LÉPINE
+
+ ControlGris is free software: you can redistribute it and/or modify
+ it under the terms of the GNU Lesser General Public License as
+ published by the Free Software Foundation, either version 3 of the
+ License, or (at your option) any later version.
+
+ ControlGris is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with ControlGris.  If not, see
+ <http://www.gnu.org/licenses/>.
+*/
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <array>
+#include <atomic>
+#include <cmath>
+
+namespace gris
+{
+//==============================================================================
+// The values are saved in the plugin state: only append to these.
+enum class PerSourceDescriptor { loudness = 0, rmsFrequency };
+enum class PerSourceTarget { elevation = 0, azimuthSpan, elevationSpan, azimuth };
+
+//==============================================================================
+/** Loudness and RMS frequency of every input channel, computed in a single pass over the block.
+ *
+ * The state of the channels is kept in structure-of-arrays form and each channel is read once per block by a kernel
+ * that only accumulates the energy of the signal and the energy of its first difference. Both energies are smoothed
+ * over SMOOTHING_TIME_S and the descriptors are derived from them on demand:
+ * - the loudness is the smoothed mean square in dBFS;
+ * - the RMS frequency is sqrt(E[x'^2] / E[x^2]), the square root of the power weighted mean of the squared
+ *   frequencies, corrected for the response of the first difference with an asin. It is exact for a sinusoid. For a
+ *   mixture it leans toward the high partials compared to a spectral centroid, which would need an FFT.
+ *
+ * The cost is linear in the number of channels and nothing is allocated after construction. Settings can be changed
+ * from any thread, the rest is meant for the audio thread.
+ */
+class MultiChannelAnalysis
+{
+public:
+    //==============================================================================
+    static constexpr int MAX_NUM_CHANNELS{ 256 };
+    static constexpr double SMOOTHING_TIME_S{ 0.05 };
+    static constexpr double MIN_LOUDNESS_DB{ -60.0 };
+    static constexpr double MAX_LOUDNESS_DB{ 0.0 };
+    static constexpr double MIN_RMS_FREQUENCY_HZ{ 50.0 };
+    static constexpr double MAX_RMS_FREQUENCY_HZ{ 10000.0 };
+
+    //==============================================================================
+    MultiChannelAnalysis() = default;
+
+    void prepare(double sampleRate)
+    {
+        mSampleRate = sampleRate;
+        mMeanSquares.fill(0.0f);
+        mDiffMeanSquares.fill(0.0f);
+        mPreviousSamples.fill(0.0f);
+        mRmsFrequenciesHz.fill(static_cast<float>(MIN_RMS_FREQUENCY_HZ));
+    }
+
+    void setDescriptor(PerSourceDescriptor descriptor) { mDescriptor.store(descriptor, std::memory_order_relaxed); }
+    PerSourceDescriptor getDescriptor() const { return mDescriptor.load(std::memory_order_relaxed); }
+
+    //==============================================================================
+    /** Analyses the first numChannels channels of input. The gain is applied to the signal before the analysis. */
+    void process(juce::AudioBuffer<float> const & input, int numChannels, float gain) noexcept
+    {
+        auto const numSamples{ input.getNumSamples() };
+        numChannels = std::min(numChannels, MAX_NUM_CHANNELS);
+        if (numSamples == 0 || mSampleRate <= 0.0) {
+            return;
+        }
+
+        auto const smoothing{ static_cast<float>(
+            1.0 - std::exp(-static_cast<double>(numSamples) / (SMOOTHING_TIME_S * mSampleRate))) };
+        auto const scale{ gain * gain / static_cast<float>(numSamples) };
+
+        for (int channel{}; channel < numChannels; ++channel) {
+            auto const index{ static_cast<size_t>(channel) };
+            auto const * samples{ input.getReadPointer(channel) };
+
+            auto const energies{ accumulateEnergies(samples, numSamples, mPreviousSamples[index]) };
+            mPreviousSamples[index] = samples[numSamples - 1];
+
+            mMeanSquares[index] += (energies.signal * scale - mMeanSquares[index]) * smoothing;
+            mDiffMeanSquares[index] += (energies.difference * scale - mDiffMeanSquares[index]) * smoothing;
+        }
+
+        // The RMS frequency keeps its last value through silences.
+        for (int channel{}; channel < numChannels; ++channel) {
+            auto const index{ static_cast<size_t>(channel) };
+            if (mMeanSquares[index] > SILENCE_MEAN_SQUARE) {
+                auto const ratio{ std::min(std::sqrt(mDiffMeanSquares[index] / mMeanSquares[index]) * 0.5f, 1.0f) };
+                mRmsFrequenciesHz[index] = static_cast<float>(mSampleRate / juce::MathConstants<double>::pi)
+                                      * std::asin(ratio);
+            }
+        }
+    }
+
+    //==============================================================================
+    double getLoudnessDb(int channel) const noexcept
+    {
+        auto const meanSquare{ static_cast<double>(mMeanSquares[static_cast<size_t>(channel)]) };
+        return meanSquare > 0.0 ? std::max(10.0 * std::log10(meanSquare), MIN_LOUDNESS_DB) : MIN_LOUDNESS_DB;
+    }
+
+    double getRmsFrequencyHz(int channel) const noexcept
+    {
+        return static_cast<double>(mRmsFrequenciesHz[static_cast<size_t>(channel)]);
+    }
+
+    /** The selected descriptor of a channel, scaled to [0, 1]. The RMS frequency is scaled on a logarithmic axis. */
+    double getNormalizedValue(int channel) const noexcept
+    {
+        if (getDescriptor() == PerSourceDescriptor::loudness) {
+            return juce::jlimit(0.0,
+                                1.0,
+                                (getLoudnessDb(channel) - MIN_LOUDNESS_DB) / (MAX_LOUDNESS_DB - MIN_LOUDNESS_DB));
+        }
+        auto const frequencyHz{ std::max(getRmsFrequencyHz(channel), MIN_RMS_FREQUENCY_HZ) };
+        return juce::jlimit(0.0,
+                            1.0,
+                            std::log(frequencyHz / MIN_RMS_FREQUENCY_HZ)
+                                / std::log(MAX_RMS_FREQUENCY_HZ / MIN_RMS_FREQUENCY_HZ));
+    }
+
+private:
+    //==============================================================================
+    struct Energies {
+        float signal{};
+        float difference{};
+    };
+
+    // -120 dBFS
+    static constexpr float SILENCE_MEAN_SQUARE{ 1e-12f };
+    static constexpr int NUM_LANES{ 8 };
+
+    /** Sums of x^2 and (x[n] - x[n - 1])^2. The sums are split over independent lanes so that the compiler can keep
+     * them in vector registers without reordering any floating point addition.
+     */
+    static Energies accumulateEnergies(float const * samples, int numSamples, float previousSample) noexcept
+    {
+        std::array<float, NUM_LANES> signal{};
+        std::array<float, NUM_LANES> difference{};
+
+        auto const firstDifference{ samples[0] - previousSample };
+        signal[0] = samples[0] * samples[0];
+        difference[0] = firstDifference * firstDifference;
+
+        int i{ 1 };
+        for (; i + NUM_LANES <= numSamples; i += NUM_LANES) {
+            for (int lane{}; lane < NUM_LANES; ++lane) {
+                auto const sample{ samples[i + lane] };
+                auto const diff{ sample - samples[i + lane - 1] };
+                signal[static_cast<size_t>(lane)] += sample * sample;
+                difference[static_cast<size_t>(lane)] += diff * diff;
+            }
+        }
+        for (; i < numSamples; ++i) {
+            auto const diff{ samples[i] - samples[i - 1] };
+            signal[0] += samples[i] * samples[i];
+            difference[0] += diff * diff;
+        }
+
+        Energies result{};
+        for (int lane{}; lane < NUM_LANES; ++lane) {
+            result.signal += signal[static_cast<size_t>(lane)];
+            result.difference += difference[static_cast<size_t>(lane)];
+        }
+        return result;
+    }
+
+    //==============================================================================
+    double mSampleRate{};
+    std::atomic<PerSourceDescriptor> mDescriptor{ PerSourceDescriptor::loudness };
+
+    std::array<float, MAX_NUM_CHANNELS> mMeanSquares{};
+    std::array<float, MAX_NUM_CHANNELS> mDiffMeanSquares{};
+    std::array<float, MAX_NUM_CHANNELS> mPreviousSamples{};
+    std::array<float, MAX_NUM_CHANNELS> mRmsFrequenciesHz{};
+
+    //==============================================================================
+    JUCE_LEAK_DETECTOR(MultiChannelAnalysis)
+};
+} // namespace gris
@@ -29,6 +29,8 @@ namespace
 auto constexpr SPEED_SLIDER_MIN_VAL{ 0.0 };
 auto constexpr SPEED_SLIDER_MAX_VAL{ 10.0 };
 auto constexpr SPEED_SLIDER_MID_VAL{ 1.0 };
+// The drawing tolerance is shown as a percentage of the width of the field, which spans [-1, 1].
+auto constexpr TOLERANCE_TO_PERCENT{ 100.0 / 2.0 };
 } // namespace
 
 //==============================================================================
@@ -38,6 +40,8 @@ SectionAbstractTrajectories::SectionAbstractTrajectories(GrisLookAndFeel & grisL
     : mGrisLookAndFeel(grisLookAndFeel)
     , mAPVTS(apvts)
     , mProcessor(audioProcessor)
+    , mDrawingToleranceSlider(grisLookAndFeel)
+    , mControlPeriodSlider(grisLookAndFeel)
     , mRandomProximityXYSlider(grisLookAndFeel)
     , mRandomTimeMinXYSlider(grisLookAndFeel)
     , mRandomTimeMaxXYSlider(grisLookAndFeel)
@@ -111,6 +115,40 @@ SectionAbstractTrajectories::SectionAbstractTrajectories(GrisLookAndFeel & grisL
         });
     };
 
+    mDrawingToleranceLabel.setText("Simplify (%):", juce::dontSendNotification);
+    mDrawingToleranceLabel.setTooltip("How far a simplified drawing may stray from the drawn gesture.");
+    addAndMakeVisible(&mDrawingToleranceLabel);
+
+    addAndMakeVisible(&mDrawingToleranceSlider);
+    mDrawingToleranceSlider.setDefaultNumDecimalPlacesToDisplay(2);
+    mDrawingToleranceSlider.setRange(0.0, TrajectoryManager::MAX_RECORDING_TOLERANCE * TOLERANCE_TO_PERCENT, 0.01);
+    mDrawingToleranceSlider.setDefaultReturnValue(TrajectoryManager::DEFAULT_RECORDING_TOLERANCE
+                                                  * TOLERANCE_TO_PERCENT);
+    mDrawingToleranceSlider.onValueChange = [this] {
+        mProcessor.setTrajectoryDrawingTolerance(mDrawingToleranceSlider.getValue() / TOLERANCE_TO_PERCENT);
+    };
+
+    mPositionConstantSpeedToggle.setButtonText("Const. speed");
+    mPositionConstantSpeedToggle.setTooltip(
+        "Draw at a constant speed. When off, the speed follows how fast the trajectory was drawn.");
+    addAndMakeVisible(&mPositionConstantSpeedToggle);
+    mPositionConstantSpeedToggle.onClick = [this] {
+        mProcessor.setPositionTrajectoryConstantSpeed(mPositionConstantSpeedToggle.getToggleState());
+    };
+
+    mControlPeriodLabel.setText("Period (ms):", juce::dontSendNotification);
+    mControlPeriodLabel.setTooltip("How often the trajectories are evaluated while the host plays.");
+    addAndMakeVisible(&mControlPeriodLabel);
+
+    addAndMakeVisible(&mControlPeriodSlider);
+    mControlPeriodSlider.setDefaultNumDecimalPlacesToDisplay(1);
+    mControlPeriodSlider.setRange(TrajectoryClock::MIN_CONTROL_PERIOD_MS, TrajectoryClock::MAX_CONTROL_PERIOD_MS, 0.5);
+    mControlPeriodSlider.setDefaultReturnValue(TrajectoryClock::DEFAULT_CONTROL_PERIOD_MS);
+    mControlPeriodSlider.setValue(mProcessor.getTrajectoryControlPeriodMs(), juce::dontSendNotification);
+    mControlPeriodSlider.onValueChange = [this] {
+        mProcessor.setTrajectoryControlPeriodMs(mControlPeriodSlider.getValue());
+    };
+
     mCycleSpeedLabel.setText("Speed:", juce::dontSendNotification);
     addAndMakeVisible(&mCycleSpeedLabel);
 
@@ -696,6 +734,24 @@ void SectionAbstractTrajectories::setDeviationPerCycle(float const value)
     mDeviationEditor.setText(juce::String(value));
 }
 
+//==============================================================================
+void SectionAbstractTrajectories::setDrawingTolerance(double const tolerance)
+{
+    mDrawingToleranceSlider.setValue(tolerance * TOLERANCE_TO_PERCENT, juce::dontSendNotification);
+}
+
+//==============================================================================
+void SectionAbstractTrajectories::setPositionConstantSpeed(bool const state)
+{
+    mPositionConstantSpeedToggle.setToggleState(state, juce::dontSendNotification);
+}
+
+//==============================================================================
+void SectionAbstractTrajectories::setControlPeriod(double const periodMs)
+{
+    mControlPeriodSlider.setValue(periodMs, juce::dontSendNotification);
+}
+
 //==============================================================================
 void SectionAbstractTrajectories::setPositionActivateState(bool const state)
 {
@@ -918,6 +974,8 @@ void SectionAbstractTrajectories::resized()
     mDeviationLabel2ndLine.setBounds(110, 48, 90, 22);
     mDeviationEditor.setBounds(211, 49, 78, 15);
     mCycleSpeedLabel.setBounds(5, 71, 100, 22);
+    mControlPeriodLabel.setBounds(5, 105, 100, 22);
+    mControlPeriodSlider.setBounds(10, 127, 45, 12);
     mPositionCycleSpeedSlider.setBounds(113, 72, 180, 16);
 
     mRandomXYToggle.setBounds(112, 92, 60, 15);
@@ -1009,6 +1067,10 @@ void SectionAbstractTrajectories::resized()
     mDurationLabel.setBounds(495, 5, 90, 20);
     mDurationEditor.setBounds(500, 30, 90, 20);
     mDurationUnitCombo.setBounds(500, 60, 90, 20);
+
+    mDrawingToleranceLabel.setBounds(495, 90, 90, 20);
+    mDrawingToleranceSlider.setBounds(500, 112, 45, 12);
+    mPositionConstantSpeedToggle.setBounds(496, 132, 94, 15);
 }
 
 //==============================================================================
@@ -109,6 +109,13 @@ private:
     TextEd mDurationEditor{ mGrisLookAndFeel };
     juce::ComboBox mDurationUnitCombo;
 
+    juce::Label mDrawingToleranceLabel;
+    NumSlider mDrawingToleranceSlider;
+    juce::ToggleButton mPositionConstantSpeedToggle;
+
+    juce::Label mControlPeriodLabel;
+    NumSlider mControlPeriodSlider;
+
     juce::Label mCycleSpeedLabel;
     juce::Slider mPositionCycleSpeedSlider;
     juce::Slider mElevationCycleSpeedSlider;
@@ -180,6 +187,9 @@ public:
     void setCycleDuration(double value);
     void setDurationUnit(int value);
     void setDeviationPerCycle(float value);
+    void setDrawingTolerance(double tolerance);
+    void setPositionConstantSpeed(bool state);
+    void setControlPeriod(double periodMs);
 
     bool getPositionActivateState() const { return mPositionActivateButton.getToggleState(); }
     bool getElevationActivateState() const { return mElevationActivateButton.getToggleState(); }
@@ -69,6 +69,13 @@ SectionOscController::SectionOscController(GrisLookAndFeel & grisLookAndFeel) :
         });
     };
 
+    mOscMonitorToggle.setButtonText("Send descriptor monitor");
+    mOscMonitorToggle.setTooltip("Also send the descriptors and parameters values that drive the sources.");
+    addAndMakeVisible(&mOscMonitorToggle);
+    mOscMonitorToggle.onClick = [this] {
+        mListeners.call([&](Listener & l) { l.oscMonitorChangedCallback(mOscMonitorToggle.getToggleState()); });
+    };
+
     mOscReceiveIpEditor.setLookAndFeel(&mGrisLookAndFeel);
     mOscReceiveIpEditor.setFont(grisLookAndFeel.getFont());
     mOscReceiveIpEditor.setText(juce::IPAddress::getLocalAddress().toString());
@@ -178,6 +185,12 @@ void SectionOscController::setOscSendToggleState(bool const state)
     mOscSendToggle.setToggleState(state, juce::NotificationType::dontSendNotification);
 }
 
+//==============================================================================
+void SectionOscController::setOscMonitorToggleState(bool const state)
+{
+    mOscMonitorToggle.setToggleState(state, juce::NotificationType::dontSendNotification);
+}
+
 //==============================================================================
 void SectionOscController::setOscSendOutputAddress(juce::String const & address)
 {
@@ -198,6 +211,8 @@ void SectionOscController::resized()
     mOscSendToggle.setBounds(5, 50, 200, 15);
     mOscSendPortEditor.setBounds(130, 50, 40, 15);
     mOscSendIpEditor.setBounds(175, 50, 110, 15);
+
+    mOscMonitorToggle.setBounds(5, 70, 200, 15);
 }
 
 } // namespace gris
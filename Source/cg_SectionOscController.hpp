@@ -37,6 +37,7 @@ public:
         virtual void oscOutputPluginIdChangedCallback(int value) = 0;
         virtual void oscInputConnectionChangedCallback(bool state, int oscPort) = 0;
         virtual void oscOutputConnectionChangedCallback(bool state, juce::String oscAddress, int oscPort) = 0;
+        virtual void oscMonitorChangedCallback(bool state) = 0;
     };
 
 private:
@@ -47,6 +48,7 @@ private:
 
     juce::ToggleButton mOscReceiveToggle{};
     juce::ToggleButton mOscSendToggle{};
+    juce::ToggleButton mOscMonitorToggle{};
 
     juce::Label mOscOutputPluginIdLabel{};
     TextEd mOscOutputPluginIdEditor{ mGrisLookAndFeel };
@@ -84,6 +86,8 @@ public:
     void setOscSendOutputAddress(juce::String const & address);
     void setOscSendOutputPort(int port);
 
+    void setOscMonitorToggleState(bool state);
+
     void addListener(Listener * l) { mListeners.add(l); }
     [[maybe_unused]] void removeListener(Listener * l) { mListeners.remove(l); }
 
@@ -61,6 +61,7 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
     , mDescriptorMaxTimeSlider(grisLookAndFeel)
     , mDescriptorSmoothSlider(grisLookAndFeel)
     , mDescriptorSmoothCoefSlider(grisLookAndFeel)
+    , mDescriptorBudgetSlider(grisLookAndFeel)
 {
     auto const initRangeSlider = [&](NumSlider & slider) {
         slider.setNormalisableRange(juce::NormalisableRange<double>{ -10000.0, 10000.0, 0.1 });
@@ -93,6 +94,14 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
               case DescriptorID::noise:
                   param.setParamRangeNoise(rangeSlider.getValue());
                   break;
+              case DescriptorID::flux:
+              case DescriptorID::rolloff:
+              case DescriptorID::crest:
+              case DescriptorID::lowBandEnergy:
+              case DescriptorID::midBandEnergy:
+              case DescriptorID::highBandEnergy:
+                  param.setParamRangeSpectralFeature(rangeSlider.getValue());
+                  break;
               case DescriptorID::iterationsSpeed:
                   param.setParamRangeOnsetDetection(rangeSlider.getValue());
                   break;
@@ -100,6 +109,8 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
               default:
                   break;
               }
+              // A range of 0 disconnects the parameter from its descriptor.
+              mAudioProcessor.updateAudioAnalysisRouting();
           };
 
     auto const offsetSliderOnValueChange
@@ -120,6 +131,14 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
               case DescriptorID::noise:
                   param.setParamOffsetNoise(offsetSlider.getValue());
                   break;
+              case DescriptorID::flux:
+              case DescriptorID::rolloff:
+              case DescriptorID::crest:
+              case DescriptorID::lowBandEnergy:
+              case DescriptorID::midBandEnergy:
+              case DescriptorID::highBandEnergy:
+                  param.setParamOffsetSpectralFeature(offsetSlider.getValue());
+                  break;
               case DescriptorID::iterationsSpeed:
                   param.setParamOffsetOnsetDetection(offsetSlider.getValue());
                   break;
@@ -141,6 +160,7 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
     mAudioAnalysisSelectedDescriptor.setColour(juce::Label::backgroundColourId, mGrisLookAndFeel.getOnColor());
     mAudioAnalysisSelectedDescriptor.setColour(juce::Label::textColourId, mGrisLookAndFeel.getDarkColor());
     mAudioAnalysisSelectedDescriptor.setJustificationType(juce::Justification::centred);
+    addAndMakeVisible(&mAudioAnalysisLatencyLabel);
 
     //==============================================================================
     // Spatial Parameters
@@ -409,6 +429,14 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
         case DescriptorID::noise:
             param.setParamLapNoise(value);
             break;
+        case DescriptorID::flux:
+        case DescriptorID::rolloff:
+        case DescriptorID::crest:
+        case DescriptorID::lowBandEnergy:
+        case DescriptorID::midBandEnergy:
+        case DescriptorID::highBandEnergy:
+            param.setParamLapSpectralFeature(value);
+            break;
         case DescriptorID::iterationsSpeed:
             param.setParamLapOnsetDetection(value);
             break;
@@ -620,6 +648,17 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
             mParameterAzimuthXOffsetSlider.setValue(param.getParamOffsetNoise());
             mParameterLapEditor.setText(juce::String(param.getParamLapNoise()));
             break;
+        case DescriptorID::flux:
+        case DescriptorID::rolloff:
+        case DescriptorID::crest:
+        case DescriptorID::lowBandEnergy:
+        case DescriptorID::midBandEnergy:
+        case DescriptorID::highBandEnergy:
+            mParameterAzimuthRangeSlider.setValue(param.getParamRangeSpectralFeature());
+            mParameterAzimuthXOffsetSlider.setVisible(true);
+            mParameterAzimuthXOffsetSlider.setValue(param.getParamOffsetSpectralFeature());
+            mParameterLapEditor.setText(juce::String(param.getParamLapSpectralFeature()));
+            break;
         case DescriptorID::iterationsSpeed:
             mParameterAzimuthRangeSlider.setValue(param.getParamRangeOnsetDetection());
             mParameterAzimuthXOffsetSlider.setVisible(false);
@@ -636,7 +675,7 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
         }
 
         refreshDescriptorPanel();
-        mAudioProcessor.setShouldProcessAudioAnalysis();
+        mAudioProcessor.updateAudioAnalysisRouting();
     };
 
     initParameterDescCombo(mParameterElevationDescriptorCombo);
@@ -689,6 +728,16 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
             mParameterElevationZOffsetSlider.setVisible(true);
             mParameterElevationZOffsetSlider.setValue(param.getParamOffsetNoise());
             break;
+        case DescriptorID::flux:
+        case DescriptorID::rolloff:
+        case DescriptorID::crest:
+        case DescriptorID::lowBandEnergy:
+        case DescriptorID::midBandEnergy:
+        case DescriptorID::highBandEnergy:
+            mParameterElevationRangeSlider.setValue(param.getParamRangeSpectralFeature());
+            mParameterElevationZOffsetSlider.setVisible(true);
+            mParameterElevationZOffsetSlider.setValue(param.getParamOffsetSpectralFeature());
+            break;
         case DescriptorID::iterationsSpeed:
             mParameterElevationRangeSlider.setValue(param.getParamRangeOnsetDetection());
             mParameterElevationZOffsetSlider.setVisible(false);
@@ -701,7 +750,7 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
         }
 
         refreshDescriptorPanel();
-        mAudioProcessor.setShouldProcessAudioAnalysis();
+        mAudioProcessor.updateAudioAnalysisRouting();
     };
 
     initParameterDescCombo(mParameterXDescriptorCombo);
@@ -758,6 +807,17 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
             mParameterAzimuthXOffsetSlider.setValue(param.getParamOffsetNoise());
             mParameterLapEditor.setText(juce::String(param.getParamLapNoise()));
             break;
+        case DescriptorID::flux:
+        case DescriptorID::rolloff:
+        case DescriptorID::crest:
+        case DescriptorID::lowBandEnergy:
+        case DescriptorID::midBandEnergy:
+        case DescriptorID::highBandEnergy:
+            mParameterXRangeSlider.setValue(param.getParamRangeSpectralFeature());
+            mParameterAzimuthXOffsetSlider.setVisible(true);
+            mParameterAzimuthXOffsetSlider.setValue(param.getParamOffsetSpectralFeature());
+            mParameterLapEditor.setText(juce::String(param.getParamLapSpectralFeature()));
+            break;
         case DescriptorID::iterationsSpeed:
             mParameterXRangeSlider.setValue(param.getParamRangeOnsetDetection());
             mParameterAzimuthXOffsetSlider.setVisible(false);
@@ -771,7 +831,7 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
         }
 
         refreshDescriptorPanel();
-        mAudioProcessor.setShouldProcessAudioAnalysis();
+        mAudioProcessor.updateAudioAnalysisRouting();
     };
 
     initParameterDescCombo(mParameterYDescriptorCombo);
@@ -822,6 +882,16 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
             mParameterYOffsetSlider.setVisible(true);
             mParameterYOffsetSlider.setValue(param.getParamOffsetNoise());
             break;
+        case DescriptorID::flux:
+        case DescriptorID::rolloff:
+        case DescriptorID::crest:
+        case DescriptorID::lowBandEnergy:
+        case DescriptorID::midBandEnergy:
+        case DescriptorID::highBandEnergy:
+            mParameterYRangeSlider.setValue(param.getParamRangeSpectralFeature());
+            mParameterYOffsetSlider.setVisible(true);
+            mParameterYOffsetSlider.setValue(param.getParamOffsetSpectralFeature());
+            break;
         case DescriptorID::iterationsSpeed:
             mParameterYRangeSlider.setValue(param.getParamRangeOnsetDetection());
             mParameterYOffsetSlider.setVisible(false);
@@ -834,7 +904,7 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
         }
 
         refreshDescriptorPanel();
-        mAudioProcessor.setShouldProcessAudioAnalysis();
+        mAudioProcessor.updateAudioAnalysisRouting();
     };
 
     initParameterDescCombo(mParameterZDescriptorCombo);
@@ -885,6 +955,16 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
             mParameterElevationZOffsetSlider.setVisible(true);
             mParameterElevationZOffsetSlider.setValue(param.getParamOffsetNoise());
             break;
+        case DescriptorID::flux:
+        case DescriptorID::rolloff:
+        case DescriptorID::crest:
+        case DescriptorID::lowBandEnergy:
+        case DescriptorID::midBandEnergy:
+        case DescriptorID::highBandEnergy:
+            mParameterZRangeSlider.setValue(param.getParamRangeSpectralFeature());
+            mParameterElevationZOffsetSlider.setVisible(true);
+            mParameterElevationZOffsetSlider.setValue(param.getParamOffsetSpectralFeature());
+            break;
         case DescriptorID::iterationsSpeed:
             mParameterZRangeSlider.setValue(param.getParamRangeOnsetDetection());
             mParameterElevationZOffsetSlider.setVisible(false);
@@ -897,7 +977,7 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
         }
 
         refreshDescriptorPanel();
-        mAudioProcessor.setShouldProcessAudioAnalysis();
+        mAudioProcessor.updateAudioAnalysisRouting();
     };
 
     initParameterDescCombo(mParameterAzimuthOrXYSpanDescriptorCombo);
@@ -970,6 +1050,16 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
                 mParameterAziXYSpanOffsetSlider.setVisible(true);
                 mParameterAziXYSpanOffsetSlider.setValue(param.getParamOffsetNoise());
                 break;
+            case DescriptorID::flux:
+            case DescriptorID::rolloff:
+            case DescriptorID::crest:
+            case DescriptorID::lowBandEnergy:
+            case DescriptorID::midBandEnergy:
+            case DescriptorID::highBandEnergy:
+                mParameterAzimuthOrXYSpanRangeSlider.setValue(param.getParamRangeSpectralFeature());
+                mParameterAziXYSpanOffsetSlider.setVisible(true);
+                mParameterAziXYSpanOffsetSlider.setValue(param.getParamOffsetSpectralFeature());
+                break;
             case DescriptorID::iterationsSpeed:
                 mParameterAzimuthOrXYSpanRangeSlider.setValue(param.getParamRangeOnsetDetection());
                 mParameterAziXYSpanOffsetSlider.setVisible(false);
@@ -984,7 +1074,7 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
 
         mAudioProcessor.setAudioAnalysisAzimuthSpanFlag(mDescriptorIdToUse != DescriptorID::invalid);
         refreshDescriptorPanel();
-        mAudioProcessor.setShouldProcessAudioAnalysis();
+        mAudioProcessor.updateAudioAnalysisRouting();
     };
 
     initParameterDescCombo(mParameterElevationOrZSpanDescriptorCombo);
@@ -1057,6 +1147,16 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
                 mParameterEleZSpanOffsetSlider.setVisible(true);
                 mParameterEleZSpanOffsetSlider.setValue(param.getParamOffsetNoise());
                 break;
+            case DescriptorID::flux:
+            case DescriptorID::rolloff:
+            case DescriptorID::crest:
+            case DescriptorID::lowBandEnergy:
+            case DescriptorID::midBandEnergy:
+            case DescriptorID::highBandEnergy:
+                mParameterElevationOrZSpanRangeSlider.setValue(param.getParamRangeSpectralFeature());
+                mParameterEleZSpanOffsetSlider.setVisible(true);
+                mParameterEleZSpanOffsetSlider.setValue(param.getParamOffsetSpectralFeature());
+                break;
             case DescriptorID::iterationsSpeed:
                 mParameterElevationOrZSpanRangeSlider.setValue(param.getParamRangeOnsetDetection());
                 mParameterEleZSpanOffsetSlider.setVisible(false);
@@ -1071,7 +1171,7 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
 
         mAudioProcessor.setAudioAnalysisElevationSpanFlag(mDescriptorIdToUse != DescriptorID::invalid);
         refreshDescriptorPanel();
-        mAudioProcessor.setShouldProcessAudioAnalysis();
+        mAudioProcessor.updateAudioAnalysisRouting();
     };
 
     addAndMakeVisible(&mParameterRangeLabel);
@@ -1123,10 +1223,45 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
         mAudioProcessor.setAudioAnalysisState(state);
     };
 
+    addAndMakeVisible(&mAudioAnalysisAsyncButton);
+    mAudioAnalysisAsyncButton.setButtonText("Async");
+    mAudioAnalysisAsyncButton.setClickingTogglesState(true);
+    mAudioAnalysisAsyncButton.setToggleState(mAudioProcessor.isAudioAnalysisAsync(), juce::dontSendNotification);
+    mAudioAnalysisAsyncButton.setTooltip("Analyse audio descriptors on a background thread. Lightens the audio "
+                                         "thread at the cost of some latency.");
+    mAudioAnalysisAsyncButton.onClick = [this] {
+        mAudioProcessor.setAudioAnalysisAsync(mAudioAnalysisAsyncButton.getToggleState());
+        updateAudioAnalysisLatency();
+    };
+
+    addAndMakeVisible(&mAudioAnalysisChannelsButton);
+    mAudioAnalysisChannelsButton.setButtonText("Channels");
+    mAudioAnalysisChannelsButton.setTooltip("Weight or mute each input channel of the \"Mix\" analysis channel.");
+    mAudioAnalysisChannelsButton.onClick = [this] {
+        auto channelsComponent{ std::make_unique<AudioAnalysisChannelsComponent>(mGrisLookAndFeel, mAudioProcessor) };
+        auto & box = juce::CallOutBox::launchAsynchronously(std::move(channelsComponent),
+                                                            mAudioAnalysisChannelsButton.getScreenBounds(),
+                                                            nullptr);
+        box.setLookAndFeel(&mGrisLookAndFeel);
+    };
+
+    addAndMakeVisible(&mAudioAnalysisPerSourceButton);
+    mAudioAnalysisPerSourceButton.setButtonText("Per source");
+    mAudioAnalysisPerSourceButton.setTooltip("Drive every source from its own input channel.");
+    mAudioAnalysisPerSourceButton.onClick = [this] {
+        auto perSourceComponent{ std::make_unique<PerSourceAnalysisComponent>(mAudioProcessor) };
+        auto & box = juce::CallOutBox::launchAsynchronously(std::move(perSourceComponent),
+                                                            mAudioAnalysisPerSourceButton.getScreenBounds(),
+                                                            nullptr);
+        box.setLookAndFeel(&mGrisLookAndFeel);
+    };
+
     //==============================================================================
     // Audio Analysis
 
     mDescriptorMetricLabel.setText("Metric", juce::dontSendNotification);
+    mDescriptorLoudnessWindowLabel.setText("Window", juce::dontSendNotification);
+    mDescriptorBudgetLabel.setText("Budget (us)", juce::dontSendNotification);
     mDescriptorExpanderLabel.setText("Expander", juce::dontSendNotification);
     mDescriptorThresholdLabel.setText("Threshold", juce::dontSendNotification);
     mDescriptorMinFreqLabel.setText("Min. Freq", juce::dontSendNotification);
@@ -1174,6 +1309,14 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
             case DescriptorID::noise:
                 param.setParamExpanderNoise(value);
                 break;
+            case DescriptorID::flux:
+            case DescriptorID::rolloff:
+            case DescriptorID::crest:
+            case DescriptorID::lowBandEnergy:
+            case DescriptorID::midBandEnergy:
+            case DescriptorID::highBandEnergy:
+                param.setParamExpanderSpectralFeature(value);
+                break;
             case DescriptorID::pitch:
             case DescriptorID::centroid:
             case DescriptorID::iterationsSpeed:
@@ -1181,6 +1324,7 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
             default:
                 break;
             }
+            mAudioProcessor.updateAudioAnalysisRouting();
         }
     };
 
@@ -1198,6 +1342,14 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
             case DescriptorID::noise:
                 param.setParamSmoothNoise(value);
                 break;
+            case DescriptorID::flux:
+            case DescriptorID::rolloff:
+            case DescriptorID::crest:
+            case DescriptorID::lowBandEnergy:
+            case DescriptorID::midBandEnergy:
+            case DescriptorID::highBandEnergy:
+                param.setParamSmoothSpectralFeature(value);
+                break;
             case DescriptorID::pitch:
                 param.setParamSmoothPitch(value);
                 break;
@@ -1228,6 +1380,14 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
             case DescriptorID::noise:
                 param.setParamSmoothCoefNoise(value);
                 break;
+            case DescriptorID::flux:
+            case DescriptorID::rolloff:
+            case DescriptorID::crest:
+            case DescriptorID::lowBandEnergy:
+            case DescriptorID::midBandEnergy:
+            case DescriptorID::highBandEnergy:
+                param.setParamSmoothCoefSpectralFeature(value);
+                break;
             case DescriptorID::pitch:
                 param.setParamSmoothCoefPitch(value);
                 break;
@@ -1266,11 +1426,18 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
             case DescriptorID::loudness:
             case DescriptorID::spread:
             case DescriptorID::noise:
+            case DescriptorID::flux:
+            case DescriptorID::rolloff:
+            case DescriptorID::crest:
+            case DescriptorID::lowBandEnergy:
+            case DescriptorID::midBandEnergy:
+            case DescriptorID::highBandEnergy:
             case DescriptorID::iterationsSpeed:
             case DescriptorID::invalid:
             default:
                 break;
             }
+            mAudioProcessor.updateAudioAnalysisRouting();
         }
     };
 
@@ -1296,11 +1463,18 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
             case DescriptorID::loudness:
             case DescriptorID::spread:
             case DescriptorID::noise:
+            case DescriptorID::flux:
+            case DescriptorID::rolloff:
+            case DescriptorID::crest:
+            case DescriptorID::lowBandEnergy:
+            case DescriptorID::midBandEnergy:
+            case DescriptorID::highBandEnergy:
             case DescriptorID::iterationsSpeed:
             case DescriptorID::invalid:
             default:
                 break;
             }
+            mAudioProcessor.updateAudioAnalysisRouting();
         }
     };
 
@@ -1323,6 +1497,7 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
             auto & param = mParameterToShow->get();
             param.setParamMinTime(minVal);
             mAudioProcessor.setOnsetDetectionMinTime(param.getParameterID(), minVal);
+            mAudioProcessor.updateAudioAnalysisRouting();
         }
     };
 
@@ -1337,6 +1512,7 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
             auto & param = mParameterToShow->get();
             param.setParamMaxTime(maxVal);
             mAudioProcessor.setOnsetDetectionMaxTime(param.getParameterID(), maxVal);
+            mAudioProcessor.updateAudioAnalysisRouting();
         }
     };
 
@@ -1350,6 +1526,8 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
     addAndMakeVisible(&mDescriptorMaxTimeSlider);
 
     addAndMakeVisible(&mDescriptorMetricLabel);
+    addAndMakeVisible(&mDescriptorLoudnessWindowLabel);
+    addAndMakeVisible(&mDescriptorBudgetLabel);
     addAndMakeVisible(&mDescriptorExpanderLabel);
     addAndMakeVisible(&mDescriptorThresholdLabel);
     addAndMakeVisible(&mDescriptorMinFreqLabel);
@@ -1369,6 +1547,27 @@ SectionSoundReactiveTrajectories::SectionSoundReactiveTrajectories(GrisLookAndFe
         }
     };
 
+    // The loudness is analysed once for every spatial parameter, so its window is a setting of the processor.
+    addAndMakeVisible(&mDescriptorLoudnessWindowCombo);
+    mDescriptorLoudnessWindowCombo.addItem("Momentary", static_cast<int>(LoudnessWindow::momentary) + 1);
+    mDescriptorLoudnessWindowCombo.addItem("Short-term", static_cast<int>(LoudnessWindow::shortTerm) + 1);
+    mDescriptorLoudnessWindowCombo.setTooltip("Integrate the loudness over 400 ms (momentary) or 3 s (short-term).");
+    mDescriptorLoudnessWindowCombo.onChange = [this] {
+        mAudioProcessor.setAudioAnalysisLoudnessWindow(
+            static_cast<LoudnessWindow>(mDescriptorLoudnessWindowCombo.getSelectedId() - 1));
+    };
+
+    // Shared by the pitch and shape analyses, whatever the spatial parameter.
+    addAndMakeVisible(&mDescriptorBudgetSlider);
+    mDescriptorBudgetSlider.setRange(DescriptorScheduler::MIN_BUDGET_US, DescriptorScheduler::MAX_BUDGET_US, 10.0);
+    mDescriptorBudgetSlider.setDefaultReturnValue(DescriptorScheduler::DEFAULT_BUDGET_US);
+    mDescriptorBudgetSlider.setDefaultNumDecimalPlacesToDisplay(0);
+    mDescriptorBudgetSlider.setTooltip("CPU time the pitch and spectral analyses may use on one audio block. A lower "
+                                       "budget spreads them over more blocks.");
+    mDescriptorBudgetSlider.onValueChange = [this] {
+        mAudioProcessor.setAudioAnalysisBudgetUs(mDescriptorBudgetSlider.getValue());
+    };
+
     // update the datagraph at 60fps
     startTimer(timerParamID::datagraphUpdate, 17);
 
@@ -1507,6 +1706,7 @@ void SectionSoundReactiveTrajectories::resized()
     mSpatialParameterLabel.setBounds(5, 3, 100, 15);
     mAudioAnalysisLabel.setBounds(bannerAudioAnalysis.getTopLeft().getX() + 5, 3, 80, 15);
     mAudioAnalysisSelectedDescriptor.setBounds(mAudioAnalysisLabel.getRight() + 5, 3, 80, 15);
+    mAudioAnalysisLatencyLabel.setBounds(mAudioAnalysisSelectedDescriptor.getRight() + 5, 3, 110, 15);
 
     mChannelMixLabel.setBounds(mSpatialParameterLabel.getRight() + 80, 3, 47, 15);
     mChannelMixCombo.setBounds(mChannelMixLabel.getRight(), 2, 45, 15);
@@ -1642,8 +1842,20 @@ void SectionSoundReactiveTrajectories::resized()
 
         mAudioAnalysisActivateButton.setBounds(mParameterElevationOrZSpanButton.getBounds().getBottomLeft().getX() + 70,
                                                mParameterElevationOrZSpanButton.getBounds().getBottomLeft().getY() + 17,
-                                               176,
+                                               70,
                                                20);
+        mAudioAnalysisAsyncButton.setBounds(mAudioAnalysisActivateButton.getRight() + 4,
+                                            mAudioAnalysisActivateButton.getY(),
+                                            44,
+                                            20);
+        mAudioAnalysisChannelsButton.setBounds(mAudioAnalysisAsyncButton.getRight() + 4,
+                                               mAudioAnalysisActivateButton.getY(),
+                                               56,
+                                               20);
+        mAudioAnalysisPerSourceButton.setBounds(mAudioAnalysisChannelsButton.getRight() + 4,
+                                                mAudioAnalysisActivateButton.getY(),
+                                                56,
+                                                20);
     } else {
         auto const showXRangeSlider{ Descriptor::fromInt(mParameterXDescriptorCombo.getSelectedId())
                                      != DescriptorID::invalid };
@@ -1781,8 +1993,20 @@ void SectionSoundReactiveTrajectories::resized()
 
         mAudioAnalysisActivateButton.setBounds(mParameterElevationOrZSpanButton.getBounds().getBottomLeft().getX() + 70,
                                                mParameterElevationOrZSpanButton.getBounds().getBottomLeft().getY() + 7,
-                                               176,
+                                               70,
+                                               20);
+        mAudioAnalysisAsyncButton.setBounds(mAudioAnalysisActivateButton.getRight() + 4,
+                                            mAudioAnalysisActivateButton.getY(),
+                                            44,
+                                            20);
+        mAudioAnalysisChannelsButton.setBounds(mAudioAnalysisAsyncButton.getRight() + 4,
+                                               mAudioAnalysisActivateButton.getY(),
+                                               56,
                                                20);
+        mAudioAnalysisPerSourceButton.setBounds(mAudioAnalysisChannelsButton.getRight() + 4,
+                                                mAudioAnalysisActivateButton.getY(),
+                                                56,
+                                                20);
 
         if (mXYParamLinked) {
             auto const showLapEd{ Descriptor::fromInt(mParameterXDescriptorCombo.getSelectedId())
@@ -1804,6 +2028,7 @@ void SectionSoundReactiveTrajectories::timerCallback(int timerID)
 {
     if (timerID == timerParamID::datagraphUpdate) {
         addNewParamValueToDataGraph();
+        updateAudioAnalysisLatency();
         return;
     }
 
@@ -1928,6 +2153,14 @@ void SectionSoundReactiveTrajectories::setSpatMode(SpatMode spatMode)
         case DescriptorID::noise:
             slider.setValue(param.getParamOffsetNoise());
             break;
+        case DescriptorID::flux:
+        case DescriptorID::rolloff:
+        case DescriptorID::crest:
+        case DescriptorID::lowBandEnergy:
+        case DescriptorID::midBandEnergy:
+        case DescriptorID::highBandEnergy:
+            slider.setValue(param.getParamOffsetSpectralFeature());
+            break;
         case DescriptorID::iterationsSpeed:
             slider.setValue(param.getParamOffsetOnsetDetection());
             break;
@@ -1954,6 +2187,14 @@ void SectionSoundReactiveTrajectories::setSpatMode(SpatMode spatMode)
         case DescriptorID::noise:
             slider.setValue(param.getParamRangeNoise());
             break;
+        case DescriptorID::flux:
+        case DescriptorID::rolloff:
+        case DescriptorID::crest:
+        case DescriptorID::lowBandEnergy:
+        case DescriptorID::midBandEnergy:
+        case DescriptorID::highBandEnergy:
+            slider.setValue(param.getParamRangeSpectralFeature());
+            break;
         case DescriptorID::iterationsSpeed:
             slider.setValue(param.getParamRangeOnsetDetection());
             break;
@@ -1980,6 +2221,14 @@ void SectionSoundReactiveTrajectories::setSpatMode(SpatMode spatMode)
         case DescriptorID::noise:
             ed.setText(juce::String(static_cast<int>(param.getParamLapNoise())));
             break;
+        case DescriptorID::flux:
+        case DescriptorID::rolloff:
+        case DescriptorID::crest:
+        case DescriptorID::lowBandEnergy:
+        case DescriptorID::midBandEnergy:
+        case DescriptorID::highBandEnergy:
+            ed.setText(juce::String(static_cast<int>(param.getParamLapSpectralFeature())));
+            break;
         case DescriptorID::iterationsSpeed:
             ed.setText(juce::String(static_cast<int>(param.getParamLapOnsetDetection())));
             break;
@@ -2127,7 +2376,8 @@ void SectionSoundReactiveTrajectories::addNewParamValueToDataGraph()
 {
     if (mParameterToShow) {
         auto & param{ mParameterToShow->get() };
-        auto value{ param.getValue() };
+        // The value published by the audio thread, never the live parameter it is still writing.
+        auto value{ mAudioProcessor.getTelemetryValue(toTelemetrySignal(param.getParameterID())) };
         auto lap{ mParameterLapEditor.getText().getIntValue() };
         if (lap == 0) {
             lap = 1;
@@ -2202,6 +2452,20 @@ void SectionSoundReactiveTrajectories::updateChannelMixCombo()
     mAudioProcessor.setChannelForAudioAnalysis(selectedId);
 }
 
+//==============================================================================
+void SectionSoundReactiveTrajectories::updateAudioAnalysisLatency()
+{
+    auto const isAsync{ mAudioProcessor.isAudioAnalysisAsync() };
+    mAudioAnalysisAsyncButton.setToggleState(isAsync, juce::dontSendNotification);
+
+    if (isAsync) {
+        auto const latency{ juce::String(mAudioProcessor.getAudioAnalysisLatencyMs(), 1) };
+        mAudioAnalysisLatencyLabel.setText("Latency: " + latency + " ms", juce::dontSendNotification);
+    } else {
+        mAudioAnalysisLatencyLabel.setText({}, juce::dontSendNotification);
+    }
+}
+
 //==============================================================================
 void SectionSoundReactiveTrajectories::unselectAllParamButtons()
 {
@@ -2255,6 +2519,7 @@ void SectionSoundReactiveTrajectories::refreshDescriptorPanel()
             }
             mAudioAnalysisSelectedDescriptor.setText("Loudness", juce::dontSendNotification);
             loudnessSpreadNoiseDescriptorLayout();
+            loudnessWindowLayout();
             break;
         case DescriptorID::spread:
             if (mParameterToShow) {
@@ -2265,6 +2530,7 @@ void SectionSoundReactiveTrajectories::refreshDescriptorPanel()
             }
             mAudioAnalysisSelectedDescriptor.setText("Spread", juce::dontSendNotification);
             loudnessSpreadNoiseDescriptorLayout();
+            scheduledDescriptorBudgetLayout();
             break;
         case DescriptorID::noise:
             if (mParameterToShow) {
@@ -2275,6 +2541,24 @@ void SectionSoundReactiveTrajectories::refreshDescriptorPanel()
             }
             mAudioAnalysisSelectedDescriptor.setText("Noise", juce::dontSendNotification);
             loudnessSpreadNoiseDescriptorLayout();
+            scheduledDescriptorBudgetLayout();
+            break;
+        case DescriptorID::flux:
+        case DescriptorID::rolloff:
+        case DescriptorID::crest:
+        case DescriptorID::lowBandEnergy:
+        case DescriptorID::midBandEnergy:
+        case DescriptorID::highBandEnergy:
+            if (mParameterToShow) {
+                auto & param = mParameterToShow->get();
+                mDescriptorExpanderSlider.setValue(param.getParamExpanderSpectralFeature());
+                mDescriptorSmoothSlider.setValue(param.getParamSmoothSpectralFeature());
+                mDescriptorSmoothCoefSlider.setValue(param.getParamSmoothCoefSpectralFeature());
+            }
+            mAudioAnalysisSelectedDescriptor.setText(AUDIO_DESCRIPTOR_TYPES[Descriptor::toInt(mDescriptorIdToUse) - 1],
+                                                     juce::dontSendNotification);
+            loudnessSpreadNoiseDescriptorLayout();
+            scheduledDescriptorBudgetLayout();
             break;
         case DescriptorID::pitch:
             if (mParameterToShow) {
@@ -2286,6 +2570,7 @@ void SectionSoundReactiveTrajectories::refreshDescriptorPanel()
             }
             mAudioAnalysisSelectedDescriptor.setText("Pitch", juce::dontSendNotification);
             pitchCentroidDescriptorLayout();
+            scheduledDescriptorBudgetLayout();
             break;
         case DescriptorID::centroid:
             if (mParameterToShow) {
@@ -2297,6 +2582,7 @@ void SectionSoundReactiveTrajectories::refreshDescriptorPanel()
             }
             mAudioAnalysisSelectedDescriptor.setText("Centroid", juce::dontSendNotification);
             pitchCentroidDescriptorLayout();
+            scheduledDescriptorBudgetLayout();
             break;
         case DescriptorID::iterationsSpeed:
             if (mParameterToShow) {
@@ -2367,6 +2653,46 @@ void SectionSoundReactiveTrajectories::loudnessSpreadNoiseDescriptorLayout()
     mDataGraph.setBounds(mAreaAudioAnalysis.getX() + 150, mAreaAudioAnalysis.getY() + 15, 80, 80);
 }
 
+//==============================================================================
+void SectionSoundReactiveTrajectories::loudnessWindowLayout()
+{
+    mDescriptorLoudnessWindowCombo.setSelectedId(
+        static_cast<int>(mAudioProcessor.getAudioAnalysisLoudnessWindow()) + 1,
+        juce::dontSendNotification);
+
+    mDescriptorLoudnessWindowLabel.setVisible(true);
+    mDescriptorLoudnessWindowCombo.setVisible(true);
+
+    // Takes the row of the smooth coefficient, which is not shown.
+    mDescriptorLoudnessWindowLabel.setBounds(mDescriptorSmoothLabel.getBounds().getTopLeft().getX(),
+                                             mDescriptorSmoothLabel.getBounds().getBottom() + 5,
+                                             75,
+                                             15);
+    mDescriptorLoudnessWindowCombo.setBounds(mDescriptorLoudnessWindowLabel.getBounds().getRight(),
+                                             mDescriptorLoudnessWindowLabel.getBounds().getY(),
+                                             70,
+                                             15);
+}
+
+//==============================================================================
+void SectionSoundReactiveTrajectories::scheduledDescriptorBudgetLayout()
+{
+    mDescriptorBudgetSlider.setValue(mAudioProcessor.getAudioAnalysisBudgetUs(), juce::dontSendNotification);
+
+    mDescriptorBudgetLabel.setVisible(true);
+    mDescriptorBudgetSlider.setVisible(true);
+
+    // Takes the row of the smooth coefficient, which is not shown.
+    mDescriptorBudgetLabel.setBounds(mDescriptorSmoothLabel.getBounds().getTopLeft().getX(),
+                                     mDescriptorSmoothLabel.getBounds().getBottom() + 5,
+                                     75,
+                                     15);
+    mDescriptorBudgetSlider.setBounds(mDescriptorBudgetLabel.getBounds().getRight(),
+                                      mDescriptorBudgetLabel.getBounds().getY(),
+                                      35,
+                                      12);
+}
+
 //==============================================================================
 void SectionSoundReactiveTrajectories::pitchCentroidDescriptorLayout()
 {
@@ -2503,6 +2829,8 @@ void SectionSoundReactiveTrajectories::setAudioAnalysisComponentsInvisible()
     mAudioAnalysisSelectedDescriptor.setVisible(false);
 
     mDescriptorMetricLabel.setVisible(false);
+    mDescriptorLoudnessWindowLabel.setVisible(false);
+    mDescriptorBudgetLabel.setVisible(false);
     mDescriptorExpanderLabel.setVisible(false);
     mDescriptorThresholdLabel.setVisible(false);
     mDescriptorMinFreqLabel.setVisible(false);
@@ -2513,6 +2841,7 @@ void SectionSoundReactiveTrajectories::setAudioAnalysisComponentsInvisible()
     mDescriptorSmoothCoefLabel.setVisible(false);
 
     mDescriptorMetricCombo.setVisible(false);
+    mDescriptorLoudnessWindowCombo.setVisible(false);
 
     mDescriptorExpanderSlider.setVisible(false);
     mDescriptorThresholdSlider.setVisible(false);
@@ -2522,6 +2851,7 @@ void SectionSoundReactiveTrajectories::setAudioAnalysisComponentsInvisible()
     mDescriptorMaxTimeSlider.setVisible(false);
     mDescriptorSmoothSlider.setVisible(false);
     mDescriptorSmoothCoefSlider.setVisible(false);
+    mDescriptorBudgetSlider.setVisible(false);
 
     mDataGraph.setVisible(false);
     mClickTimerButton.setVisible(false);
@@ -2552,6 +2882,112 @@ bool SectionSoundReactiveTrajectories::isAtLeastOneAudioDescriptorSelected()
     return false;
 }
 
+//==============================================================================
+AudioAnalysisChannelsComponent::AudioAnalysisChannelsComponent(GrisLookAndFeel & grisLookAndFeel,
+                                                               ControlGrisAudioProcessor & audioProcessor)
+    : mGrisLookAndFeel(grisLookAndFeel)
+    , mAudioProcessor(audioProcessor)
+{
+    auto const numChannels{ std::min(mAudioProcessor.getTotalNumInputChannels(),
+                                     AudioAnalysisMixdown::MAX_NUM_WEIGHTED_CHANNELS) };
+
+    for (int channel{}; channel < numChannels; ++channel) {
+        auto * enableButton{ mChannelEnableButtons.add(std::make_unique<juce::ToggleButton>()) };
+        enableButton->setButtonText(juce::String(channel + 1));
+        enableButton->setToggleState(mAudioProcessor.isAudioAnalysisChannelEnabled(channel),
+                                     juce::dontSendNotification);
+        enableButton->onClick = [this, channel, enableButton] {
+            mAudioProcessor.setAudioAnalysisChannelEnabled(channel, enableButton->getToggleState());
+        };
+        mRows.addAndMakeVisible(enableButton);
+
+        auto * weightSlider{ mChannelWeightSliders.add(std::make_unique<NumSlider>(mGrisLookAndFeel)) };
+        weightSlider->setNumDecimalPlacesToDisplay(2);
+        weightSlider->setRange(0.0, 4.0, 0.01);
+        weightSlider->setDefaultReturnValue(1.0);
+        weightSlider->setValue(mAudioProcessor.getAudioAnalysisChannelWeight(channel), juce::dontSendNotification);
+        weightSlider->onValueChange = [this, channel, weightSlider] {
+            mAudioProcessor.setAudioAnalysisChannelWeight(channel, static_cast<float>(weightSlider->getValue()));
+        };
+        mRows.addAndMakeVisible(weightSlider);
+    }
+
+    mViewport.setViewedComponent(&mRows, false);
+    mViewport.setScrollBarsShown(true, false);
+    addAndMakeVisible(&mViewport);
+
+    auto const numVisibleRows{ juce::jlimit(1, MAX_VISIBLE_ROWS, numChannels) };
+    setSize(100 + mViewport.getScrollBarThickness(), numVisibleRows * ROW_HEIGHT + 4);
+}
+
+//==============================================================================
+void AudioAnalysisChannelsComponent::paint(juce::Graphics & g)
+{
+    g.fillAll(mGrisLookAndFeel.getBackgroundColor());
+}
+
+//==============================================================================
+void AudioAnalysisChannelsComponent::resized()
+{
+    mViewport.setBounds(getLocalBounds().reduced(2));
+    mRows.setSize(mViewport.getMaximumVisibleWidth(), mChannelEnableButtons.size() * ROW_HEIGHT);
+
+    for (int row{}; row < mChannelEnableButtons.size(); ++row) {
+        mChannelEnableButtons[row]->setBounds(0, row * ROW_HEIGHT, 50, ROW_HEIGHT - 2);
+        mChannelWeightSliders[row]->setBounds(55, row * ROW_HEIGHT + 2, 40, ROW_HEIGHT - 6);
+    }
+}
+
+//==============================================================================
+PerSourceAnalysisComponent::PerSourceAnalysisComponent(ControlGrisAudioProcessor & audioProcessor)
+    : mAudioProcessor(audioProcessor)
+{
+    mActivateButton.setButtonText("Per source analysis");
+    mActivateButton.setToggleState(mAudioProcessor.isPerSourceAnalysisOn(), juce::dontSendNotification);
+    mActivateButton.setTooltip("Input channel N drives source N. While the spatial parameters are driven by the "
+                               "main analysis, the primary source follows them instead.");
+    mActivateButton.onClick = [this] { mAudioProcessor.setPerSourceAnalysisOn(mActivateButton.getToggleState()); };
+    addAndMakeVisible(&mActivateButton);
+
+    // The ids of the items are the values of the enums plus one.
+    mDescriptorLabel.setText("Descriptor", juce::dontSendNotification);
+    addAndMakeVisible(&mDescriptorLabel);
+    mDescriptorCombo.addItem("Loudness", static_cast<int>(PerSourceDescriptor::loudness) + 1);
+    mDescriptorCombo.addItem("RMS frequency", static_cast<int>(PerSourceDescriptor::rmsFrequency) + 1);
+    mDescriptorCombo.setSelectedId(static_cast<int>(mAudioProcessor.getPerSourceAnalysisDescriptor()) + 1,
+                                   juce::dontSendNotification);
+    mDescriptorCombo.onChange = [this] {
+        mAudioProcessor.setPerSourceAnalysisDescriptor(
+            static_cast<PerSourceDescriptor>(mDescriptorCombo.getSelectedId() - 1));
+    };
+    addAndMakeVisible(&mDescriptorCombo);
+
+    mTargetLabel.setText("Target", juce::dontSendNotification);
+    addAndMakeVisible(&mTargetLabel);
+    mTargetCombo.addItem("Azimuth", static_cast<int>(PerSourceTarget::azimuth) + 1);
+    mTargetCombo.addItem("Elevation", static_cast<int>(PerSourceTarget::elevation) + 1);
+    mTargetCombo.addItem("Azimuth Span", static_cast<int>(PerSourceTarget::azimuthSpan) + 1);
+    mTargetCombo.addItem("Elevation Span", static_cast<int>(PerSourceTarget::elevationSpan) + 1);
+    mTargetCombo.setSelectedId(static_cast<int>(mAudioProcessor.getPerSourceAnalysisTarget()) + 1,
+                               juce::dontSendNotification);
+    mTargetCombo.onChange = [this] {
+        mAudioProcessor.setPerSourceAnalysisTarget(static_cast<PerSourceTarget>(mTargetCombo.getSelectedId() - 1));
+    };
+    addAndMakeVisible(&mTargetCombo);
+
+    setSize(190, 64);
+}
+
+//==============================================================================
+void PerSourceAnalysisComponent::resized()
+{
+    mActivateButton.setBounds(2, 2, 186, 18);
+    mDescriptorLabel.setBounds(2, 24, 70, 15);
+    mDescriptorCombo.setBounds(74, 24, 114, 15);
+    mTargetLabel.setBounds(2, 44, 70, 15);
+    mTargetCombo.setBounds(74, 44, 114, 15);
+}
+
 //==============================================================================
 DataGraph::DataGraph(GrisLookAndFeel & grisLookAndFeel) : mGrisLookAndFeel(grisLookAndFeel)
 {
@@ -2582,8 +3018,8 @@ void DataGraph::paint(juce::Graphics & g)
             float initialX{}, initialY{}, width{}, height{};
             float valueToPaint{ static_cast<float>(mGUIBuffer.at(i)) };
 
-            if (mDescId == DescriptorID::loudness || mDescId == DescriptorID::spread
-                || mDescId == DescriptorID::noise) {
+            if (mDescId == DescriptorID::loudness || mDescId == DescriptorID::spread || mDescId == DescriptorID::noise
+                || Descriptor::isSpectralFeature(mDescId)) {
                 // parameter has an offset option, the graph can have negative values
                 initialX
                     = ((static_cast<float>(area.getWidth()) / static_cast<float>(mGUIBuffer.size())) * i) + area.getX();
@@ -2634,18 +3070,17 @@ void DataGraph::timerCallback()
 //==============================================================================
 void DataGraph::addToBuffer(double value)
 {
-    mBuffer = mBuffer.get() + value;
+    mBuffer += value;
     ++mBufferCount;
 }
 
 //==============================================================================
 double DataGraph::readBufferMean()
 {
-    // this is called by the timer thread.
     double mean{};
 
-    if (mBufferCount.get() > 0) {
-        mean = mBuffer.get() / mBufferCount.get();
+    if (mBufferCount > 0) {
+        mean = mBuffer / mBufferCount;
         mBuffer = 0.0;
         mBufferCount = 0;
     }
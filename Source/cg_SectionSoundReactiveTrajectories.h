@@ -47,6 +47,7 @@ public:
     void resized() override;
     void timerCallback() override;
 
+    // Message thread only. Values are averaged until the next point of the graph is drawn.
     void addToBuffer(double value);
     double readBufferMean();
     void setDescriptor(DescriptorID descId);
@@ -56,13 +57,67 @@ private:
     GrisLookAndFeel & mGrisLookAndFeel;
     DescriptorID mDescId;
     std::deque<double> mGUIBuffer;
-    juce::Atomic<double> mBuffer{};
-    juce::Atomic<int> mBufferCount{};
+    double mBuffer{};
+    int mBufferCount{};
 
     //==============================================================================
     JUCE_LEAK_DETECTOR(DataGraph)
 }; // class DataGraph
 
+//==============================================================================
+// Lets the user weight or mute each input channel of the "Mix" analysis channel. Shown in a CallOutBox.
+class AudioAnalysisChannelsComponent final : public juce::Component
+{
+public:
+    //==============================================================================
+    static constexpr int ROW_HEIGHT{ 18 };
+    static constexpr int MAX_VISIBLE_ROWS{ 12 };
+
+    AudioAnalysisChannelsComponent(GrisLookAndFeel & grisLookAndFeel, ControlGrisAudioProcessor & audioProcessor);
+    ~AudioAnalysisChannelsComponent() override = default;
+
+    void paint(juce::Graphics &) override;
+    void resized() override;
+
+private:
+    //==============================================================================
+    GrisLookAndFeel & mGrisLookAndFeel;
+    ControlGrisAudioProcessor & mAudioProcessor;
+
+    juce::Viewport mViewport;
+    juce::Component mRows;
+    juce::OwnedArray<juce::ToggleButton> mChannelEnableButtons;
+    juce::OwnedArray<NumSlider> mChannelWeightSliders;
+
+    //==============================================================================
+    JUCE_LEAK_DETECTOR(AudioAnalysisChannelsComponent)
+}; // class AudioAnalysisChannelsComponent
+
+//==============================================================================
+// Settings of the analysis that drives every source from its own input channel. Shown in a CallOutBox.
+class PerSourceAnalysisComponent final : public juce::Component
+{
+public:
+    //==============================================================================
+    explicit PerSourceAnalysisComponent(ControlGrisAudioProcessor & audioProcessor);
+    ~PerSourceAnalysisComponent() override = default;
+
+    void resized() override;
+
+private:
+    //==============================================================================
+    ControlGrisAudioProcessor & mAudioProcessor;
+
+    juce::ToggleButton mActivateButton;
+    juce::Label mDescriptorLabel;
+    juce::ComboBox mDescriptorCombo;
+    juce::Label mTargetLabel;
+    juce::ComboBox mTargetCombo;
+
+    //==============================================================================
+    JUCE_LEAK_DETECTOR(PerSourceAnalysisComponent)
+}; // class PerSourceAnalysisComponent
+
 //==============================================================================
 class SectionSoundReactiveTrajectories final
     : public juce::Component
@@ -133,11 +188,15 @@ private:
     TextEd mParameterLapEditor{ mGrisLookAndFeel };
 
     juce::TextButton mAudioAnalysisActivateButton;
+    juce::TextButton mAudioAnalysisAsyncButton;
+    juce::TextButton mAudioAnalysisChannelsButton;
+    juce::TextButton mAudioAnalysisPerSourceButton;
 
     //==============================================================================
     // Audio anaylysis section
     juce::Label mAudioAnalysisLabel;
     juce::Label mAudioAnalysisSelectedDescriptor;
+    juce::Label mAudioAnalysisLatencyLabel;
     std::optional<std::reference_wrapper<SpatialParameter>> mParameterToShow;
     DescriptorID mDescriptorIdToUse{ DescriptorID::invalid };
     DataGraph mDataGraph;
@@ -151,8 +210,11 @@ private:
     juce::Label mDescriptorSmoothLabel;
     juce::Label mDescriptorSmoothCoefLabel;
     juce::Label mDescriptorMetricLabel;
+    juce::Label mDescriptorLoudnessWindowLabel;
+    juce::Label mDescriptorBudgetLabel;
 
     juce::ComboBox mDescriptorMetricCombo;
+    juce::ComboBox mDescriptorLoudnessWindowCombo;
 
     NumSlider mDescriptorExpanderSlider;
     NumSlider mDescriptorThresholdSlider;
@@ -162,6 +224,7 @@ private:
     NumSlider mDescriptorMaxTimeSlider;
     NumSlider mDescriptorSmoothSlider;
     NumSlider mDescriptorSmoothCoefSlider;
+    NumSlider mDescriptorBudgetSlider;
 
     juce::TextButton mClickTimerButton;
 
@@ -204,6 +267,7 @@ public:
     void setAudioAnalysisActivateState(bool state);
 
     void updateChannelMixCombo();
+    void updateAudioAnalysisLatency();
 
 private:
     //==============================================================================
@@ -212,6 +276,8 @@ private:
     void setAllComboBoxesColorOFF();
     void refreshDescriptorPanel();
     void loudnessSpreadNoiseDescriptorLayout();
+    void loudnessWindowLayout();
+    void scheduledDescriptorBudgetLayout();
     void pitchCentroidDescriptorLayout();
     void iterSpeedDescriptorLayout();
     void setAudioAnalysisComponentsInvisible();
@@ -36,6 +36,7 @@ bool Source::shouldForceNotifications(Source::OriginOfChange const origin) const
     case Source::OriginOfChange::osc:
     case Source::OriginOfChange::audioAnalysis:
     case Source::OriginOfChange::audioAnalysisRecAutomation:
+    case Source::OriginOfChange::audioAnalysisPerSource:
         return false;
     case Source::OriginOfChange::trajectory:
     case Source::OriginOfChange::link:
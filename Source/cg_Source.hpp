@@ -123,7 +123,8 @@ public:
         presetRecall,
         osc,
         audioAnalysis,
-        audioAnalysisRecAutomation
+        audioAnalysisRecAutomation,
+        audioAnalysisPerSource
     };
     enum class ChangeType { position, elevation };
 
@@ -0,0 +1,141 @@
+/*
+ This file is part of ControlGris.
+
+ Developers: Hicheme BEN GAIED, Gaël LANE LÉPINE
+
+ ControlGris is free software: you can redistribute it and/or modify
+ it under the terms of the GNU Lesser General Public License as
+ published by the Free Software Foundation, either version 3 of the
+ License, or (at your option) any later version.
+
+ ControlGris is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with ControlGris.  If not, see
+ <http://www.gnu.org/licenses/>.
+*/
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "SpatialParameters/cg_SpatialParameter.h"
+
+#include <array>
+#include <atomic>
+
+namespace gris
+{
+//==============================================================================
+/** The audio descriptors followed by the spatial parameters, in ParameterID order. */
+enum class TelemetrySignal {
+    loudness = 0,
+    pitch,
+    centroid,
+    spread,
+    flatness,
+    flux,
+    rolloff,
+    crest,
+    lowBandEnergy,
+    midBandEnergy,
+    highBandEnergy,
+    azimuth,
+    elevation,
+    x,
+    y,
+    z,
+    azimuthSpan,
+    elevationSpan,
+    count
+};
+
+inline TelemetrySignal toTelemetrySignal(ParameterID const paramID)
+{
+    jassert(paramID != ParameterID::invalid);
+    return static_cast<TelemetrySignal>(static_cast<int>(TelemetrySignal::azimuth) + static_cast<int>(paramID));
+}
+
+inline char const * getTelemetrySignalName(TelemetrySignal const signal)
+{
+    static constexpr std::array<char const *, static_cast<size_t>(TelemetrySignal::count)> NAMES{
+        "loudness", "pitch", "centroid", "spread",  "flatness", "flux", "rolloff", "crest", "lowband",
+        "midband",  "highband", "azimuth", "elevation", "x", "y",       "z",       "azispan", "elespan"
+    };
+    return NAMES[static_cast<size_t>(signal)];
+}
+
+//==============================================================================
+struct TelemetryEvent {
+    // Position of the block that produced the value, in samples since prepareToPlay().
+    juce::uint64 sampleTime{};
+    TelemetrySignal signal{};
+    float value{};
+};
+
+//==============================================================================
+/** Wait-free single producer, single consumer ring of the values that drive the sources.
+ *
+ * The audio thread publishes, one thread drains at its own pace. When the ring is full the new events are dropped
+ * and counted, the producer never waits.
+ */
+class TelemetryBus
+{
+public:
+    //==============================================================================
+    static constexpr juce::uint32 CAPACITY{ 4096 };
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "The capacity must be a power of two.");
+
+    //==============================================================================
+    TelemetryBus() = default;
+
+    //==============================================================================
+    // Producer
+    bool publish(TelemetrySignal signal, float value, juce::uint64 sampleTime) noexcept
+    {
+        auto const writeIndex{ mWriteIndex.load(std::memory_order_relaxed) };
+        if (writeIndex - mReadIndex.load(std::memory_order_acquire) >= CAPACITY) {
+            mNumDroppedEvents.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        mEvents[writeIndex & MASK] = TelemetryEvent{ sampleTime, signal, value };
+        mWriteIndex.store(writeIndex + 1, std::memory_order_release);
+        return true;
+    }
+
+    //==============================================================================
+    // Consumer
+    /** Calls callback(TelemetryEvent const &) on every pending event, oldest first. Returns the number of events. */
+    template<typename Callback>
+    int drain(Callback && callback)
+    {
+        auto const readIndex{ mReadIndex.load(std::memory_order_relaxed) };
+        auto const writeIndex{ mWriteIndex.load(std::memory_order_acquire) };
+        for (auto i{ readIndex }; i != writeIndex; ++i) {
+            callback(mEvents[i & MASK]);
+        }
+        mReadIndex.store(writeIndex, std::memory_order_release);
+        return static_cast<int>(writeIndex - readIndex);
+    }
+
+    juce::uint64 getNumDroppedEvents() const { return mNumDroppedEvents.load(std::memory_order_relaxed); }
+
+private:
+    //==============================================================================
+    static constexpr juce::uint32 MASK{ CAPACITY - 1 };
+
+    std::array<TelemetryEvent, CAPACITY> mEvents{};
+    // Kept on separate cache lines so that the two threads do not invalidate each other's index.
+    alignas(64) std::atomic<juce::uint32> mWriteIndex{};
+    alignas(64) std::atomic<juce::uint32> mReadIndex{};
+    std::atomic<juce::uint64> mNumDroppedEvents{};
+
+    //==============================================================================
+    JUCE_LEAK_DETECTOR(TelemetryBus)
+};
+} // namespace gris
@@ -20,59 +20,66 @@
 
 #include "cg_Trajectory.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <utility>
+#include <vector>
 
 #include "cg_Source.hpp"
 
 namespace gris
 {
+// Enough for the corners of the square and of the triangle to fall on the path.
+constexpr int NUM_SHAPE_PATH_SEGMENTS{ 300 };
+
 //==============================================================================
 Trajectory::Trajectory(PositionTrajectoryType const trajectoryType, juce::Point<float> const & startingPoint) noexcept
     : mIsElevationDrawing(false)
 {
     switch (trajectoryType) {
     case PositionTrajectoryType::circleClockwise:
-        mPoints = getBasicCirclePoints();
+        setShape<CircleShape>();
         break;
     case PositionTrajectoryType::circleCounterClockwise:
-        mPoints = getBasicCirclePoints();
+        setShape<CircleShape>();
         invertDirection();
         break;
     case PositionTrajectoryType::ellipseClockwise:
-        mPoints = getBasicEllipsePoints();
+        setShape<EllipseShape>();
         break;
     case PositionTrajectoryType::ellipseCounterClockwise:
-        mPoints = getBasicEllipsePoints();
+        setShape<EllipseShape>();
         invertDirection();
         break;
     case PositionTrajectoryType::spiralClockwiseInOut:
-        mPoints = getBasicSpiralPoints();
+        setShape<SpiralShape>();
         flipOnHorizontalAxis();
         break;
     case PositionTrajectoryType::spiralCounterClockwiseInOut:
-        mPoints = getBasicSpiralPoints();
+        setShape<SpiralShape>();
         break;
     case PositionTrajectoryType::spiralClockwiseOutIn:
-        mPoints = getBasicSpiralPoints();
+        setShape<SpiralShape>();
         flipOnHorizontalAxis();
         invertDirection();
         break;
     case PositionTrajectoryType::spiralCounterClockwiseOutIn:
-        mPoints = getBasicSpiralPoints();
+        setShape<SpiralShape>();
         invertDirection();
         break;
     case PositionTrajectoryType::squareClockwise:
-        mPoints = getBasicSquarePoints();
+        setShape<SquareShape>();
         break;
     case PositionTrajectoryType::squareCounterClockwise:
-        mPoints = getBasicSquarePoints();
+        setShape<SquareShape>();
         invertDirection();
         break;
     case PositionTrajectoryType::triangleClockwise:
-        mPoints = getBasicTrianglePoints();
+        setShape<TriangleShape>();
         break;
     case PositionTrajectoryType::triangleCounterClockwise:
-        mPoints = getBasicTrianglePoints();
+        setShape<TriangleShape>();
         invertDirection();
         break;
     case PositionTrajectoryType::drawing:
@@ -95,10 +102,10 @@ Trajectory::Trajectory(ElevationTrajectoryType const trajectoryType) noexcept
 {
     switch (trajectoryType) {
     case ElevationTrajectoryType::downUp:
-        mPoints = getBasicDownUpPoints();
+        setShape<DownUpShape>();
         break;
     case ElevationTrajectoryType::upDown:
-        mPoints = getBasicDownUpPoints();
+        setShape<DownUpShape>();
         flipOnHorizontalAxis();
         break;
     case ElevationTrajectoryType::drawing:
@@ -123,18 +130,66 @@ juce::Path Trajectory::getDrawablePath(juce::Rectangle<float> const & drawArea,
     };
 
     juce::Path result{};
-    if (!mPoints.isEmpty()) {
-        result.startNewSubPath(trajectoryPositionToComponentPosition(mPoints.getReference(0)));
+    if (isShape()) {
+        result.startNewSubPath(trajectoryPositionToComponentPosition(getPosition(Normalized{ 0.0f })));
+        for (int i{ 1 }; i <= NUM_SHAPE_PATH_SEGMENTS; ++i) {
+            Normalized const progression{ static_cast<float>(i) / static_cast<float>(NUM_SHAPE_PATH_SEGMENTS) };
+            result.lineTo(trajectoryPositionToComponentPosition(getPosition(progression)));
+        }
+    } else if (!mPoints.isEmpty()) {
+        // The points of an elevation drawing are only spaced on the x axis when the gesture ends.
+        auto const isSpacingPending{ mIsElevationDrawing && mNumFinishedPoints < mPoints.size() };
+        auto const getPoint = [&](int const index) {
+            if (!isSpacingPending || mPoints.size() < 2) {
+                return mPoints.getReference(index);
+            }
+            auto const x{ static_cast<float>(index) / static_cast<float>(mPoints.size() - 1) * 2.0f - 1.0f };
+            return juce::Point<float>{ x, mPoints.getReference(index).getY() };
+        };
+
+        result.startNewSubPath(trajectoryPositionToComponentPosition(getPoint(0)));
         for (int i{ 1 }; i < mPoints.size(); ++i) {
-            result.lineTo(trajectoryPositionToComponentPosition(mPoints.getReference(i)));
+            result.lineTo(trajectoryPositionToComponentPosition(getPoint(i)));
         }
     }
     return result;
 }
 
+//==============================================================================
+juce::Point<float> Trajectory::getStartPosition() const
+{
+    return isShape() ? getPosition(Normalized{ 0.0f }) : mPoints.getReference(0);
+}
+
+//==============================================================================
+juce::Point<float> Trajectory::getEndPosition() const
+{
+    return isShape() ? getPosition(Normalized{ 1.0f }) : mPoints.getReference(mPoints.size() - 1);
+}
+
 //==============================================================================
 juce::Point<float> Trajectory::getPosition(Normalized const normalized) const
 {
+    if (isShape()) {
+        auto const t{ mIsShapeReversed ? 1.0f - normalized.get() : normalized.get() };
+        return mShape(t, mIsConstantSpeed).transformedBy(mShapeTransform);
+    }
+
+    if (hasPositionTable()) {
+        auto const length{ normalized.get() * mCumulativeLengths.getLast() };
+        auto const * lengths{ mCumulativeLengths.begin() };
+        auto const index_b{ juce::jlimit(
+            1,
+            mPoints.size() - 1,
+            static_cast<int>(std::upper_bound(lengths, mCumulativeLengths.end(), length) - lengths)) };
+        auto const index_a{ index_b - 1 };
+        auto const segmentLength{ lengths[index_b] - lengths[index_a] };
+        auto const balance{ segmentLength > 0.0f ? juce::jlimit(0.0f, 1.0f, (length - lengths[index_a]) / segmentLength)
+                                                 : 0.0f };
+
+        return mPoints.getReference(index_a) * (1.0f - balance) + mPoints.getReference(index_b) * balance;
+    }
+
     auto const nbPoints{ static_cast<float>(mPoints.size()) };
     auto const index_f{ (nbPoints - 1.0f) * normalized.get() };
     auto const index_a{ static_cast<int>(std::floor(index_f)) };
@@ -150,202 +205,184 @@ juce::Point<float> Trajectory::getPosition(Normalized const normalized) const
 }
 
 //==============================================================================
-void Trajectory::addPoint(juce::Point<float> const & point)
+void Trajectory::setConstantSpeed(bool const shouldBeConstantSpeed)
 {
-    mPoints.add(point);
-
-    // elevation drawing works differently. We need to space the points evenly on the x axis.
-    if (mIsElevationDrawing && mPoints.size() > 1) {
-        constexpr auto FIELD_WIDTH{ 2.0f }; // space between [ -1, 1 ]
-        auto const distanceBetweenPoints{ FIELD_WIDTH / (static_cast<float>(mPoints.size() - 1)) };
-        constexpr auto FIELD_X_START{ -1.0f };
-        float x{ FIELD_X_START };
-        for (auto & it : mPoints) {
-            it.setX(x);
-            x += distanceBetweenPoints;
-        }
+    mIsConstantSpeed = shouldBeConstantSpeed;
+    mVersion = getNextVersion();
+    if (mIsConstantSpeed && !isShape() && !mIsElevationDrawing) {
+        computeCumulativeLengths();
+    } else if (!mIsElevationDrawing) {
+        mCumulativeLengths.clear();
     }
 }
 
 //==============================================================================
-void Trajectory::invertDirection()
+void Trajectory::computeCumulativeLengths()
 {
-    for (int front{}, back{ mPoints.size() - 1 }; front < back; ++front, --back) {
-        mPoints.swap(front, back);
+    mCumulativeLengths.clearQuick();
+    mCumulativeLengths.ensureStorageAllocated(mPoints.size());
+    auto length{ 0.0f };
+    for (int i{}; i < mPoints.size(); ++i) {
+        if (mIsElevationDrawing) {
+            // The x axis of an elevation drawing stands for time.
+            length = mPoints.getReference(i).getX() - mPoints.getReference(0).getX();
+        } else if (i > 0) {
+            length += mPoints.getReference(i - 1).getDistanceFrom(mPoints.getReference(i));
+        }
+        mCumulativeLengths.add(length);
     }
 }
 
 //==============================================================================
-void Trajectory::flipOnHorizontalAxis()
+bool Trajectory::hasPositionTable() const
 {
-    for (auto & point : mPoints) {
-        point.setY(-point.getY());
-    }
+    return mPoints.size() > 1 && mCumulativeLengths.size() == mPoints.size() && mCumulativeLengths.getLast() > 0.0f;
 }
 
 //==============================================================================
-void Trajectory::rotate(Radians const angle)
+void Trajectory::clear()
 {
-    for (auto & point : mPoints) {
-        point = point.rotatedAboutOrigin(angle.getAsRadians());
-    }
+    mShape = nullptr;
+    mNumShapePoints = 0;
+    mIsShapeReversed = false;
+    mShapeTransform = juce::AffineTransform{};
+    mPoints.clear();
+    mCumulativeLengths.clear();
+    mNumFinishedPoints = 0;
+    mNumRecordedPoints = 0;
+    mVersion = getNextVersion();
 }
 
 //==============================================================================
-void Trajectory::scale(float magnitude)
+void Trajectory::addPoint(juce::Point<float> const & point)
 {
-    for (auto & point : mPoints) {
-        point *= magnitude;
+    mPoints.add(point);
+    ++mNumRecordedPoints;
+    mVersion = getNextVersion();
+
+    if (mIsElevationDrawing) {
+        // Interpolated by index, which matches the final spacing, until finishRecording() is called.
+        mCumulativeLengths.clearQuick();
+        return;
     }
+    if (!mIsConstantSpeed) {
+        return;
+    }
+    // Any other drawing only grows at its end, so the table is extended rather than rebuilt.
+    auto const size{ mPoints.size() };
+    auto const segmentLength{ size > 1 ? mPoints.getReference(size - 2).getDistanceFrom(mPoints.getReference(size - 1))
+                                       : 0.0f };
+    mCumulativeLengths.add(size > 1 ? mCumulativeLengths.getLast() + segmentLength : 0.0f);
 }
 
 //==============================================================================
-juce::Array<juce::Point<float>> Trajectory::getBasicCirclePoints()
+void Trajectory::finishRecording(float const tolerance)
 {
-    constexpr int NB_POINTS = 300;
-
-    juce::Array<juce::Point<float>> result{};
-    result.ensureStorageAllocated(NB_POINTS);
-    for (int i{}; i < NB_POINTS; ++i) {
-        auto const angle{ static_cast<float>(i) / static_cast<float>(NB_POINTS) * juce::MathConstants<float>::twoPi };
-        result.add(juce::Point<float>{ std::cos(angle), std::sin(angle) });
+    if (isShape() || mNumFinishedPoints == mPoints.size()) {
+        return;
     }
 
-    return result;
+    if (mIsElevationDrawing) {
+        // Respacing moves every point, so whatever was already simplified has to be simplified again.
+        mNumFinishedPoints = 0;
+        spaceElevationPoints();
+    }
+    // When the speed follows the density of the points, removing points would change the timing of the drawing.
+    if (mIsElevationDrawing || mIsConstantSpeed) {
+        simplify(std::max(mNumFinishedPoints - 1, 0), tolerance);
+        computeCumulativeLengths();
+    }
+    mNumFinishedPoints = mPoints.size();
+    mVersion = getNextVersion();
 }
 
 //==============================================================================
-juce::Array<juce::Point<float>> Trajectory::getBasicEllipsePoints()
+void Trajectory::spaceElevationPoints()
 {
-    // just squish a circle!
-    juce::Array<juce::Point<float>> result(getBasicCirclePoints());
-    for (auto & point : result) {
-        point.setY(point.getY() * 0.5f);
+    if (mPoints.size() < 2) {
+        return;
+    }
+    constexpr auto FIELD_WIDTH{ 2.0f }; // space between [ -1, 1 ]
+    constexpr auto FIELD_X_START{ -1.0f };
+    auto const distanceBetweenPoints{ FIELD_WIDTH / (static_cast<float>(mPoints.size() - 1)) };
+    for (int i{}; i < mPoints.size(); ++i) {
+        mPoints.getReference(i).setX(FIELD_X_START + static_cast<float>(i) * distanceBetweenPoints);
     }
-
-    return result;
 }
 
 //==============================================================================
-juce::Array<juce::Point<float>> Trajectory::getBasicSpiralPoints()
+void Trajectory::simplify(int const first, float const tolerance)
 {
-    constexpr int NB_ROTATIONS = 3;
-    constexpr int NB_POINTS_PER_ROTATION = 100;
-    constexpr int NB_POINTS = NB_ROTATIONS * NB_POINTS_PER_ROTATION;
-
-    constexpr float angleStep{ juce::MathConstants<float>::twoPi / static_cast<float>(NB_POINTS_PER_ROTATION) };
-    constexpr float radiusStep{ 1.0f / static_cast<float>(NB_POINTS) };
-
-    juce::Array<juce::Point<float>> result{};
-    result.ensureStorageAllocated(NB_POINTS);
-
-    float radius{};
-    float angle{};
+    // Ramer-Douglas-Peucker, with an explicit stack of the ranges left to split.
+    auto const last{ mPoints.size() - 1 };
+    if (last - first < 2) {
+        return;
+    }
 
-    for (int i{}; i < NB_POINTS; ++i) {
-        result.add(juce::Point<float>{ std::cos(angle) * radius, std::sin(angle) * radius });
-        radius += radiusStep;
-        angle += angleStep;
+    std::vector<bool> keep(static_cast<size_t>(last - first + 1), false);
+    keep.front() = true;
+    keep.back() = true;
+    std::vector<std::pair<int, int>> ranges{ { first, last } };
+    while (!ranges.empty()) {
+        auto const [start, end] = ranges.back();
+        ranges.pop_back();
+
+        juce::Line<float> const segment{ mPoints.getReference(start), mPoints.getReference(end) };
+        auto maxDistance{ tolerance };
+        auto farthest{ -1 };
+        for (int i{ start + 1 }; i < end; ++i) {
+            juce::Point<float> pointOnSegment{};
+            auto const distance{ segment.getDistanceFromPoint(mPoints.getReference(i), pointOnSegment) };
+            if (distance > maxDistance) {
+                maxDistance = distance;
+                farthest = i;
+            }
+        }
+        if (farthest >= 0) {
+            keep[static_cast<size_t>(farthest - first)] = true;
+            ranges.emplace_back(start, farthest);
+            ranges.emplace_back(farthest, end);
+        }
     }
 
-    return result;
+    auto numKept{ first + 1 };
+    for (int i{ first + 1 }; i <= last; ++i) {
+        if (keep[static_cast<size_t>(i - first)]) {
+            mPoints.setUnchecked(numKept++, mPoints.getReference(i));
+        }
+    }
+    mPoints.removeRange(numKept, mPoints.size() - numKept);
 }
 
 //==============================================================================
-juce::Array<juce::Point<float>> Trajectory::getBasicSquarePoints()
+void Trajectory::invertDirection()
 {
-    constexpr int NB_POINTS_PER_SIDE = 75;
-    constexpr int NB_POINTS = NB_POINTS_PER_SIDE * 4;
-
-    constexpr float STEP = 1.0f / NB_POINTS_PER_SIDE;
-
-    constexpr juce::Point<float> startingPoint{ 1.0f, 0.0f };
-    constexpr juce::Point<float> step_up_left{ -STEP, STEP };
-    constexpr juce::Point<float> step_down_left{ -STEP, -STEP };
-    constexpr juce::Point<float> step_down_right{ STEP, -STEP };
-    constexpr juce::Point<float> step_up_right{ STEP, STEP };
-
-    auto currentPoint{ startingPoint };
-
-    juce::Array<juce::Point<float>> result{};
-    result.ensureStorageAllocated(NB_POINTS);
-
-    for (int i{}; i < NB_POINTS_PER_SIDE; ++i) {
-        result.add(currentPoint);
-        currentPoint += step_up_left;
-    }
-    for (int i{}; i < NB_POINTS_PER_SIDE; ++i) {
-        result.add(currentPoint);
-        currentPoint += step_down_left;
-    }
-    for (int i{}; i < NB_POINTS_PER_SIDE; ++i) {
-        result.add(currentPoint);
-        currentPoint += step_down_right;
-    }
-    for (int i{}; i < NB_POINTS_PER_SIDE; ++i) {
-        result.add(currentPoint);
-        currentPoint += step_up_right;
-    }
-
-    return result;
+    mIsShapeReversed = !mIsShapeReversed;
 }
 
 //==============================================================================
-juce::Array<juce::Point<float>> Trajectory::getBasicTrianglePoints()
+void Trajectory::flipOnHorizontalAxis()
 {
-    constexpr int NB_POINTS_PER_SIDE = 100;
-    constexpr int NB_POINTS = NB_POINTS_PER_SIDE * 3;
-
-    constexpr float sqrt3{ 1.73205080757f };
-    constexpr float sideLength{ sqrt3 }; // that's just how equilateral triangles work!
-    constexpr juce::Point<float> initialPoint{ 1.0f, 0.0f };
-    constexpr auto step{ sideLength / static_cast<float>(NB_POINTS_PER_SIDE) };
-
-    constexpr auto up_left_slope{ Degrees{ 150.0f }.getAsRadians() };
-    constexpr auto up_right_slope{ Degrees{ 30.0f }.getAsRadians() };
-
-    juce::Point<float> const up_left_step{ std::cos(up_left_slope) * step, std::sin(up_left_slope) * step };
-    juce::Point<float> const up_right_step{ std::cos(up_right_slope) * step, std::sin(up_right_slope) * step };
-    constexpr juce::Point<float> down_step{ 0.0f, -step };
-
-    juce::Array<juce::Point<float>> result{};
-    result.ensureStorageAllocated(NB_POINTS);
-
-    auto currentPoint{ initialPoint };
-    for (int i{}; i < NB_POINTS_PER_SIDE; ++i) {
-        result.add(currentPoint);
-        currentPoint += up_left_step;
-    }
-    for (int i{}; i < NB_POINTS_PER_SIDE; ++i) {
-        result.add(currentPoint);
-        currentPoint += down_step;
-    }
-    for (int i{}; i < NB_POINTS_PER_SIDE; ++i) {
-        result.add(currentPoint);
-        currentPoint += up_right_step;
-    }
-
-    return result;
+    mShapeTransform = mShapeTransform.scaled(1.0f, -1.0f);
 }
 
 //==============================================================================
-juce::Array<juce::Point<float>> Trajectory::getBasicDownUpPoints()
+void Trajectory::rotate(Radians const angle)
 {
-    constexpr int NB_POINTS = 200;
-
-    juce::Array<juce::Point<float>> result{};
-    result.ensureStorageAllocated(NB_POINTS);
-
-    constexpr juce::Point<float> step{ 2.0f / (NB_POINTS - 1), 2.0f / (NB_POINTS - 1) };
-    constexpr juce::Point<float> startingPoint{ -1.0f, -1.0f };
+    mShapeTransform = mShapeTransform.rotated(angle.getAsRadians());
+}
 
-    juce::Point<float> currentPoint{ startingPoint };
-    for (int i{}; i < NB_POINTS; ++i) {
-        result.add(currentPoint);
-        currentPoint += step;
-    }
+//==============================================================================
+void Trajectory::scale(float magnitude)
+{
+    mShapeTransform = mShapeTransform.scaled(magnitude);
+}
 
-    return result;
+//==============================================================================
+juce::uint32 Trajectory::getNextVersion() noexcept
+{
+    static std::atomic<juce::uint32> lastVersion{};
+    return ++lastVersion;
 }
 
 } // namespace gris
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include "cg_TrajectoryShapes.hpp"
 #include "cg_constants.hpp"
 
 namespace gris
@@ -31,6 +32,23 @@ protected:
     //=========
     juce::Array<juce::Point<float>> mPoints{};
     bool mIsElevationDrawing{ false };
+    // Position of each point along the trajectory: the length of the path from the first point or, for finished
+    // elevation drawings, the distance on the x axis. Empty when the trajectory is interpolated by point index.
+    juce::Array<float> mCumulativeLengths{};
+    bool mIsConstantSpeed{ false };
+
+    // Points before mNumFinishedPoints went through finishRecording(). Simplified drawings keep the number of points
+    // that were recorded as their nominal size.
+    int mNumFinishedPoints{};
+    int mNumRecordedPoints{};
+
+    // Built-in shapes are evaluated analytically, drawings are interpolated between their points.
+    ShapeEvaluator mShape{};
+    int mNumShapePoints{};
+    bool mIsShapeReversed{ false };
+    juce::AffineTransform mShapeTransform{};
+
+    juce::uint32 mVersion{ getNextVersion() };
 
 public:
     //=========
@@ -45,29 +63,61 @@ public:
     Trajectory & operator=(Trajectory const &) = default;
     Trajectory & operator=(Trajectory &&) noexcept = default;
 
-    juce::Point<float> const & getStartPosition() const { return mPoints.getReference(0); }
-    juce::Point<float> const & getEndPosition() const { return mPoints.getReference(mPoints.size() - 1); }
+    juce::Point<float> getStartPosition() const;
+    juce::Point<float> getEndPosition() const;
+    /** The point reached after the given part of the trajectory. At constant speed the part is measured along the
+     * path, otherwise it is measured in points, so that the speed follows the density of the points.
+     */
     juce::Point<float> getPosition(Normalized normalized) const;
 
-    void clear() { mPoints.clear(); }
+    void setConstantSpeed(bool shouldBeConstantSpeed);
+    bool isConstantSpeed() const { return mIsConstantSpeed; }
+
+    /** True for the built-in shapes, which have no points. */
+    bool isShape() const { return mShape != nullptr; }
+    /** True when getPosition() interpolates between the points by index, false when it is defined by the shape or by
+     * the position of the points along the trajectory.
+     */
+    bool isPointIndexed() const { return !isShape() && !hasPositionTable(); }
+
+    void clear();
+    /** Appends a point to a drawing in constant time. */
     void addPoint(juce::Point<float> const & point);
-    int size() const { return mPoints.size(); }
+    /** Ends a drawing gesture. The points of an elevation drawing are spaced on the x axis and, unless the speed
+     * follows the density of the points, the points added since the last call are simplified so that the drawing
+     * does not move by more than tolerance.
+     */
+    void finishRecording(float tolerance);
+    /** The number of points recorded in a drawing, or the nominal number of points of a shape. */
+    int size() const { return isShape() ? mNumShapePoints : mNumRecordedPoints; }
 
     juce::Path getDrawablePath(juce::Rectangle<float> const & drawArea, SpatMode spatMode) const;
+    /** Changes whenever the path of the trajectory may have changed. Trajectories built or modified separately never
+     * share a version, a copy keeps the version of the trajectory it was copied from until it is modified.
+     */
+    juce::uint32 getVersion() const { return mVersion; }
 
 private:
     //=========
+    template<typename Shape>
+    void setShape()
+    {
+        // Builds the length table here, on the message thread, rather than on the first audio block that plays it.
+        if constexpr (!Shape::IS_CONSTANT_SPEED) {
+            getShapeLengths<Shape>();
+        }
+        mShape = &evaluateShape<Shape>;
+        mNumShapePoints = Shape::NUM_POINTS;
+    }
     void invertDirection();
     void flipOnHorizontalAxis();
     void rotate(Radians angle);
     void scale(float magnitude);
-
-    static juce::Array<juce::Point<float>> getBasicCirclePoints();
-    static juce::Array<juce::Point<float>> getBasicEllipsePoints();
-    static juce::Array<juce::Point<float>> getBasicSpiralPoints();
-    static juce::Array<juce::Point<float>> getBasicSquarePoints();
-    static juce::Array<juce::Point<float>> getBasicTrianglePoints();
-    static juce::Array<juce::Point<float>> getBasicDownUpPoints();
+    void computeCumulativeLengths();
+    bool hasPositionTable() const;
+    void spaceElevationPoints();
+    void simplify(int first, float tolerance);
+    static juce::uint32 getNextVersion() noexcept;
     //=========
     JUCE_LEAK_DETECTOR(Trajectory)
 };
@@ -0,0 +1,124 @@
+/*
+ This file is part of ControlGris.
+
+ Developers: Hicheme BEN GAIED, Gaël LANE LÉPINE
+
+ ControlGris is free software: you can redistribute it and/or modify
+ it under the terms of the GNU Lesser General Public License as
+ published by the Free Software Foundation, either version 3 of the
+ License, or (at your option) any later version.
+
+ ControlGris is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with ControlGris.  If not, see
+ <http://www.gnu.org/licenses/>.
+*/
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace gris
+{
+//==============================================================================
+struct TrajectoryClockTick {
+    // Time since the transport started playing, in seconds. Always a whole number of control periods.
+    double timeFromPlayS{};
+    // Number of control periods since the transport started playing.
+    juce::int64 index{};
+};
+
+//==============================================================================
+/** Time base of the trajectories, driven by the sample position of the host playhead.
+ *
+ * The audio thread calls advance() once per block. The position of the block is rounded down to the control period
+ * and a tick is returned each time it reaches a new period, so the time of a tick only depends on the playhead. The
+ * trajectories are evaluated on every tick and compute their deltas from consecutive ticks. A block that spans
+ * several control periods gets a single tick, at the period of its first sample.
+ *
+ * A shorter control period follows the playhead more closely, a longer one evaluates the trajectories less often.
+ */
+class TrajectoryClock
+{
+public:
+    //==============================================================================
+    static constexpr double MIN_CONTROL_PERIOD_MS{ 1.0 };
+    static constexpr double MAX_CONTROL_PERIOD_MS{ 5.0 };
+    static constexpr double DEFAULT_CONTROL_PERIOD_MS{ 2.0 };
+
+    //==============================================================================
+    TrajectoryClock() = default;
+
+    /** Must not be called while advance() is running. */
+    void prepare(double sampleRate)
+    {
+        mSampleRate = sampleRate;
+        restart();
+    }
+
+    void setControlPeriodMs(double periodMs)
+    {
+        mControlPeriodMs.store(juce::jlimit(MIN_CONTROL_PERIOD_MS, MAX_CONTROL_PERIOD_MS, periodMs),
+                               std::memory_order_relaxed);
+    }
+    double getControlPeriodMs() const { return mControlPeriodMs.load(std::memory_order_relaxed); }
+
+    //==============================================================================
+    // Audio thread
+    /** The next block will be the time origin of the trajectories. */
+    void restart() noexcept { mNeedsRestart = true; }
+
+    /** playheadSample is the position of the first sample of the block on the host timeline. Returns true and fills
+     * tick if the block reached a new control period.
+     */
+    bool advance(juce::int64 playheadSample, TrajectoryClockTick & tick) noexcept
+    {
+        if (mSampleRate <= 0.0) {
+            return false;
+        }
+
+        playheadSample = std::max(playheadSample, juce::int64{});
+        if (mNeedsRestart || playheadSample < mStartSample) {
+            // The second case happens when the host loops back before the position where the transport started.
+            mStartSample = playheadSample;
+            mLastIndex = -1;
+            mNeedsRestart = false;
+        }
+
+        auto const periodSamples{ std::max(
+            juce::int64{ 1 },
+            static_cast<juce::int64>(std::llround(getControlPeriodMs() * 0.001 * mSampleRate))) };
+        auto const index{ (playheadSample - mStartSample) / periodSamples };
+        if (index == mLastIndex) {
+            return false;
+        }
+        mLastIndex = index;
+
+        tick.timeFromPlayS = static_cast<double>(index * periodSamples) / mSampleRate;
+        tick.index = index;
+        return true;
+    }
+
+private:
+    //==============================================================================
+    double mSampleRate{};
+    std::atomic<double> mControlPeriodMs{ DEFAULT_CONTROL_PERIOD_MS };
+
+    bool mNeedsRestart{ true };
+    juce::int64 mStartSample{};
+    juce::int64 mLastIndex{ -1 };
+
+    //==============================================================================
+    JUCE_LEAK_DETECTOR(TrajectoryClock)
+};
+} // namespace gris
@@ -34,28 +34,36 @@ TrajectoryManager::TrajectoryManager(ControlGrisAudioProcessor & processor, Sour
 //==============================================================================
 void TrajectoryManager::setPositionActivateState(bool const state)
 {
-    mActivateState = state;
     if (state) {
-        mTrajectoryDeltaTime = 0.0;
-        mLastTrajectoryDeltaTime = 0.0;
-        mTrajectoryDeltaTimeWithoutRandom = 0.0;
-        mBackAndForthDirection = Direction::forward;
-        mDampeningCycleCount = 0;
-        mDampeningLastDelta = 0.0;
-        mCurrentPlaybackDuration = mPlaybackDuration;
-        mCurrentDegreeOfDeviation = Degrees{ 0.0f };
-        mDeviationCycleCount = 0;
-        mNormalizedTimeBufferAdjustment = 0.0;
-        mTrajectoryLastSpeed.store(mTrajectoryCurrentSpeed.load());
-        calculateCurrentRandomTime();
-        mRandomTimeAdjustment = 0.0;
-        mRandomTimeAdjustmentContinuousDestination = 0.0;
-        mRandomTimeAdjustmentContinuousIncrement = 0.0;
-        mRandomTimeAdjustmentContinuousNextStep = 0.0;
-        mTrajectoryRandomTimeFromPlaySinceLastPosChange = 0.0;
-        mTrajectoryRandomDeltaTimeBackAndForthBuffer = 0.0;
-        mTrajectoryJustStartedPlaying = true;
+        // Makes the playback start over, even if the trajectory was already active.
+        ++mActivationCount;
     }
+    mActivateState.store(state);
+}
+
+//==============================================================================
+void TrajectoryManager::resetPlayback(Playback const & playback)
+{
+    mTrajectoryDeltaTime = 0.0;
+    mLastTrajectoryDeltaTime = 0.0;
+    mTrajectoryDeltaTimeWithoutRandom = 0.0;
+    mBackAndForthDirection = Direction::forward;
+    mDampeningCycleCount = 0;
+    mDampeningLastDelta = 0.0;
+    mCurrentPlaybackDuration = playback.duration;
+    mCurrentDegreeOfDeviation = Degrees{ 0.0f };
+    mDeviationCycleCount = 0;
+    mNormalizedTimeBufferAdjustment = 0.0;
+    mTrajectoryLastSpeed = mTrajectoryCurrentSpeed.load();
+    calculateCurrentRandomTime(playback);
+    mRandomTimeAdjustment = 0.0;
+    mRandomTimeAdjustmentContinuousDestination = 0.0;
+    mRandomTimeAdjustmentContinuousIncrement = 0.0;
+    mRandomTimeAdjustmentContinuousNextStep = 0.0;
+    mTrajectoryRandomTimeFromPlaySinceLastPosChange = 0.0;
+    mLastRelativeTimeFromPlay = 0.0;
+    mTrajectoryRandomDeltaTimeBackAndForthBuffer = 0.0;
+    mTrajectoryJustStartedPlaying = true;
 }
 
 //==============================================================================
@@ -68,7 +76,7 @@ void TrajectoryManager::resetRecordingTrajectory(juce::Point<float> const curren
     mTrajectory->clear();
     mTrajectory->addPoint(currentPosition);
     mLastRecordingPoint = currentPosition;
-    mBackAndForthDirection = Direction::forward;
+    resetPlaybackDirection();
 }
 
 //==============================================================================
@@ -81,14 +89,13 @@ juce::Point<float> TrajectoryManager::smoothRecordingPosition(juce::Point<float>
 }
 
 //==============================================================================
-void TrajectoryManager::calculateCurrentRandomTime()
+void TrajectoryManager::calculateCurrentRandomTime(Playback const & playback)
 {
-    if (mTrajectoryRandomTimeMin != mTrajectoryRandomTimeMax) {
-        mCurrentRandomTime
-            = mRandomTrajectoryDeviation.nextDouble() * (mTrajectoryRandomTimeMax - mTrajectoryRandomTimeMin)
-              + mTrajectoryRandomTimeMin;
+    if (playback.randomTimeMin != playback.randomTimeMax) {
+        mCurrentRandomTime = mRandomTrajectoryDeviation.nextDouble() * (playback.randomTimeMax - playback.randomTimeMin)
+                             + playback.randomTimeMin;
     } else {
-        mCurrentRandomTime = mTrajectoryRandomTimeMin;
+        mCurrentRandomTime = playback.randomTimeMin;
     }
 }
 
@@ -106,15 +113,16 @@ void TrajectoryManager::setTrajectoryRandomEnabled(bool isEnabled)
     if (isEnabled) {
         mDampeningCycles = 0;
     } else {
-        mRandomTimeAdjustment = 0.0;
         mDampeningCycles = mTmpDampeningCycleForRandom;
     }
+    mIsPlaybackOutdated = true;
 }
 
 //==============================================================================
 void TrajectoryManager::setTrajectoryRandomLoop(bool shouldLoop)
 {
     mTrajectoryRandomLoop = shouldLoop;
+    mIsPlaybackOutdated = true;
 }
 
 //==============================================================================
@@ -125,30 +133,35 @@ void TrajectoryManager::setTrajectoryRandomStart(bool shouldStartInMiddle)
     } else {
         mTrajectoryRandomStartPosition = 0.0;
     }
+    mIsPlaybackOutdated = true;
 }
 
 //==============================================================================
 void TrajectoryManager::setTrajectoryRandomType(TrajectoryRandomType type)
 {
     mTrajectoryRandomType = type;
+    mIsPlaybackOutdated = true;
 }
 
 //==============================================================================
 void TrajectoryManager::setTrajectoryRandomProximity(double proximity)
 {
     mTrajectoryRandomProximity = proximity;
+    mIsPlaybackOutdated = true;
 }
 
 //==============================================================================
 void TrajectoryManager::setTrajectoryRandomTimeMin(double timeMin)
 {
     mTrajectoryRandomTimeMin = timeMin;
+    mIsPlaybackOutdated = true;
 }
 
 //==============================================================================
 void TrajectoryManager::setTrajectoryRandomTimeMax(double timeMax)
 {
     mTrajectoryRandomTimeMax = timeMax;
+    mIsPlaybackOutdated = true;
 }
 
 //==============================================================================
@@ -156,52 +169,111 @@ void TrajectoryManager::setPositionDampeningCycles(int const value)
 {
     this->mDampeningCycles = value;
     this->mTmpDampeningCycleForRandom = value;
+    mIsPlaybackOutdated = true;
+}
+
+//==============================================================================
+void TrajectoryManager::resetPlaybackDirection()
+{
+    ++mDirectionResetCount;
+    mIsPlaybackOutdated = true;
+}
+
+//==============================================================================
+void TrajectoryManager::exchangePlaybackState()
+{
+    if (mIsPlaybackOutdated) {
+        auto & playback{ mPlaybacks.getWriteBuffer() };
+        playback.trajectory = mTrajectory;
+        playback.duration = mPlaybackDuration;
+        playback.isBackAndForth = mIsBackAndForth;
+        playback.dampeningCycles = mDampeningCycles;
+        playback.deviationPerCycle = mDegreeOfDeviationPerCycle;
+        playback.isRandomEnabled = mTrajectoryRandomEnabled;
+        playback.isRandomLoop = mTrajectoryRandomLoop;
+        playback.randomType = mTrajectoryRandomType;
+        playback.randomProximity = mTrajectoryRandomProximity;
+        playback.randomStartPosition = mTrajectoryRandomStartPosition;
+        playback.randomTimeMin = mTrajectoryRandomTimeMin;
+        playback.randomTimeMax = mTrajectoryRandomTimeMax;
+        playback.directionResetCount = mDirectionResetCount;
+        mPlaybacks.publish();
+        mIsPlaybackOutdated = false;
+    }
+
+    if (mPlayedPoints.update()) {
+        mPlayedPoint = mPlayedPoints.getReadBuffer();
+        applyCurrentTrajectoryPointToPrimarySource();
+        sendTrajectoryPositionChangedEvent();
+    }
 }
 
 //==============================================================================
 void TrajectoryManager::setTrajectoryDeltaTime(double const relativeTimeFromPlay)
 {
+    mPlaybacks.update();
+    auto const & playback{ mPlaybacks.getReadBuffer() };
+
+    auto const activationCount{ mActivationCount.load() };
+    if (activationCount != mLastActivationCount) {
+        mLastActivationCount = activationCount;
+        resetPlayback(playback);
+    }
+    if (playback.directionResetCount != mLastDirectionResetCount) {
+        mLastDirectionResetCount = playback.directionResetCount;
+        mBackAndForthDirection = Direction::forward;
+    }
+    if (!playback.isRandomEnabled) {
+        mRandomTimeAdjustment = 0.0;
+    }
+
     auto trajectoryCurrentSpeed{ mTrajectoryCurrentSpeed.load() };
-    auto trajectoryLastSpeed{ mTrajectoryLastSpeed.load() };
+    auto trajectoryLastSpeed{ mTrajectoryLastSpeed };
+
+    // The time goes backward when the playhead of the DAW loops.
+    auto const elapsedTime{ mTrajectoryJustStartedPlaying
+                                ? 0.0
+                                : std::max(relativeTimeFromPlay - mLastRelativeTimeFromPlay, 0.0) };
+    mLastRelativeTimeFromPlay = relativeTimeFromPlay;
 
     // Random logic
-    if (mTrajectoryRandomEnabled) {
+    if (playback.isRandomEnabled) {
         auto timeSinceLastPosChange{ relativeTimeFromPlay - mTrajectoryRandomTimeFromPlaySinceLastPosChange };
 
-        if (mTrajectoryRandomType == TrajectoryRandomType::discrete) {
+        if (playback.randomType == TrajectoryRandomType::discrete) {
             if (timeSinceLastPosChange >= mCurrentRandomTime && relativeTimeFromPlay != 0.0) {
-                calculateCurrentRandomTime();
+                calculateCurrentRandomTime(playback);
                 mTrajectoryRandomTimeFromPlaySinceLastPosChange = relativeTimeFromPlay;
 
-                auto randRange{ juce::Range<double>(0.0, mTrajectoryRandomProximity) };
+                auto randRange{ juce::Range<double>(0.0, playback.randomProximity) };
                 auto nextRandomVal{ mRandomGenrerator.nextDouble() };
                 mRandomTimeAdjustment = nextRandomVal * randRange.getLength() - (randRange.getLength() / 2)
-                                        + mTrajectoryRandomStartPosition;
+                                        + playback.randomStartPosition;
             } else if (relativeTimeFromPlay < mTrajectoryRandomTimeFromPlaySinceLastPosChange) {
                 // if the playhead of the DAW is in loop mode
                 mTrajectoryRandomTimeFromPlaySinceLastPosChange = relativeTimeFromPlay;
             } else if (mTrajectoryJustStartedPlaying) {
-                mRandomTimeAdjustment = mTrajectoryRandomStartPosition;
+                mRandomTimeAdjustment = playback.randomStartPosition;
                 mTrajectoryJustStartedPlaying = false;
             }
-        } else if (mTrajectoryRandomType == TrajectoryRandomType::continuous) {
+        } else if (playback.randomType == TrajectoryRandomType::continuous) {
             if (((mRandomTimeAdjustmentContinuousDestination <= 0
                   && mRandomTimeAdjustmentContinuousNextStep <= mRandomTimeAdjustmentContinuousDestination)
                  || (mRandomTimeAdjustmentContinuousDestination >= 0
                      && mRandomTimeAdjustmentContinuousNextStep >= mRandomTimeAdjustmentContinuousDestination))
                 && !mTrajectoryJustStartedPlaying) {
-                calculateCurrentRandomTime();
+                calculateCurrentRandomTime(playback);
 
-                auto randRange{ juce::Range<double>(0.0, mTrajectoryRandomProximity) };
+                auto randRange{ juce::Range<double>(0.0, playback.randomProximity) };
                 auto nextRandomVal{ mRandomGenrerator.nextDouble() };
 
-                if (mTrajectoryRandomLoop) {
+                if (playback.isRandomLoop) {
                     mRandomTimeAdjustmentContinuousDestination
                         = nextRandomVal * randRange.getLength() - (randRange.getLength() / 2);
                 } else {
                     mRandomTimeAdjustmentContinuousDestination = nextRandomVal * randRange.getLength()
                                                                  - (randRange.getLength() / 2) - mRandomTimeAdjustment
-                                                                 + mTrajectoryRandomStartPosition;
+                                                                 + playback.randomStartPosition;
                 }
 
                 // If we want constant speed
@@ -209,26 +281,25 @@ void TrajectoryManager::setTrajectoryDeltaTime(double const relativeTimeFromPlay
                 // (mRandomTimeAdjustmentContinuousDestination < 0) ? -1 : 0; mRandomTimeAdjustmentContinuousIncrement =
                 // mTrajectoryRandomTimeMin * 0.01 * sign;
 
+                // Per second of playback, the destination is reached after mCurrentRandomTime seconds.
                 mRandomTimeAdjustmentContinuousIncrement
-                    = mRandomTimeAdjustmentContinuousDestination
-                      / (mCurrentRandomTime * 45.5); // it should be * 50, but this method is called by a juce::Timer
-                                                     // every 20 milliseconds and it is not accurate, so we try to
-                                                     // compensate it here instead of using a juce::HighResolutionTimer
+                    = mRandomTimeAdjustmentContinuousDestination / mCurrentRandomTime;
                 mRandomTimeAdjustmentContinuousNextStep = 0.0;
             } else if (mTrajectoryJustStartedPlaying) {
-                mRandomTimeAdjustment = mTrajectoryRandomStartPosition;
+                mRandomTimeAdjustment = playback.randomStartPosition;
                 mTrajectoryJustStartedPlaying = false;
             }
 
-            mRandomTimeAdjustment += mRandomTimeAdjustmentContinuousIncrement;
-            mRandomTimeAdjustmentContinuousNextStep += mRandomTimeAdjustmentContinuousIncrement;
+            auto const step{ mRandomTimeAdjustmentContinuousIncrement * elapsedTime };
+            mRandomTimeAdjustment += step;
+            mRandomTimeAdjustmentContinuousNextStep += step;
 
-            if (!mTrajectoryRandomLoop || mIsBackAndForth) {
+            if (!playback.isRandomLoop || playback.isBackAndForth) {
                 // To wrap around from start position
-                if (mRandomTimeAdjustment > mTrajectoryRandomStartPosition + 0.5) {
-                    mRandomTimeAdjustment = mTrajectoryRandomStartPosition + 0.5;
-                } else if (mRandomTimeAdjustment < mTrajectoryRandomStartPosition - 0.5) {
-                    mRandomTimeAdjustment = mTrajectoryRandomStartPosition - 0.5;
+                if (mRandomTimeAdjustment > playback.randomStartPosition + 0.5) {
+                    mRandomTimeAdjustment = playback.randomStartPosition + 0.5;
+                } else if (mRandomTimeAdjustment < playback.randomStartPosition - 0.5) {
+                    mRandomTimeAdjustment = playback.randomStartPosition - 0.5;
                 }
             }
         }
@@ -265,28 +336,31 @@ void TrajectoryManager::setTrajectoryDeltaTime(double const relativeTimeFromPlay
     }
 
     mTrajectoryDeltaTimeWithoutRandom = std::fmod(deltaTimeAdjustementWithoutRandom, 1.0);
-    mTrajectoryLastSpeed.store(mTrajectoryCurrentSpeed.load());
+    mTrajectoryLastSpeed = trajectoryCurrentSpeed;
+
+    computeCurrentTrajectoryPoint(playback);
 
-    computeCurrentTrajectoryPoint();
-    applyCurrentTrajectoryPointToPrimarySource();
+    mPlayedPoints.getWriteBuffer() = mCurrentTrajectoryPoint;
+    mPlayedPoints.publish();
 }
 
 //==============================================================================
-void TrajectoryManager::computeCurrentTrajectoryPoint()
+void TrajectoryManager::computeCurrentTrajectoryPoint(Playback const & playback)
 {
-    if (!mTrajectory.has_value()) {
+    auto const & trajectory{ playback.trajectory };
+    if (!trajectory.has_value()) {
         mCurrentTrajectoryPoint = extractTrajectoryPointFromPrimarySource();
         return;
     }
 
-    auto const dampeningCyclesTimes2{ mDampeningCycles * 2 };
+    auto const dampeningCyclesTimes2{ playback.dampeningCycles * 2 };
     double currentScaleMin{};
     double currentScaleMax{};
     bool backAndForthDirectionJustChanged{};
 
-    if (mTrajectory->size() > 0) {
+    if (trajectory->size() > 0) {
         if (mTrajectoryDeltaTimeWithoutRandom < mLastTrajectoryDeltaTime) {
-            if (mIsBackAndForth) {
+            if (playback.isBackAndForth) {
                 this->invertBackAndForthDirection();
                 backAndForthDirectionJustChanged = true;
                 mDampeningCycleCount++;
@@ -300,7 +374,7 @@ void TrajectoryManager::computeCurrentTrajectoryPoint()
 
         double trajectoryPhase;
         double trajectoryPhaseWithoutRandom{};
-        if (mIsBackAndForth && mDampeningCycles > 0) {
+        if (playback.isBackAndForth && playback.dampeningCycles > 0) {
             if (mTrajectoryDeltaTime <= 0.5) {
                 trajectoryPhase = std::pow(mTrajectoryDeltaTime * 2.0, 2.0) * 0.5;
             } else {
@@ -311,36 +385,36 @@ void TrajectoryManager::computeCurrentTrajectoryPoint()
             trajectoryPhaseWithoutRandom = mTrajectoryDeltaTimeWithoutRandom;
         }
 
-        double delta{ trajectoryPhase * mTrajectory->size() };
-        double deltaWithoutRandom{ trajectoryPhaseWithoutRandom * mTrajectory->size() };
+        double delta{ trajectoryPhase * trajectory->size() };
+        double deltaWithoutRandom{ trajectoryPhaseWithoutRandom * trajectory->size() };
         auto trajectoryCurrentSpeed{ mTrajectoryCurrentSpeed.load() };
 
         // Random logic
-        if (mTrajectoryRandomEnabled && backAndForthDirectionJustChanged) {
+        if (playback.isRandomEnabled && backAndForthDirectionJustChanged) {
             jassert(mTrajectoryRandomDeltaTimeBackAndForthBuffer == 0.0);
 
             mTrajectoryRandomDeltaTimeBackAndForthBuffer
-                += delta - (deltaWithoutRandom + (mTrajectory->size() * mTrajectoryRandomStartPosition));
-            if (mTrajectoryRandomDeltaTimeBackAndForthBuffer > mTrajectory->size() * 0.5) {
-                mTrajectoryRandomDeltaTimeBackAndForthBuffer -= mTrajectory->size();
-            } else if (mTrajectoryRandomDeltaTimeBackAndForthBuffer < -(mTrajectory->size() * 0.5)) {
-                mTrajectoryRandomDeltaTimeBackAndForthBuffer += mTrajectory->size();
+                += delta - (deltaWithoutRandom + (trajectory->size() * playback.randomStartPosition));
+            if (mTrajectoryRandomDeltaTimeBackAndForthBuffer > trajectory->size() * 0.5) {
+                mTrajectoryRandomDeltaTimeBackAndForthBuffer -= trajectory->size();
+            } else if (mTrajectoryRandomDeltaTimeBackAndForthBuffer < -(trajectory->size() * 0.5)) {
+                mTrajectoryRandomDeltaTimeBackAndForthBuffer += trajectory->size();
             }
         }
 
-        if (mTrajectoryRandomEnabled && trajectoryCurrentSpeed != 0.0) {
+        if (playback.isRandomEnabled && trajectoryCurrentSpeed != 0.0) {
             if (mBackAndForthDirection == Direction::backward) {
-                delta = mTrajectory->size() - delta + (2 * mTrajectoryRandomDeltaTimeBackAndForthBuffer);
+                delta = trajectory->size() - delta + (2 * mTrajectoryRandomDeltaTimeBackAndForthBuffer);
             } else {
                 delta = delta - (2 * mTrajectoryRandomDeltaTimeBackAndForthBuffer);
             }
-            delta = std::fmod(delta, mTrajectory->size());
+            delta = std::fmod(delta, trajectory->size());
             if (delta < 0) {
-                delta += mTrajectory->size();
+                delta += trajectory->size();
             }
         } else {
             if (mBackAndForthDirection == Direction::backward) {
-                delta = mTrajectory->size() - delta;
+                delta = trajectory->size() - delta;
             }
         }
 
@@ -361,16 +435,16 @@ void TrajectoryManager::computeCurrentTrajectoryPoint()
             mTrajectoryRandomDeltaTimeBackAndForthBuffer = 0.0;
         } // end Random logic
 
-        delta = std::clamp(delta, 0.0, static_cast<double>(mTrajectory->size()));
+        delta = std::clamp(delta, 0.0, static_cast<double>(trajectory->size()));
 
-        if (mIsBackAndForth && mDampeningCycles > 0) {
+        if (playback.isBackAndForth && playback.dampeningCycles > 0) {
             if (mDampeningCycleCount < dampeningCyclesTimes2) {
                 double const relativeDeltaTime{ (mDampeningCycleCount + mTrajectoryDeltaTime) / dampeningCyclesTimes2 };
                 mCurrentPlaybackDuration
-                    = mPlaybackDuration - (std::pow(relativeDeltaTime, 2.0) * mPlaybackDuration * 0.25);
-                currentScaleMin = relativeDeltaTime * mTrajectory->size() * 0.5;
-                currentScaleMax = mTrajectory->size() - currentScaleMin;
-                double const currentScale{ (currentScaleMax - currentScaleMin) / mTrajectory->size() };
+                    = playback.duration - (std::pow(relativeDeltaTime, 2.0) * playback.duration * 0.25);
+                currentScaleMin = relativeDeltaTime * trajectory->size() * 0.5;
+                currentScaleMax = trajectory->size() - currentScaleMin;
+                double const currentScale{ (currentScaleMax - currentScaleMin) / trajectory->size() };
                 delta = delta * currentScale + currentScaleMin;
                 mDampeningLastDelta = delta;
             } else {
@@ -380,26 +454,32 @@ void TrajectoryManager::computeCurrentTrajectoryPoint()
             mDampeningLastDelta = delta;
         }
 
-        auto const deltaRatio{ static_cast<double>(mTrajectory->size() - 1) / mTrajectory->size() };
-        delta *= deltaRatio;
-        auto const index{ static_cast<int>(delta) };
-        if (index + 1 < mTrajectory->size()) {
-            Normalized const progression{ static_cast<float>(delta / mTrajectory->size()) };
-            mCurrentTrajectoryPoint = mTrajectory->getPosition(progression);
+        if (!trajectory->isPointIndexed()) {
+            // Shapes and finished drawings are defined everywhere, including their end.
+            Normalized const progression{ static_cast<float>(delta / trajectory->size()) };
+            mCurrentTrajectoryPoint = trajectory->getPosition(progression);
         } else {
-            mCurrentTrajectoryPoint = mTrajectory->getEndPosition();
+            auto const deltaRatio{ static_cast<double>(trajectory->size() - 1) / trajectory->size() };
+            delta *= deltaRatio;
+            auto const index{ static_cast<int>(delta) };
+            if (index + 1 < trajectory->size()) {
+                Normalized const progression{ static_cast<float>(delta / trajectory->size()) };
+                mCurrentTrajectoryPoint = trajectory->getPosition(progression);
+            } else {
+                mCurrentTrajectoryPoint = trajectory->getEndPosition();
+            }
         }
     }
 
-    if (mDegreeOfDeviationPerCycle != Degrees{ 0.0f }) {
+    if (playback.deviationPerCycle != Degrees{ 0.0f }) {
         auto deviationFlag{ true };
-        if (mIsBackAndForth && mDampeningCycles > 0) {
+        if (playback.isBackAndForth && playback.dampeningCycles > 0) {
             if (juce::approximatelyEqual(currentScaleMin, currentScaleMax)) {
                 deviationFlag = false;
             }
         }
         if (deviationFlag) {
-            mCurrentDegreeOfDeviation = mDegreeOfDeviationPerCycle
+            mCurrentDegreeOfDeviation = playback.deviationPerCycle
                                         * static_cast<float>(mDeviationCycleCount + mTrajectoryDeltaTimeWithoutRandom);
             if (mCurrentDegreeOfDeviation >= Degrees{ 360.0f }) {
                 mCurrentDegreeOfDeviation -= Degrees{ 360.0f };
@@ -413,10 +493,10 @@ void TrajectoryManager::computeCurrentTrajectoryPoint()
 //==============================================================================
 juce::Point<float> TrajectoryManager::getCurrentTrajectoryPoint() const
 {
-    if (mActivateState) {
-        return mCurrentTrajectoryPoint;
+    if (mActivateState.load()) {
+        return mPlayedPoint;
     }
-    return mPrimarySource.getPos();
+    return extractTrajectoryPointFromPrimarySource();
 }
 
 //==============================================================================
@@ -438,7 +518,6 @@ void PositionTrajectoryManager::sendTrajectoryPositionChangedEvent()
 void PositionTrajectoryManager::recomputeTrajectory()
 {
     this->setTrajectoryType(mTrajectoryType, mPrimarySource.getPos());
-    mBackAndForthDirection = Direction::forward;
 }
 
 //==============================================================================
@@ -464,8 +543,19 @@ void PositionTrajectoryManager::setTrajectoryType(PositionTrajectoryType const t
         mTrajectory.reset();
     } else {
         mTrajectory = Trajectory{ type, startPos };
+        mTrajectory->setConstantSpeed(mIsConstantSpeed);
+    }
+    resetPlaybackDirection();
+}
+
+//==============================================================================
+void PositionTrajectoryManager::setConstantSpeed(bool const shouldBeConstantSpeed)
+{
+    mIsConstantSpeed = shouldBeConstantSpeed;
+    if (mTrajectory.has_value()) {
+        mTrajectory->setConstantSpeed(shouldBeConstantSpeed);
+        mIsPlaybackOutdated = true;
     }
-    mBackAndForthDirection = Direction::forward;
 }
 
 //==============================================================================
@@ -473,6 +563,15 @@ void TrajectoryManager::addRecordingPoint(juce::Point<float> const & pos)
 {
     jassert(mTrajectory.has_value());
     mTrajectory->addPoint(smoothRecordingPosition(pos));
+    mIsPlaybackOutdated = true;
+}
+
+//==============================================================================
+void TrajectoryManager::finishRecordingTrajectory()
+{
+    jassert(mTrajectory.has_value());
+    mTrajectory->finishRecording(mRecordingTolerance);
+    mIsPlaybackOutdated = true;
 }
 
 //==============================================================================
@@ -491,25 +590,23 @@ void ElevationTrajectoryManager::setTrajectoryType(ElevationTrajectoryType const
     } else {
         mTrajectory.reset();
     }
-    mBackAndForthDirection = Direction::forward;
+    resetPlaybackDirection();
 }
 
 //==============================================================================
 void PositionTrajectoryManager::applyCurrentTrajectoryPointToPrimarySource()
 {
-    if (mActivateState) {
-        mPrimarySource.setPosition(mCurrentTrajectoryPoint, Source::OriginOfChange::trajectory);
-        sendTrajectoryPositionChangedEvent();
+    if (mActivateState.load()) {
+        mPrimarySource.setPosition(mPlayedPoint, Source::OriginOfChange::trajectory);
     }
 }
 
 //==============================================================================
 void ElevationTrajectoryManager::applyCurrentTrajectoryPointToPrimarySource()
 {
-    if (mActivateState) {
-        auto const currentElevation{ Radians{ MAX_ELEVATION } * (mCurrentTrajectoryPoint.getY() + 1.0f) / 2.0f };
+    if (mActivateState.load()) {
+        auto const currentElevation{ Radians{ MAX_ELEVATION } * (mPlayedPoint.getY() + 1.0f) / 2.0f };
         mPrimarySource.setElevation(currentElevation, Source::OriginOfChange::trajectory);
-        sendTrajectoryPositionChangedEvent();
     }
 }
 
@@ -19,12 +19,14 @@
  *************************************************************************/
 #pragma once
 
+#include <atomic>
 #include <optional>
 
 #include <JuceHeader.h>
 
 #include "cg_Source.hpp"
 #include "cg_Trajectory.hpp"
+#include "cg_TripleBuffer.hpp"
 #include "cg_constants.hpp"
 
 namespace gris
@@ -32,6 +34,14 @@ namespace gris
 class ControlGrisAudioProcessor;
 
 //==============================================================================
+/** Edits a trajectory on the message thread and plays it on the audio thread.
+ *
+ * The message thread owns the trajectory and the settings. Whenever they change, exchangePlaybackState() hands a copy
+ * of them to the audio thread. The audio thread owns the playback: setTrajectoryDeltaTime() only evaluates the point
+ * reached by the trajectory and publishes it. exchangePlaybackState() brings that point back and moves the primary
+ * source to it, so the links, the host parameters, the GUI and the OSC output are all updated from the message
+ * thread. Neither thread ever waits for the other.
+ */
 class TrajectoryManager
 {
 public:
@@ -60,58 +70,97 @@ public:
 
     //==============================================================================
     enum class Direction { forward, backward };
+    //==============================================================================
+    // Largest distance, in trajectory space, between a recorded point and the simplified drawing.
+    static constexpr float DEFAULT_RECORDING_TOLERANCE{ 0.002f };
+    static constexpr float MAX_RECORDING_TOLERANCE{ 0.05f };
 
 protected:
+    //==============================================================================
+    /** What the audio thread needs to play the trajectory. */
+    struct Playback {
+        std::optional<Trajectory> trajectory{};
+        double duration{ 5.0 };
+        bool isBackAndForth{};
+        int dampeningCycles{};
+        Degrees deviationPerCycle{};
+        bool isRandomEnabled{};
+        bool isRandomLoop{};
+        TrajectoryRandomType randomType{};
+        double randomProximity{};
+        double randomStartPosition{};
+        double randomTimeMin{ 0.03 };
+        double randomTimeMax{ 5.0 };
+        // Incremented each time the playback has to go forward again.
+        juce::uint32 directionResetCount{};
+    };
+
     //==============================================================================
     ControlGrisAudioProcessor & mProcessor;
 
     juce::ListenerList<Listener> mListeners;
 
+    // Message thread
     bool mIsBackAndForth{ false };
-    Direction mBackAndForthDirection{ Direction::forward };
-
     int mDampeningCycles{};
     int mTmpDampeningCycleForRandom{};
+    double mPlaybackDuration{ 5.0 };
+    std::optional<Trajectory> mTrajectory{};
+    juce::Point<float> mLastRecordingPoint{};
+    float mRecordingTolerance{ DEFAULT_RECORDING_TOLERANCE };
+    bool mTrajectoryRandomEnabled{};
+    bool mTrajectoryRandomLoop{};
+    TrajectoryRandomType mTrajectoryRandomType{};
+    double mTrajectoryRandomProximity{};
+    double mTrajectoryRandomStartPosition{ 0.0 };
+    double mTrajectoryRandomTimeMin{ 0.03 };
+    double mTrajectoryRandomTimeMax{ 5.0 };
+    Degrees mDegreeOfDeviationPerCycle{};
+    juce::uint32 mDirectionResetCount{};
+    bool mIsPlaybackOutdated{ true };
+    juce::Point<float> mPlayedPoint{};
+
+    // Any thread
+    std::atomic<bool> mActivateState{ false };
+    std::atomic<juce::uint32> mActivationCount{};
+    std::atomic<double> mTrajectoryCurrentSpeed{ 1.0 };
+
+    // Audio thread
+    juce::uint32 mLastActivationCount{};
+    juce::uint32 mLastDirectionResetCount{};
+    Direction mBackAndForthDirection{ Direction::forward };
     int mDampeningCycleCount{};
     double mDampeningLastDelta{};
-
-    bool mActivateState{ false };
-    double mPlaybackDuration{ 5.0 };
     double mCurrentPlaybackDuration{ 5.0 };
 
     double mTrajectoryDeltaTime{};
     double mLastTrajectoryDeltaTime{};
     double mTrajectoryDeltaTimeWithoutRandom{};
     double mTrajectoryRandomDeltaTimeBackAndForthBuffer{};
-    std::optional<Trajectory> mTrajectory{};
     juce::Point<float> mCurrentTrajectoryPoint{};
-    juce::Point<float> mLastRecordingPoint{};
 
-    std::atomic<double> mTrajectoryCurrentSpeed{ 1.0 };
-    std::atomic<double> mTrajectoryLastSpeed{ 1.0 };
+    double mTrajectoryLastSpeed{ 1.0 };
     double mNormalizedTimeBufferAdjustment{};
     double mRandomTimeAdjustment{};
     double mRandomTimeAdjustmentContinuousDestination{};
     double mRandomTimeAdjustmentContinuousIncrement{};
     double mRandomTimeAdjustmentContinuousNextStep{};
-    bool mTrajectoryRandomEnabled{};
-    bool mTrajectoryRandomLoop{};
     bool mTrajectoryJustStartedPlaying{};
-    TrajectoryRandomType mTrajectoryRandomType{};
-    double mTrajectoryRandomProximity{};
-    double mTrajectoryRandomStartPosition{ 0.0 };
-    double mTrajectoryRandomTimeMin{ 0.03 };
-    double mTrajectoryRandomTimeMax{ 5.0 };
     double mCurrentRandomTime{};
     double mTrajectoryRandomTimeFromPlaySinceLastPosChange{};
+    double mLastRelativeTimeFromPlay{};
 
     juce::Random mRandomTrajectoryDeviation{};
     juce::Random mRandomGenrerator{};
 
-    Degrees mDegreeOfDeviationPerCycle{};
     Degrees mCurrentDegreeOfDeviation{};
     int mDeviationCycleCount{};
 
+    // Written by the message thread, read by the audio thread.
+    TripleBuffer<Playback> mPlaybacks{};
+    // Written by the audio thread, read by the message thread.
+    TripleBuffer<juce::Point<float>> mPlayedPoints{};
+
     Source & mPrimarySource;
 
 public:
@@ -128,15 +177,34 @@ public:
     [[nodiscard]] ControlGrisAudioProcessor & getProcessor() const { return mProcessor; }
 
     void setPositionActivateState(bool state);
-    [[nodiscard]] bool getPositionActivateState() const { return mActivateState; }
+    [[nodiscard]] bool getPositionActivateState() const { return mActivateState.load(); }
 
-    void setPlaybackDuration(double const value) { mPlaybackDuration = value; }
+    void setPlaybackDuration(double const value)
+    {
+        mPlaybackDuration = value;
+        mIsPlaybackOutdated = true;
+    }
 
     void resetRecordingTrajectory(juce::Point<float> currentPosition);
     void addRecordingPoint(juce::Point<float> const & pos);
+    /** Called at the end of each drawing gesture. */
+    void finishRecordingTrajectory();
+    void setRecordingTolerance(float const tolerance)
+    {
+        mRecordingTolerance = juce::jlimit(0.0f, MAX_RECORDING_TOLERANCE, tolerance);
+    }
+    /** Message thread. The point last reached by the playback, or the position of the primary source when the
+     * trajectory is not active.
+     */
     [[nodiscard]] juce::Point<float> getCurrentTrajectoryPoint() const;
 
+    /** Message thread. Hands the trajectory and the settings to the playback if they changed, and moves the primary
+     * source to the point it last reached.
+     */
+    void exchangePlaybackState();
+    /** Audio thread. Publishes where the trajectory is at relativeTimeFromPlay, without touching the sources. */
     void setTrajectoryDeltaTime(double relativeTimeFromPlay);
+
     void setTrajectoryCurrentSpeed(double speed);
     void setTrajectoryRandomEnabled(bool isEnabled);
     void setTrajectoryRandomLoop(bool shouldLoop);
@@ -147,10 +215,18 @@ public:
     void setTrajectoryRandomTimeMax(double timeMax);
     [[nodiscard]] std::optional<Trajectory> const & getTrajectory() const { return mTrajectory; }
 
-    void setPositionBackAndForth(bool const newState) { mIsBackAndForth = newState; }
+    void setPositionBackAndForth(bool const newState)
+    {
+        mIsBackAndForth = newState;
+        mIsPlaybackOutdated = true;
+    }
 
     void setPositionDampeningCycles(int const value);
-    void setDeviationPerCycle(Degrees const value) { this->mDegreeOfDeviationPerCycle = value; }
+    void setDeviationPerCycle(Degrees const value)
+    {
+        mDegreeOfDeviationPerCycle = value;
+        mIsPlaybackOutdated = true;
+    }
     void addListener(Listener * l) { mListeners.add(l); }
 
     void sourceMoved(Source & source);
@@ -162,13 +238,16 @@ public:
 protected:
     //==============================================================================
     [[nodiscard]] virtual juce::Point<float> extractTrajectoryPointFromPrimarySource() const = 0;
+    /** The next playback starts going forward. */
+    void resetPlaybackDirection();
 
 private:
     //==============================================================================
+    void resetPlayback(Playback const & playback);
     void invertBackAndForthDirection();
-    void computeCurrentTrajectoryPoint();
+    void computeCurrentTrajectoryPoint(Playback const & playback);
     [[nodiscard]] juce::Point<float> smoothRecordingPosition(juce::Point<float> const & pos);
-    void calculateCurrentRandomTime();
+    void calculateCurrentRandomTime(Playback const & playback);
     //==============================================================================
     JUCE_LEAK_DETECTOR(TrajectoryManager)
 
@@ -179,6 +258,7 @@ class PositionTrajectoryManager final : public TrajectoryManager
 {
     PositionTrajectoryType mTrajectoryType{ PositionTrajectoryType::drawing };
     PositionSourceLink mSourceLink{ PositionSourceLink::independent };
+    bool mIsConstantSpeed{ true };
 
 public:
     //==============================================================================
@@ -201,6 +281,10 @@ public:
 
     void setSourceLink(PositionSourceLink const sourceLink) { mSourceLink = sourceLink; }
     [[nodiscard]] PositionSourceLink getSourceLink() const { return mSourceLink; }
+
+    /** When false, the speed along the trajectory follows the density of its points, as in older versions. */
+    void setConstantSpeed(bool shouldBeConstantSpeed);
+    [[nodiscard]] bool isConstantSpeed() const { return mIsConstantSpeed; }
     //==============================================================================
     void applyCurrentTrajectoryPointToPrimarySource() override;
     void sendTrajectoryPositionChangedEvent() override;
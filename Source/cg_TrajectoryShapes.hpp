@@ -0,0 +1,197 @@
+/*
+ This file is part of ControlGris.
+
+ Developers: Hicheme BEN GAIED, Gaël LANE LÉPINE
+
+ ControlGris is free software: you can redistribute it and/or modify
+ it under the terms of the GNU Lesser General Public License as
+ published by the Free Software Foundation, either version 3 of the
+ License, or (at your option) any later version.
+
+ ControlGris is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with ControlGris.  If not, see
+ <http://www.gnu.org/licenses/>.
+*/
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace gris
+{
+//==============================================================================
+/** The built-in trajectory shapes, before they are rotated and scaled to the position of the source.
+ *
+ * evaluate() returns the point reached after the part t of the shape, with t in [0, 1]. Closed shapes end where they
+ * start. NUM_POINTS is the size of the point table that each shape used to be stored as: the trajectory managers
+ * measure some of their timings in points, so it is kept as the nominal size of the shape.
+ */
+struct CircleShape {
+    static constexpr int NUM_POINTS{ 300 };
+    static constexpr bool IS_CONSTANT_SPEED{ true };
+
+    static juce::Point<float> evaluate(float const t) noexcept
+    {
+        auto const angle{ t * juce::MathConstants<float>::twoPi };
+        return juce::Point<float>{ std::cos(angle), std::sin(angle) };
+    }
+};
+
+//==============================================================================
+struct EllipseShape {
+    static constexpr int NUM_POINTS{ 300 };
+    static constexpr bool IS_CONSTANT_SPEED{ false };
+
+    static juce::Point<float> evaluate(float const t) noexcept
+    {
+        // just squish a circle!
+        auto const point{ CircleShape::evaluate(t) };
+        return juce::Point<float>{ point.getX(), point.getY() * 0.5f };
+    }
+};
+
+//==============================================================================
+struct SpiralShape {
+    static constexpr int NUM_POINTS{ 300 };
+    static constexpr bool IS_CONSTANT_SPEED{ false };
+    static constexpr float NUM_ROTATIONS{ 3.0f };
+
+    static juce::Point<float> evaluate(float const t) noexcept
+    {
+        auto const angle{ t * NUM_ROTATIONS * juce::MathConstants<float>::twoPi };
+        return juce::Point<float>{ std::cos(angle) * t, std::sin(angle) * t };
+    }
+};
+
+//==============================================================================
+/** A closed polygon whose sides all have the same length. */
+template<size_t NumVertices>
+juce::Point<float> evaluatePolygon(std::array<juce::Point<float>, NumVertices> const & vertices, float const t) noexcept
+{
+    auto const position{ juce::jlimit(0.0f, 1.0f, t) * static_cast<float>(NumVertices) };
+    auto const side{ std::min(static_cast<size_t>(position), NumVertices - 1) };
+    auto const balance{ position - static_cast<float>(side) };
+    return vertices[side] * (1.0f - balance) + vertices[(side + 1) % NumVertices] * balance;
+}
+
+//==============================================================================
+struct SquareShape {
+    static constexpr int NUM_POINTS{ 300 };
+    static constexpr bool IS_CONSTANT_SPEED{ true };
+
+    static juce::Point<float> evaluate(float const t) noexcept
+    {
+        static constexpr std::array<juce::Point<float>, 4> VERTICES{
+            juce::Point<float>{ 1.0f, 0.0f },
+            juce::Point<float>{ 0.0f, 1.0f },
+            juce::Point<float>{ -1.0f, 0.0f },
+            juce::Point<float>{ 0.0f, -1.0f },
+        };
+        return evaluatePolygon(VERTICES, t);
+    }
+};
+
+//==============================================================================
+struct TriangleShape {
+    static constexpr int NUM_POINTS{ 300 };
+    static constexpr bool IS_CONSTANT_SPEED{ true };
+
+    static juce::Point<float> evaluate(float const t) noexcept
+    {
+        // An equilateral triangle inscribed in the unit circle.
+        constexpr float halfSqrt3{ 0.86602540378f };
+        static constexpr std::array<juce::Point<float>, 3> VERTICES{
+            juce::Point<float>{ 1.0f, 0.0f },
+            juce::Point<float>{ -0.5f, halfSqrt3 },
+            juce::Point<float>{ -0.5f, -halfSqrt3 },
+        };
+        return evaluatePolygon(VERTICES, t);
+    }
+};
+
+//==============================================================================
+struct DownUpShape {
+    static constexpr int NUM_POINTS{ 200 };
+    static constexpr bool IS_CONSTANT_SPEED{ true };
+
+    static juce::Point<float> evaluate(float const t) noexcept
+    {
+        auto const position{ t * 2.0f - 1.0f };
+        return juce::Point<float>{ position, position };
+    }
+};
+
+//==============================================================================
+constexpr int NUM_SHAPE_LENGTH_SEGMENTS{ 1024 };
+using ShapeLengths = std::array<float, NUM_SHAPE_LENGTH_SEGMENTS + 1>;
+
+/** Cumulative length of a shape that is not already traversed at constant speed, sampled once per process.
+ *
+ * Rotating and uniformly scaling a shape does not change the proportions of its length, so the table is shared by
+ * every trajectory using the shape. Its first use computes it, behind the lock of a function-local static: the
+ * Trajectory constructor makes that first use on the message thread, so the audio thread only ever reads it.
+ */
+template<typename Shape>
+ShapeLengths const & getShapeLengths() noexcept
+{
+    static_assert(!Shape::IS_CONSTANT_SPEED);
+    static auto const LENGTHS = []() {
+        ShapeLengths result{};
+        auto previousPoint{ Shape::evaluate(0.0f) };
+        for (size_t i{ 1 }; i < result.size(); ++i) {
+            auto const point{ Shape::evaluate(static_cast<float>(i) / static_cast<float>(NUM_SHAPE_LENGTH_SEGMENTS)) };
+            result[i] = result[i - 1] + previousPoint.getDistanceFrom(point);
+            previousPoint = point;
+        }
+        auto const totalLength{ result.back() };
+        for (auto & length : result) {
+            length /= totalLength;
+        }
+        return result;
+    }();
+    return LENGTHS;
+}
+
+//==============================================================================
+/** Parameter of Shape::evaluate() at which the given part of the length of the shape is reached. */
+template<typename Shape>
+float getShapeParameterAtLength(float const normalizedLength) noexcept
+{
+    if constexpr (Shape::IS_CONSTANT_SPEED) {
+        return normalizedLength;
+    } else {
+        auto const & lengths{ getShapeLengths<Shape>() };
+        auto const length{ juce::jlimit(0.0f, 1.0f, normalizedLength) };
+        auto const index_b{ std::clamp(
+            static_cast<int>(std::upper_bound(lengths.begin(), lengths.end(), length) - lengths.begin()),
+            1,
+            NUM_SHAPE_LENGTH_SEGMENTS) };
+        auto const index_a{ index_b - 1 };
+        auto const length_a{ lengths[static_cast<size_t>(index_a)] };
+        auto const segmentLength{ lengths[static_cast<size_t>(index_b)] - length_a };
+        auto const balance{ segmentLength > 0.0f ? (length - length_a) / segmentLength : 0.0f };
+        return (static_cast<float>(index_a) + balance) / static_cast<float>(NUM_SHAPE_LENGTH_SEGMENTS);
+    }
+}
+
+//==============================================================================
+/** Evaluates a shape at the part t of its points or, at constant speed, of its length. */
+template<typename Shape>
+juce::Point<float> evaluateShape(float const t, bool const isConstantSpeed) noexcept
+{
+    return Shape::evaluate(isConstantSpeed ? getShapeParameterAtLength<Shape>(t) : t);
+}
+
+using ShapeEvaluator = juce::Point<float> (*)(float t, bool isConstantSpeed);
+} // namespace gris
@@ -0,0 +1,92 @@
+/*
+ This file is part of ControlGris.
+
+ Developers: Hicheme BEN GAIED, Gaël LANE LÉPINE
+
+ ControlGris is free software: you can redistribute it and/or modify
+ it under the terms of the GNU Lesser General Public License as
+ published by the Free Software Foundation, either version 3 of the
+ License, or (at your option) any later version.
+
+ ControlGris is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with ControlGris.  If not, see
+ <http://www.gnu.org/licenses/>.
+*/
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <array>
+#include <atomic>
+
+namespace gris
+{
+//==============================================================================
+/** Wait-free exchange of a value between exactly one writer thread and one reader thread.
+ *
+ * The writer fills getWriteBuffer() and calls publish(). The reader calls update() and, if it returns true, reads the
+ * most recently published value from getReadBuffer(). Neither side ever waits for the other and intermediate values
+ * are dropped when the writer is faster than the reader.
+ */
+template<typename T>
+class TripleBuffer
+{
+public:
+    //==============================================================================
+    TripleBuffer() = default;
+
+    /** Writer side. */
+    T & getWriteBuffer() noexcept { return mBuffers[static_cast<size_t>(mWriteIndex)]; }
+
+    /** Writer side. Makes the content of getWriteBuffer() available to the reader. */
+    void publish() noexcept
+    {
+        auto const previous{ mMiddleIndex.exchange(mWriteIndex | FRESH_FLAG, std::memory_order_acq_rel) };
+        mWriteIndex = previous & INDEX_MASK;
+    }
+
+    /** Reader side. Returns true if a value was published since the last call. */
+    bool update() noexcept
+    {
+        if ((mMiddleIndex.load(std::memory_order_relaxed) & FRESH_FLAG) == 0) {
+            return false;
+        }
+        auto const previous{ mMiddleIndex.exchange(mReadIndex, std::memory_order_acq_rel) };
+        mReadIndex = previous & INDEX_MASK;
+        return true;
+    }
+
+    /** Reader side. */
+    T const & getReadBuffer() const noexcept { return mBuffers[static_cast<size_t>(mReadIndex)]; }
+
+    /** Must not be called while the reader or the writer is active. */
+    void reset(T const & value)
+    {
+        mBuffers.fill(value);
+        mWriteIndex = 0;
+        mMiddleIndex.store(1, std::memory_order_release);
+        mReadIndex = 2;
+    }
+
+private:
+    //==============================================================================
+    static constexpr int INDEX_MASK{ 0b011 };
+    static constexpr int FRESH_FLAG{ 0b100 };
+
+    std::array<T, 3> mBuffers{};
+    int mWriteIndex{ 0 };
+    std::atomic<int> mMiddleIndex{ 1 };
+    int mReadIndex{ 2 };
+
+    //==============================================================================
+    JUCE_LEAK_DETECTOR(TripleBuffer)
+};
+} // namespace gris
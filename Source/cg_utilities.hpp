@@ -67,4 +67,93 @@ private:
     JUCE_LEAK_DETECTOR(XmlElementDataSorter)
 };
 
+//==============================================================================
+/**
+ * A recursive try-lock that never blocks and never makes a system call, so it can be taken on the audio thread.
+ *
+ * Like juce::CriticalSection, the thread that holds the lock can enter it again. Any other thread fails to enter it
+ * until the owner exits.
+ */
+class RealtimeTryLock
+{
+public:
+    //==============================================================================
+    class ScopedTryLock
+    {
+        RealtimeTryLock & mLock;
+        bool mIsLocked;
+
+    public:
+        //==============================================================================
+        ScopedTryLock() = delete;
+        ~ScopedTryLock()
+        {
+            if (mIsLocked) {
+                mLock.exit();
+            }
+        }
+
+        ScopedTryLock(ScopedTryLock const &) = delete;
+        ScopedTryLock(ScopedTryLock &&) = delete;
+
+        ScopedTryLock & operator=(ScopedTryLock const &) = delete;
+        ScopedTryLock & operator=(ScopedTryLock &&) = delete;
+        //==============================================================================
+        explicit ScopedTryLock(RealtimeTryLock & lock) noexcept
+            : mLock(lock)
+            , mIsLocked(lock.tryEnter())
+        {
+        }
+        //==============================================================================
+        [[nodiscard]] bool isLocked() const noexcept { return mIsLocked; }
+
+    private:
+        //==============================================================================
+        JUCE_LEAK_DETECTOR(ScopedTryLock)
+    };
+
+private:
+    //==============================================================================
+    std::atomic<juce::Thread::ThreadID> mOwner{};
+    int mDepth{}; // only touched by the owner
+
+public:
+    //==============================================================================
+    RealtimeTryLock() = default;
+    ~RealtimeTryLock() noexcept = default;
+
+    RealtimeTryLock(RealtimeTryLock const &) = delete;
+    RealtimeTryLock(RealtimeTryLock &&) = delete;
+
+    RealtimeTryLock & operator=(RealtimeTryLock const &) = delete;
+    RealtimeTryLock & operator=(RealtimeTryLock &&) = delete;
+    //==============================================================================
+    bool tryEnter() noexcept
+    {
+        auto const currentThread{ juce::Thread::getCurrentThreadId() };
+        if (mOwner.load(std::memory_order_acquire) == currentThread) {
+            ++mDepth;
+            return true;
+        }
+        juce::Thread::ThreadID expected{};
+        if (!mOwner.compare_exchange_strong(expected, currentThread, std::memory_order_acquire)) {
+            return false;
+        }
+        mDepth = 1;
+        return true;
+    }
+
+    void exit() noexcept
+    {
+        jassert(mOwner.load(std::memory_order_relaxed) == juce::Thread::getCurrentThreadId());
+        if (--mDepth == 0) {
+            mOwner.store(nullptr, std::memory_order_release);
+        }
+    }
+
+private:
+    //==============================================================================
+    JUCE_LEAK_DETECTOR(RealtimeTryLock)
+};
+
 } // namespace gris
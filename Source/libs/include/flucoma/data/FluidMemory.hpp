@@ -10,7 +10,9 @@ namespace fluid {
 
 struct FallbackAllocator
 {
-  using is_stateful = std::false_type;
+  // ControlGris: stateful, so that the containers of the algorithms, ScopedEigenMap included, refer to the Allocator
+  // they are given. Stateless, they all used a default constructed FallbackAllocator, i.e. the heap.
+  using is_stateful = std::true_type;
   
   template<typename RawAlloc>
   FallbackAllocator(RawAlloc&& r):mAlloc{std::forward<RawAlloc>(r)} {}
@@ -0,0 +1,74 @@
+/*
+ This file is part of ControlGris.
+
+ Developers: Hicheme BEN GAIED, Gaël LANE LÉPINE
+
+ ControlGris is free software: you can redistribute it and/or modify
+ it under the terms of the GNU Lesser General Public License as
+ published by the Free Software Foundation, either version 3 of the
+ License, or (at your option) any later version.
+
+ ControlGris is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with ControlGris.  If not, see
+ <http://www.gnu.org/licenses/>.
+*/
+
+//==============================================================================
+
+#include <JuceHeader.h>
+
+#include "cg_Benchmark.hpp"
+#include "cg_RealtimeCheck.hpp"
+
+//==============================================================================
+static void runUnitTests()
+{
+    juce::UnitTestRunner runner{};
+    runner.setAssertOnFailure(false);
+    runner.runAllTests();
+
+    auto numFailures{ 0 };
+    for (int i{}; i < runner.getNumResults(); ++i) {
+        numFailures += runner.getResult(i)->failures;
+    }
+    if (numFailures > 0) {
+        juce::ConsoleApplication::fail(juce::String{ numFailures } + " unit test expectation(s) failed.");
+    }
+}
+
+//==============================================================================
+int main(int argc, char * argv[])
+{
+    // The processor owns components and timers, which need the message manager even without a message loop.
+    juce::ScopedJuceInitialiser_GUI const juceInitialiser{};
+
+    juce::ConsoleApplication app{};
+    app.addHelpCommand("--help|-h", "Usage: ControlGrisTests <command> [options]", true);
+    app.addCommand({ "benchmark",
+                     "benchmark [options]",
+                     "Times processBlock() over sample rates and block sizes.",
+                     gris::Benchmark::HELP,
+                     [](juce::ArgumentList const & args) { gris::Benchmark::run(args); } });
+    app.addCommand({ "compare",
+                     "compare <baseline.json> <candidate.json> [--tolerance <percent>]",
+                     "Compares the benchmark reports of two builds.",
+                     gris::Benchmark::COMPARE_HELP,
+                     [](juce::ArgumentList const & args) { gris::Benchmark::compare(args); } });
+    app.addCommand({ "realtime",
+                     "realtime [options]",
+                     "Fails if processBlock() allocates, locks or blocks.",
+                     gris::RealtimeCheck::HELP,
+                     [](juce::ArgumentList const & args) { gris::RealtimeCheck::run(args); } });
+    app.addCommand({ "unit",
+                     "unit",
+                     "Runs the unit tests.",
+                     "Runs every unit test of the plugin and fails if any expectation fails.",
+                     [](juce::ArgumentList const &) { runUnitTests(); } });
+
+    return app.findAndRunCommand(argc, argv);
+}
@@ -0,0 +1,228 @@
+/*
+ This file is part of ControlGris.
+
+ Developers: Hicheme BEN GAIED, Gaël LANE LÉPINE
+
+ ControlGris is free software: you can redistribute it and/or modify
+ it under the terms of the GNU Lesser General Public License as
+ published by the Free Software Foundation, either version 3 of the
+ License, or (at your option) any later version.
+
+ ControlGris is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with ControlGris.  If not, see
+ <http://www.gnu.org/licenses/>.
+*/
+
+//==============================================================================
+
+#include "cg_AllocationCounter.hpp"
+
+#include <cstdlib>
+#include <new>
+
+#if CG_ALLOCATION_COUNTER_HOOKS_LIBC
+    #include <atomic>
+    #include <cerrno>
+    #include <dlfcn.h>
+    #include <pthread.h>
+
+// The glibc implementations, which the replacements below forward to.
+extern "C" {
+void * __libc_malloc(std::size_t size);
+void * __libc_calloc(std::size_t numElements, std::size_t elementSize);
+void * __libc_realloc(void * pointer, std::size_t size);
+void * __libc_memalign(std::size_t alignment, std::size_t size);
+}
+#endif
+
+namespace
+{
+// Plain thread_local integers: they are zero-initialised and never allocate, so operator new can use them.
+thread_local bool tIsCounting{};
+thread_local juce::int64 tNumAllocations{};
+thread_local juce::int64 tNumLocks{};
+
+//==============================================================================
+// Where malloc() is replaced, it already counts the allocations of operator new.
+void recordCppAllocation() noexcept
+{
+#if !CG_ALLOCATION_COUNTER_HOOKS_LIBC
+    gris::AllocationCounter::recordAllocation();
+#endif
+}
+
+//==============================================================================
+void * allocate(std::size_t size)
+{
+    recordCppAllocation();
+    if (auto * pointer{ std::malloc(size == 0 ? 1 : size) }) {
+        return pointer;
+    }
+    throw std::bad_alloc{};
+}
+
+//==============================================================================
+void * allocateAligned(std::size_t size, std::align_val_t alignment)
+{
+    recordCppAllocation();
+    auto const alignmentInBytes{ std::max(static_cast<std::size_t>(alignment), sizeof(void *)) };
+#if JUCE_WINDOWS
+    if (auto * pointer{ _aligned_malloc(size == 0 ? 1 : size, alignmentInBytes) }) {
+        return pointer;
+    }
+#else
+    void * pointer{};
+    if (posix_memalign(&pointer, alignmentInBytes, size == 0 ? 1 : size) == 0) {
+        return pointer;
+    }
+#endif
+    throw std::bad_alloc{};
+}
+
+//==============================================================================
+void freeAligned(void * pointer) noexcept
+{
+#if JUCE_WINDOWS
+    _aligned_free(pointer);
+#else
+    std::free(pointer);
+#endif
+}
+} // namespace
+
+namespace gris
+{
+//==============================================================================
+AllocationCounter::ScopedCount::ScopedCount() noexcept
+{
+    jassert(!tIsCounting);
+    tNumAllocations = 0;
+    tNumLocks = 0;
+    tIsCounting = true;
+}
+
+//==============================================================================
+AllocationCounter::ScopedCount::~ScopedCount() noexcept
+{
+    tIsCounting = false;
+}
+
+//==============================================================================
+juce::int64 AllocationCounter::ScopedCount::getNumAllocations() const noexcept
+{
+    return tNumAllocations;
+}
+
+//==============================================================================
+juce::int64 AllocationCounter::ScopedCount::getNumLocks() const noexcept
+{
+    return tNumLocks;
+}
+
+//==============================================================================
+void AllocationCounter::recordAllocation() noexcept
+{
+    if (tIsCounting) {
+        ++tNumAllocations;
+    }
+}
+
+//==============================================================================
+void AllocationCounter::recordLock() noexcept
+{
+    if (tIsCounting) {
+        ++tNumLocks;
+    }
+}
+
+} // namespace gris
+
+//==============================================================================
+// The array and nothrow forms default to these ones.
+void * operator new(std::size_t size)
+{
+    return allocate(size);
+}
+
+void * operator new(std::size_t size, std::align_val_t alignment)
+{
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void * pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void * pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void * pointer, std::align_val_t) noexcept
+{
+    freeAligned(pointer);
+}
+
+void operator delete(void * pointer, std::size_t, std::align_val_t) noexcept
+{
+    freeAligned(pointer);
+}
+
+#if CG_ALLOCATION_COUNTER_HOOKS_LIBC
+//==============================================================================
+// free() is left to glibc: it releases what the __libc_ functions allocate.
+extern "C" {
+void * malloc(std::size_t size) noexcept
+{
+    gris::AllocationCounter::recordAllocation();
+    return __libc_malloc(size);
+}
+
+void * calloc(std::size_t numElements, std::size_t elementSize) noexcept
+{
+    gris::AllocationCounter::recordAllocation();
+    return __libc_calloc(numElements, elementSize);
+}
+
+void * realloc(void * pointer, std::size_t size) noexcept
+{
+    gris::AllocationCounter::recordAllocation();
+    return __libc_realloc(pointer, size);
+}
+
+int posix_memalign(void ** pointer, std::size_t alignment, std::size_t size) noexcept
+{
+    gris::AllocationCounter::recordAllocation();
+    if (alignment % sizeof(void *) != 0 || (alignment & (alignment - 1)) != 0) {
+        return EINVAL;
+    }
+    auto * const result{ __libc_memalign(alignment, size) };
+    if (result == nullptr) {
+        return ENOMEM;
+    }
+    *pointer = result;
+    return 0;
+}
+
+int pthread_mutex_lock(pthread_mutex_t * mutex) noexcept
+{
+    using MutexLock = int (*)(pthread_mutex_t *);
+    // Looked up on first use, without any lock or static guard, since those could lock a mutex themselves.
+    static std::atomic<MutexLock> sLock{};
+
+    gris::AllocationCounter::recordLock();
+    auto lock{ sLock.load(std::memory_order_relaxed) };
+    if (lock == nullptr) {
+        lock = reinterpret_cast<MutexLock>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+        sLock.store(lock, std::memory_order_relaxed);
+    }
+    return lock(mutex);
+}
+}
+#endif
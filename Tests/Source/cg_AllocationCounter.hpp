@@ -0,0 +1,92 @@
+/*
+ This file is part of ControlGris.
+
+ Developers: Hicheme BEN GAIED, Gaël LANE LÉPINE
+
+ ControlGris is free software: you can redistribute it and/or modify
+ it under the terms of the GNU Lesser General Public License as
+ published by the Free Software Foundation, either version 3 of the
+ License, or (at your option) any later version.
+
+ ControlGris is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with ControlGris.  If not, see
+ <http://www.gnu.org/licenses/>.
+*/
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#if defined(__has_feature)
+    #if __has_feature(realtime_sanitizer)
+        #define CG_REALTIME_SANITIZER 1
+    #endif
+#endif
+#ifndef CG_REALTIME_SANITIZER
+    #define CG_REALTIME_SANITIZER 0
+#endif
+
+// The realtime sanitizer intercepts the C allocation and locking functions itself.
+#if JUCE_LINUX && !CG_REALTIME_SANITIZER
+    #define CG_ALLOCATION_COUNTER_HOOKS_LIBC 1
+#else
+    #define CG_ALLOCATION_COUNTER_HOOKS_LIBC 0
+#endif
+
+namespace gris
+{
+//==============================================================================
+/** Counts the allocations and the mutex locks made by one thread.
+ *
+ * cg_AllocationCounter.cpp replaces the global operator new and delete of the test executable. On Linux, it also
+ * replaces malloc(), calloc(), realloc() and posix_memalign(), through which FluCoMa and foonathan allocate, and
+ * pthread_mutex_lock(), which every juce::CriticalSection and std::mutex ends up calling. Elsewhere, only the C++
+ * allocations are seen. In the RTSan build, the sanitizer reports all of them instead.
+ */
+class AllocationCounter
+{
+public:
+    //==============================================================================
+    /** Counts the allocations of the calling thread while it is alive. Scopes can not be nested. */
+    class ScopedCount
+    {
+    public:
+        //==============================================================================
+        ScopedCount() noexcept;
+        ~ScopedCount() noexcept;
+
+        ScopedCount(ScopedCount const &) = delete;
+        ScopedCount(ScopedCount &&) = delete;
+
+        ScopedCount & operator=(ScopedCount const &) = delete;
+        ScopedCount & operator=(ScopedCount &&) = delete;
+        //==============================================================================
+        /** The number of allocations made by the calling thread since the scope was entered. */
+        [[nodiscard]] juce::int64 getNumAllocations() const noexcept;
+        /** The number of mutexes locked by the calling thread since the scope was entered. Always 0 where
+         * pthread_mutex_lock() is not replaced.
+         */
+        [[nodiscard]] juce::int64 getNumLocks() const noexcept;
+
+    private:
+        //==============================================================================
+        JUCE_LEAK_DETECTOR(ScopedCount)
+    };
+
+    //==============================================================================
+    AllocationCounter() = delete;
+
+    /** Called by the replaced allocation functions. */
+    static void recordAllocation() noexcept;
+    /** Called by the replaced pthread_mutex_lock(). */
+    static void recordLock() noexcept;
+};
+
+} // namespace gris
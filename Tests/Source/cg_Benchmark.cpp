@@ -0,0 +1,421 @@
+/*
+ This file is part of ControlGris.
+
+ Developers: Hicheme BEN GAIED, Gaël LANE LÉPINE
+
+ ControlGris is free software: you can redistribute it and/or modify
+ it under the terms of the GNU Lesser General Public License as
+ published by the Free Software Foundation, either version 3 of the
+ License, or (at your option) any later version.
+
+ ControlGris is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with ControlGris.  If not, see
+ <http://www.gnu.org/licenses/>.
+*/
+
+//==============================================================================
+
+#include "cg_Benchmark.hpp"
+
+#include "cg_AllocationCounter.hpp"
+#include "cg_DescriptorStages.hpp"
+#include "cg_ProcessorHarness.hpp"
+
+#include <iostream>
+#include <map>
+#include <numeric>
+
+namespace gris
+{
+namespace
+{
+//==============================================================================
+/** The times and allocations of every timed block of a configuration. */
+class BlockTimes
+{
+    std::vector<double> mTimesUs{};
+    juce::int64 mNumAllocations{};
+    int mNumBlocksWithAllocations{};
+
+public:
+    explicit BlockTimes(int numBlocks) { mTimesUs.reserve(static_cast<size_t>(numBlocks)); }
+
+    void add(double timeUs, juce::int64 numAllocations)
+    {
+        mTimesUs.push_back(timeUs);
+        mNumAllocations += numAllocations;
+        mNumBlocksWithAllocations += numAllocations > 0 ? 1 : 0;
+    }
+
+    /** Adds the statistics to a run of the report. */
+    void writeTo(juce::DynamicObject & run, double sampleRate, int blockSize) const
+    {
+        jassert(!mTimesUs.empty());
+        auto sortedTimesUs{ mTimesUs };
+        std::sort(sortedTimesUs.begin(), sortedTimesUs.end());
+        auto const percentile = [&sortedTimesUs](double fraction) {
+            auto const index{ static_cast<size_t>(fraction * static_cast<double>(sortedTimesUs.size() - 1) + 0.5) };
+            return sortedTimesUs[index];
+        };
+        auto const meanUs{ std::accumulate(sortedTimesUs.cbegin(), sortedTimesUs.cend(), 0.0)
+                           / static_cast<double>(sortedTimesUs.size()) };
+
+        run.setProperty("numBlocks", static_cast<int>(sortedTimesUs.size()));
+        run.setProperty("p50Us", percentile(0.5));
+        run.setProperty("p99Us", percentile(0.99));
+        run.setProperty("maxUs", sortedTimesUs.back());
+        run.setProperty("cpuLoad", meanUs * 1e-6 * sampleRate / blockSize);
+        run.setProperty("numAllocations", mNumAllocations);
+        run.setProperty("numBlocksWithAllocations", mNumBlocksWithAllocations);
+    }
+};
+
+//==============================================================================
+juce::String const DEFAULT_SAMPLE_RATES{ "44100,48000,96000" };
+juce::String const DEFAULT_BLOCK_SIZES{ "32,64,128,256,512,1024,2048,4096" };
+juce::String const DEFAULT_DESCRIPTORS{ "loudness,pitch,centroid,iterationsSpeed,flux" };
+
+//==============================================================================
+juce::StringArray splitList(juce::String const & list)
+{
+    auto items{ juce::StringArray::fromTokens(list, ",", {}) };
+    items.trim();
+    items.removeEmptyStrings();
+    return items;
+}
+
+//==============================================================================
+juce::String getOption(juce::ArgumentList const & args, juce::String const & option, juce::String const & fallback)
+{
+    return args.containsOption(option) ? args.getValueForOption(option) : fallback;
+}
+
+//==============================================================================
+std::array<DescriptorID, 5> parseDescriptors(juce::String const & list)
+{
+    auto const names{ splitList(list) };
+    if (names.size() > 5) {
+        juce::ConsoleApplication::fail("At most 5 descriptors can be followed at once (X, Y, Z and the two spans).");
+    }
+
+    std::array<DescriptorID, 5> descriptors{};
+    descriptors.fill(DescriptorID::invalid);
+    for (int i{}; i < names.size(); ++i) {
+        auto const & descriptorNames{ ProcessorHarness::DESCRIPTOR_NAMES };
+        auto const match{ std::find_if(descriptorNames.cbegin(),
+                                       descriptorNames.cend(),
+                                       [&](auto const & entry) { return names[i] == entry.first; }) };
+        if (match == descriptorNames.cend()) {
+            juce::ConsoleApplication::fail("Unknown descriptor: " + names[i]);
+        }
+        descriptors[static_cast<size_t>(i)] = match->second;
+    }
+    return descriptors;
+}
+
+//==============================================================================
+/** Returns the duration of the call in microseconds and the number of allocations it made. */
+template<typename Function>
+std::pair<double, juce::int64> timeCall(Function && function)
+{
+    AllocationCounter::ScopedCount const allocations{};
+    auto const start{ juce::Time::getHighResolutionTicks() };
+    function();
+    auto const end{ juce::Time::getHighResolutionTicks() };
+    return { juce::Time::highResolutionTicksToSeconds(end - start) * 1e6, allocations.getNumAllocations() };
+}
+
+//==============================================================================
+int secondsToBlocks(double timeS, HarnessSettings const & settings)
+{
+    return std::max(juce::roundToInt(std::ceil(timeS * settings.sampleRate / settings.blockSize)), 1);
+}
+
+//==============================================================================
+/** Times whole processBlock() calls. */
+void runProcessor(HarnessSettings const & settings,
+                  juce::AudioBuffer<float> const & signal,
+                  double durationS,
+                  juce::DynamicObject & run)
+{
+    ProcessorHarness harness{ settings, signal };
+
+    for (int i{}; i < secondsToBlocks(Benchmark::WARM_UP_TIME_S, settings); ++i) {
+        harness.runMessageThreadTasks();
+        harness.processNextBlock();
+    }
+
+    auto const numBlocks{ secondsToBlocks(durationS, settings) };
+    BlockTimes blockTimes{ numBlocks };
+    for (int i{}; i < numBlocks; ++i) {
+        harness.runMessageThreadTasks();
+        auto const [timeUs, numAllocations]{ timeCall([&harness] { harness.processNextBlock(); }) };
+        blockTimes.add(timeUs, numAllocations);
+    }
+    blockTimes.writeTo(run, settings.sampleRate, settings.blockSize);
+}
+
+//==============================================================================
+/** Times each descriptor class on its own. The statistics of the run are those of the sum of the stages. */
+void runStages(HarnessSettings const & settings,
+               juce::AudioBuffer<float> const & signal,
+               double durationS,
+               juce::DynamicObject & run)
+{
+    static constexpr auto NUM_STAGES{ static_cast<size_t>(DescriptorStage::count) };
+
+    DescriptorStages stages{ settings.sampleRate, settings.blockSize };
+    // Only the first channel is analysed: the stages start after the mix of the processor.
+    std::vector<float> block(static_cast<size_t>(settings.blockSize));
+    auto signalPosition{ 0 };
+    auto const readNextBlock = [&] {
+        for (auto & sample : block) {
+            sample = signal.getSample(0, signalPosition);
+            signalPosition = (signalPosition + 1) % signal.getNumSamples();
+        }
+        stages.setInput(block.data(), settings.blockSize);
+    };
+
+    for (int i{}; i < secondsToBlocks(Benchmark::WARM_UP_TIME_S, settings); ++i) {
+        readNextBlock();
+        for (size_t stage{}; stage < NUM_STAGES; ++stage) {
+            stages.process(static_cast<DescriptorStage>(stage));
+        }
+    }
+
+    auto const numBlocks{ secondsToBlocks(durationS, settings) };
+    BlockTimes totalTimes{ numBlocks };
+    std::vector<BlockTimes> stageTimes{};
+    for (size_t stage{}; stage < NUM_STAGES; ++stage) {
+        stageTimes.emplace_back(numBlocks);
+    }
+    for (int i{}; i < numBlocks; ++i) {
+        readNextBlock();
+
+        auto totalUs{ 0.0 };
+        juce::int64 totalAllocations{};
+        for (size_t stage{}; stage < NUM_STAGES; ++stage) {
+            auto const [timeUs, numAllocations]{ timeCall(
+                [&stages, stage] { stages.process(static_cast<DescriptorStage>(stage)); }) };
+            stageTimes[stage].add(timeUs, numAllocations);
+            totalUs += timeUs;
+            totalAllocations += numAllocations;
+        }
+        totalTimes.add(totalUs, totalAllocations);
+    }
+
+    totalTimes.writeTo(run, settings.sampleRate, settings.blockSize);
+    auto * stageRuns{ new juce::DynamicObject{} };
+    for (size_t stage{}; stage < NUM_STAGES; ++stage) {
+        auto * stageRun{ new juce::DynamicObject{} };
+        stageTimes[stage].writeTo(*stageRun, settings.sampleRate, settings.blockSize);
+        stageRuns->setProperty(DescriptorStages::getName(static_cast<DescriptorStage>(stage)), juce::var{ stageRun });
+    }
+    run.setProperty("stages", juce::var{ stageRuns });
+}
+
+//==============================================================================
+juce::var readReport(juce::File const & file)
+{
+    auto const report{ juce::JSON::parse(file) };
+    if (!report.getProperty("runs", {}).isArray()) {
+        juce::ConsoleApplication::fail("Not a benchmark report: " + file.getFullPathName());
+    }
+    return report;
+}
+
+//==============================================================================
+juce::String getRunKey(juce::var const & run)
+{
+    return juce::String{ static_cast<double>(run["sampleRate"]) } + "/"
+           + juce::String{ static_cast<int>(run["blockSize"]) };
+}
+
+//==============================================================================
+double getRatio(juce::var const & baseline, juce::var const & candidate, juce::Identifier const & property)
+{
+    auto const baselineValue{ static_cast<double>(baseline[property]) };
+    return baselineValue > 0.0 ? static_cast<double>(candidate[property]) / baselineValue : 1.0;
+}
+} // namespace
+
+//==============================================================================
+juce::String const Benchmark::HELP{
+    "Times processBlock() for every sample rate and block size and reports the results as JSON.\n"
+    "\n"
+    "  --input <file>          Audio file played in a loop, not resampled. Default: a synthetic signal.\n"
+    "  --signal <name>         noise, sine, sweep or clicks. Default: noise.\n"
+    "  --channels <n>          Input channels of the synthetic signal, analysed through the mix. Default: 1.\n"
+    "  --rates <list>          Sample rates. Default: " + DEFAULT_SAMPLE_RATES + ".\n"
+    "  --blocks <list>         Block sizes. Default: " + DEFAULT_BLOCK_SIZES + ".\n"
+    "  --descriptors <list>    Descriptors followed by X, Y, Z and the spans. Default: " + DEFAULT_DESCRIPTORS + ".\n"
+    "  --seconds <s>           Timed audio per configuration. Default: 10.\n"
+    "  --async                 Analyse on the worker thread.\n"
+    "  --stages                Time each descriptor class on its own instead of processBlock(), on the first channel.\n"
+    "  --output <file>         Where to write the report. Default: the standard output.\n"
+};
+
+//==============================================================================
+juce::String const Benchmark::COMPARE_HELP{
+    "Compares two benchmark reports, configuration by configuration, and reports the ratios as JSON.\n"
+    "Fails if a p99 of the candidate is more than the tolerance above the baseline, or if it allocates more.\n"
+    "\n"
+    "  compare <baseline.json> <candidate.json> [--tolerance <percent>]   Default tolerance: 10 %.\n"
+};
+
+//==============================================================================
+void Benchmark::run(juce::ArgumentList const & args)
+{
+    HarnessSettings settings{};
+    settings.isAsync = args.containsOption("--async");
+    settings.descriptors = parseDescriptors(getOption(args, "--descriptors", DEFAULT_DESCRIPTORS));
+    auto const durationS{ getOption(args, "--seconds", juce::String{ DEFAULT_DURATION_S }).getDoubleValue() };
+    auto const signalName{ getOption(args, "--signal", "noise") };
+    auto const numChannels{ juce::jlimit(1, 256, getOption(args, "--channels", "1").getIntValue()) };
+    auto const shouldTimeStages{ args.containsOption("--stages") };
+
+    juce::AudioBuffer<float> fileSignal{};
+    if (args.containsOption("--input")) {
+        auto const file{ args.getExistingFileForOption("--input") };
+        fileSignal = ProcessorHarness::readSignal(file);
+        if (fileSignal.getNumSamples() == 0) {
+            juce::ConsoleApplication::fail("Could not read " + file.getFullPathName());
+        }
+    }
+
+    juce::Array<juce::var> runs{};
+    for (auto const & rateText : splitList(getOption(args, "--rates", DEFAULT_SAMPLE_RATES))) {
+        settings.sampleRate = rateText.getDoubleValue();
+        auto const signal{ fileSignal.getNumSamples() > 0
+                               ? fileSignal
+                               : ProcessorHarness::generateSignal(signalName, numChannels, settings.sampleRate, 10.0) };
+        if (settings.sampleRate <= 0.0 || signal.getNumSamples() == 0) {
+            juce::ConsoleApplication::fail("Invalid sample rate or signal: " + rateText + ", " + signalName);
+        }
+        settings.numChannels = signal.getNumChannels();
+
+        for (auto const & blockText : splitList(getOption(args, "--blocks", DEFAULT_BLOCK_SIZES))) {
+            settings.blockSize = blockText.getIntValue();
+            if (settings.blockSize <= 0) {
+                juce::ConsoleApplication::fail("Invalid block size: " + blockText);
+            }
+            std::cerr << "Running " << settings.sampleRate << " Hz, " << settings.blockSize << " samples" << std::endl;
+
+            auto * run{ new juce::DynamicObject{} };
+            run->setProperty("sampleRate", settings.sampleRate);
+            run->setProperty("blockSize", settings.blockSize);
+            if (shouldTimeStages) {
+                runStages(settings, signal, durationS, *run);
+            } else {
+                runProcessor(settings, signal, durationS, *run);
+            }
+            runs.add(juce::var{ run });
+        }
+    }
+
+    juce::Array<juce::var> descriptorNames{};
+    for (auto const descriptor : settings.descriptors) {
+        descriptorNames.add(juce::String{ ProcessorHarness::getDescriptorName(descriptor) });
+    }
+
+    auto * reportSettings{ new juce::DynamicObject{} };
+    reportSettings->setProperty("input",
+                                fileSignal.getNumSamples() > 0 ? args.getExistingFileForOption("--input").getFileName()
+                                                               : signalName);
+    reportSettings->setProperty("channels", settings.numChannels);
+    reportSettings->setProperty("descriptors", descriptorNames);
+    reportSettings->setProperty("async", settings.isAsync);
+    reportSettings->setProperty("stages", shouldTimeStages);
+    reportSettings->setProperty("seconds", durationS);
+
+    auto * report{ new juce::DynamicObject{} };
+    report->setProperty("version", JucePlugin_VersionString);
+    report->setProperty("settings", juce::var{ reportSettings });
+    report->setProperty("runs", runs);
+
+    auto const json{ juce::JSON::toString(juce::var{ report }) };
+    if (args.containsOption("--output")) {
+        auto const file{ args.getFileForOption("--output") };
+        if (!file.replaceWithText(json)) {
+            juce::ConsoleApplication::fail("Could not write " + file.getFullPathName());
+        }
+    } else {
+        std::cout << json << std::endl;
+    }
+}
+
+//==============================================================================
+void Benchmark::compare(juce::ArgumentList const & args)
+{
+    if (args.size() < 3) {
+        juce::ConsoleApplication::fail("Expected a baseline and a candidate report.");
+    }
+    auto const baseline{ readReport(args[1].resolveAsExistingFile()) };
+    auto const candidate{ readReport(args[2].resolveAsExistingFile()) };
+    auto const tolerancePercent{
+        getOption(args, "--tolerance", juce::String{ DEFAULT_TOLERANCE_PERCENT }).getDoubleValue()
+    };
+    auto const tolerance{ 1.0 + tolerancePercent / 100.0 };
+    if (static_cast<bool>(baseline["settings"]["stages"]) != static_cast<bool>(candidate["settings"]["stages"])) {
+        juce::ConsoleApplication::fail("One report times processBlock() and the other one the descriptor stages.");
+    }
+
+    std::map<juce::String, juce::var> baselineRuns{};
+    for (auto const & run : *baseline["runs"].getArray()) {
+        baselineRuns[getRunKey(run)] = run;
+    }
+
+    juce::Array<juce::var> comparisons{};
+    auto numRegressions{ 0 };
+    for (auto const & candidateRun : *candidate["runs"].getArray()) {
+        auto const baselineRun{ baselineRuns.find(getRunKey(candidateRun)) };
+        if (baselineRun == baselineRuns.cend()) {
+            continue;
+        }
+
+        auto const p99Ratio{ getRatio(baselineRun->second, candidateRun, "p99Us") };
+        auto const allocationDelta{ static_cast<juce::int64>(candidateRun["numAllocations"])
+                                    - static_cast<juce::int64>(baselineRun->second["numAllocations"]) };
+        auto const isRegression{ p99Ratio > tolerance || allocationDelta > 0 };
+        numRegressions += isRegression ? 1 : 0;
+
+        auto * comparison{ new juce::DynamicObject{} };
+        comparison->setProperty("sampleRate", candidateRun["sampleRate"]);
+        comparison->setProperty("blockSize", candidateRun["blockSize"]);
+        comparison->setProperty("p50Ratio", getRatio(baselineRun->second, candidateRun, "p50Us"));
+        comparison->setProperty("p99Ratio", p99Ratio);
+        comparison->setProperty("maxRatio", getRatio(baselineRun->second, candidateRun, "maxUs"));
+        comparison->setProperty("allocationDelta", allocationDelta);
+        comparison->setProperty("regression", isRegression);
+        if (auto const * stages{ candidateRun["stages"].getDynamicObject() }) {
+            // Tells which descriptor a regression comes from. Only the sum of the stages decides of a regression.
+            auto * stageRatios{ new juce::DynamicObject{} };
+            for (auto const & stage : stages->getProperties()) {
+                stageRatios->setProperty(stage.name,
+                                         getRatio(baselineRun->second["stages"][stage.name], stage.value, "p99Us"));
+            }
+            comparison->setProperty("stageP99Ratios", juce::var{ stageRatios });
+        }
+        comparisons.add(juce::var{ comparison });
+    }
+
+    auto * result{ new juce::DynamicObject{} };
+    result->setProperty("tolerancePercent", tolerancePercent);
+    result->setProperty("regressions", numRegressions);
+    result->setProperty("runs", comparisons);
+    std::cout << juce::JSON::toString(juce::var{ result }) << std::endl;
+
+    if (comparisons.isEmpty()) {
+        juce::ConsoleApplication::fail("The reports have no configuration in common.");
+    }
+    if (numRegressions > 0) {
+        juce::ConsoleApplication::fail(juce::String{ numRegressions } + " configuration(s) regressed.");
+    }
+}
+
+} // namespace gris
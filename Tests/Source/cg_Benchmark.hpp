@@ -0,0 +1,58 @@
+/*
+ This file is part of ControlGris.
+
+ Developers: Hicheme BEN GAIED, Gaël LANE LÉPINE
+
+ ControlGris is free software: you can redistribute it and/or modify
+ it under the terms of the GNU Lesser General Public License as
+ published by the Free Software Foundation, either version 3 of the
+ License, or (at your option) any later version.
+
+ ControlGris is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with ControlGris.  If not, see
+ <http://www.gnu.org/licenses/>.
+*/
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace gris
+{
+//==============================================================================
+/** Times processBlock() over a sweep of sample rates and block sizes and compares the reports of two builds.
+ *
+ * Every configuration gets a fresh processor, one second of warm-up and then the given duration of timed blocks. The
+ * timer of the processor runs between the blocks, outside of the timed region. The report is a JSON object holding the
+ * settings and, for every configuration, the p50, p99 and maximum block times in microseconds, the mean CPU load and
+ * the number of allocations made by the blocks. With --stages, the descriptor classes are driven directly instead of
+ * the processor and every configuration also holds the statistics of each one.
+ */
+class Benchmark
+{
+public:
+    //==============================================================================
+    static constexpr double WARM_UP_TIME_S{ 1.0 };
+    static constexpr double DEFAULT_DURATION_S{ 10.0 };
+    static constexpr double DEFAULT_TOLERANCE_PERCENT{ 10.0 };
+
+    //==============================================================================
+    Benchmark() = delete;
+
+    /** The "benchmark" command. Writes the report to --output or to the standard output. */
+    static void run(juce::ArgumentList const & args);
+    /** The "compare" command. Fails when a p99 or an allocation count of the candidate report is worse. */
+    static void compare(juce::ArgumentList const & args);
+
+    static juce::String const HELP;
+    static juce::String const COMPARE_HELP;
+};
+
+} // namespace gris
@@ -0,0 +1,128 @@
+/*
+ This file is part of ControlGris.
+
+ Developers: Hicheme BEN GAIED, Gaël LANE LÉPINE
+
+ ControlGris is free software: you can redistribute it and/or modify
+ it under the terms of the GNU Lesser General Public License as
+ published by the Free Software Foundation, either version 3 of the
+ License, or (at your option) any later version.
+
+ ControlGris is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with ControlGris.  If not, see
+ <http://www.gnu.org/licenses/>.
+*/
+
+//==============================================================================
+
+#include "cg_DescriptorStages.hpp"
+
+namespace gris
+{
+//==============================================================================
+DescriptorStages::DescriptorStages(double const sampleRate, int const blockSize)
+    : mSampleRate(sampleRate)
+    , mSignal(blockSize)
+{
+    // The same setup as ControlGrisAudioProcessor::prepareToPlay() and allocateAnalysisResource().
+    mLoudness.reset();
+    mLoudness.init(mSampleRate);
+
+    mSpectralFrameCache.reset();
+    mPitch.reset();
+    mPitch.init();
+    mPitch.setFrequencyRange(PITCH_MIN_FREQ, 10000.0);
+    mSpectralFrameCache.setPitchWindowSize(PitchD::getWindowSize(PITCH_MIN_FREQ, mSampleRate));
+
+    mShape.reset();
+    mStats.init();
+    mStats.prepare(std::max(mPitchMat.cols(), mShapeMat.cols()));
+
+    mSpectralFeatures.reset(ShapeD::NBINS);
+
+    mOnsetDetectionFunctionCache.reset(blockSize);
+    for (fluid::index metric{}; metric < OnsetDetectionFunctionCache::NUM_METRICS; ++metric) {
+        mOnsetDetectionFunctionCache.setSubscribed(metric, true);
+    }
+}
+
+//==============================================================================
+void DescriptorStages::setInput(float const * data, int const numSamples)
+{
+    jassert(numSamples <= mSignal.size());
+    mNumSamples = std::min(numSamples, static_cast<int>(mSignal.size()));
+    for (int i{}; i < mNumSamples; ++i) {
+        mSignal[i] = static_cast<double>(data[i]);
+    }
+}
+
+//==============================================================================
+void DescriptorStages::process(DescriptorStage const stage)
+{
+    switch (stage) {
+    case DescriptorStage::loudness:
+        mLoudness.process(mSignal.data(), mNumSamples);
+        break;
+    case DescriptorStage::spectralFrames:
+        mSpectralFrameCache.write(mSignal.data(), mNumSamples);
+        break;
+    case DescriptorStage::pitch:
+        mSpectralFrameCache.analyse(SpectralResolution::pitch);
+        std::fill(mCalculatedPitchDesc.begin(), mCalculatedPitchDesc.end(), 0);
+        mPitch.yinProcess(mSpectralFrameCache.getMagnitude(SpectralResolution::pitch),
+                          mCalculatedPitchDesc,
+                          mSampleRate);
+        mPitchMat.row(0) <<= mCalculatedPitchDesc;
+        mPitch.process(mPitchMat, mStats);
+        break;
+    case DescriptorStage::shape:
+        mSpectralFrameCache.analyse(SpectralResolution::shape);
+        std::fill(mCalculatedShapeDesc.begin(), mCalculatedShapeDesc.end(), 0);
+        mShape.shapeProcess(mSpectralFrameCache.getMagnitude(SpectralResolution::shape),
+                            mCalculatedShapeDesc,
+                            mSampleRate);
+        mShapeMat.row(0) <<= mCalculatedShapeDesc;
+        mShape.process(mShapeMat, mStats, mShapeStats);
+        break;
+    case DescriptorStage::spectralFeatures:
+        mSpectralFeatures.process(mSpectralFrameCache.getMagnitude(SpectralResolution::shape), mSampleRate);
+        break;
+    case DescriptorStage::onsetDetection:
+        mOnsetDetectionFunctionCache.push(mSignal.data(), mNumSamples);
+        break;
+    case DescriptorStage::count:
+    default:
+        jassertfalse;
+        break;
+    }
+}
+
+//==============================================================================
+char const * DescriptorStages::getName(DescriptorStage const stage)
+{
+    switch (stage) {
+    case DescriptorStage::loudness:
+        return "loudness";
+    case DescriptorStage::spectralFrames:
+        return "spectralFrames";
+    case DescriptorStage::pitch:
+        return "pitch";
+    case DescriptorStage::shape:
+        return "shape";
+    case DescriptorStage::spectralFeatures:
+        return "spectralFeatures";
+    case DescriptorStage::onsetDetection:
+        return "onsetDetection";
+    case DescriptorStage::count:
+    default:
+        jassertfalse;
+        return "";
+    }
+}
+
+} // namespace gris
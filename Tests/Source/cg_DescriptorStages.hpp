@@ -0,0 +1,90 @@
+/*
+ This file is part of ControlGris.
+
+ Developers: Hicheme BEN GAIED, Gaël LANE LÉPINE
+
+ ControlGris is free software: you can redistribute it and/or modify
+ it under the terms of the GNU Lesser General Public License as
+ published by the Free Software Foundation, either version 3 of the
+ License, or (at your option) any later version.
+
+ ControlGris is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with ControlGris.  If not, see
+ <http://www.gnu.org/licenses/>.
+*/
+
+//==============================================================================
+
+#pragma once
+
+#include "../../Source/Descriptors/cg_Loudness.hpp"
+#include "../../Source/Descriptors/cg_OnsetDetectionFunctionCache.hpp"
+#include "../../Source/Descriptors/cg_SpectralFeatures.hpp"
+#include "../../Source/Descriptors/cg_SpectralFrameCache.hpp"
+
+namespace gris
+{
+//==============================================================================
+enum class DescriptorStage { loudness = 0, spectralFrames, pitch, shape, spectralFeatures, onsetDetection, count };
+
+//==============================================================================
+/** The descriptor classes of the processor, driven directly so each one can be timed on its own.
+ *
+ * Every stage runs on every block: there is no scheduler and no routing, so the times are those of a block on which
+ * every descriptor is due. The stages must run in their declaration order, the spectral ones reading the history
+ * written by spectralFrames.
+ */
+class DescriptorStages
+{
+    double mSampleRate;
+    fluid::RealVector mSignal;
+    int mNumSamples{};
+
+    LoudnessD mLoudness;
+    SpectralFrameCache mSpectralFrameCache;
+    PitchD mPitch;
+    ShapeD mShape;
+    StatsD mStats;
+    SpectralFeatures mSpectralFeatures;
+    OnsetDetectionFunctionCache mOnsetDetectionFunctionCache;
+
+    // A single frame is analysed per stage call, as the scheduled descriptors of the processor do.
+    fluid::RealMatrix mPitchMat = fluid::RealMatrix(1, 2);
+    fluid::RealVector mCalculatedPitchDesc = fluid::RealVector(2);
+    fluid::RealMatrix mShapeMat = fluid::RealMatrix(1, 7);
+    fluid::RealVector mShapeStats = fluid::RealVector(7);
+    fluid::RealVector mCalculatedShapeDesc = fluid::RealVector(7);
+
+public:
+    //==============================================================================
+    /** The lowest frequency tracked by the pitch stage, which sets its window size. */
+    static constexpr double PITCH_MIN_FREQ{ 50.0 };
+
+    //==============================================================================
+    DescriptorStages(double sampleRate, int blockSize);
+    ~DescriptorStages() = default;
+
+    DescriptorStages(DescriptorStages const &) = delete;
+    DescriptorStages(DescriptorStages &&) = delete;
+
+    DescriptorStages & operator=(DescriptorStages const &) = delete;
+    DescriptorStages & operator=(DescriptorStages &&) = delete;
+    //==============================================================================
+    /** Converts the next block to the analysis format. Not part of any stage. */
+    void setInput(float const * data, int numSamples);
+    /** Runs one stage on the block given to setInput(). */
+    void process(DescriptorStage stage);
+
+    static char const * getName(DescriptorStage stage);
+
+private:
+    //==============================================================================
+    JUCE_LEAK_DETECTOR(DescriptorStages)
+};
+
+} // namespace gris
@@ -0,0 +1,169 @@
+/*
+ This file is part of ControlGris.
+
+ Developers: Hicheme BEN GAIED, Gaël LANE LÉPINE
+
+ ControlGris is free software: you can redistribute it and/or modify
+ it under the terms of the GNU Lesser General Public License as
+ published by the Free Software Foundation, either version 3 of the
+ License, or (at your option) any later version.
+
+ ControlGris is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with ControlGris.  If not, see
+ <http://www.gnu.org/licenses/>.
+*/
+
+//==============================================================================
+
+#include "cg_LegacyOnsetDetection.hpp"
+#include "cg_ProcessorHarness.hpp"
+
+#include "../../Source/Descriptors/cg_OnsetDetection.hpp"
+
+namespace gris
+{
+//==============================================================================
+/** Compares the onset detection of OnsetDetectionFunctionCache and OnsetDetectionD with the per-sample implementation
+ * they replaced, kept in LegacyOnsetDetectionD.
+ *
+ * Fixed signals are fed block by block through both paths, for every metric and for block sizes that are smaller
+ * than, equal to and not multiples of the analysis chunk. The detection function frames, the onset times picked from
+ * them and the iterations speed value of every block must be identical, bit for bit.
+ */
+class OnsetDetectionTest final : public juce::UnitTest
+{
+    //==============================================================================
+    struct Output {
+        std::vector<double> detectionFunction{};
+        std::vector<double> values{};
+    };
+
+public:
+    //==============================================================================
+    static constexpr double SAMPLE_RATE{ 48000.0 };
+    static constexpr double SIGNAL_DURATION_S{ 3.0 };
+    static constexpr float THRESHOLD{ 0.1f };
+
+    //==============================================================================
+    OnsetDetectionTest() : juce::UnitTest("OnsetDetection Test") {}
+
+    void runTest() override
+    {
+        for (auto const * signalName : { "clicks", "noise", "sweep" }) {
+            auto const signal{ ProcessorHarness::generateSignal(signalName, 1, SAMPLE_RATE, SIGNAL_DURATION_S) };
+
+            for (auto const blockSize : { 1, 64, 100, 256, 512, 4096 }) {
+                beginTest(juce::String{ signalName } + ", blocks of " + juce::String{ blockSize } + " samples");
+
+                auto numOnsets{ 0 };
+                for (fluid::index metric{}; metric < OnsetDetectionFunctionCache::NUM_METRICS; ++metric) {
+                    auto const legacy{ runLegacy(signal, blockSize, metric) };
+                    auto const current{ runCurrent(signal, blockSize, metric) };
+
+                    auto const metricName{ "metric " + juce::String{ static_cast<int>(metric) } };
+                    expectEquals(static_cast<int>(current.detectionFunction.size()),
+                                 static_cast<int>(legacy.detectionFunction.size()),
+                                 metricName + ": number of detection function frames");
+                    // Both paths analyse the same doubles: the output must be bit for bit the same.
+                    expect(current.detectionFunction == legacy.detectionFunction, metricName + ": detection function");
+
+                    auto const legacyOnsets{ getOnsetTimesMs(legacy.detectionFunction) };
+                    auto const currentOnsets{ getOnsetTimesMs(current.detectionFunction) };
+                    expect(currentOnsets == legacyOnsets, metricName + ": onset times");
+                    numOnsets += static_cast<int>(legacyOnsets.size());
+
+                    expect(current.values == legacy.values, metricName + ": iterations speed");
+                }
+
+                // Guards against comparing two silent detections.
+                if (juce::String{ signalName } == "clicks") {
+                    expectGreaterThan(numOnsets, 0, "no onset detected in the clicks");
+                }
+            }
+        }
+    }
+
+private:
+    //==============================================================================
+    static Output runLegacy(juce::AudioBuffer<float> const & signal, int blockSize, fluid::index metric)
+    {
+        // The same order as in prepareToPlay() and the parameter callbacks of the processor it came from.
+        LegacyOnsetDetectionD onsetDetection{};
+        onsetDetection.reset(blockSize);
+        onsetDetection.init();
+        onsetDetection.setOnesetDetectionMetric(static_cast<int>(metric));
+        onsetDetection.setOnsetDetectionThreshold(THRESHOLD);
+
+        Output output{};
+        juce::AudioBuffer<float> block{ 1, blockSize };
+        for (int start{}; start + blockSize <= signal.getNumSamples(); start += blockSize) {
+            block.copyFrom(0, 0, signal, 0, start, blockSize);
+            onsetDetection.process(block, SAMPLE_RATE, blockSize);
+
+            auto const & frames{ onsetDetection.getDetectionFunctionValues() };
+            output.detectionFunction.insert(output.detectionFunction.end(), frames.cbegin(), frames.cend());
+            output.values.push_back(onsetDetection.getValue());
+        }
+        return output;
+    }
+
+    //==============================================================================
+    static Output runCurrent(juce::AudioBuffer<float> const & signal, int blockSize, fluid::index metric)
+    {
+        OnsetDetectionFunctionCache onsetDetectionFunctions{};
+        onsetDetectionFunctions.reset(blockSize);
+        onsetDetectionFunctions.setSubscribed(metric, true);
+
+        OnsetDetectionD onsetDetection{};
+        onsetDetection.init();
+        onsetDetection.setOnesetDetectionMetric(static_cast<int>(metric));
+        onsetDetection.setOnsetDetectionThreshold(THRESHOLD);
+
+        Output output{};
+        // The processor converts the analysed block to double once, before every descriptor.
+        std::vector<double> block(static_cast<size_t>(blockSize));
+        for (int start{}; start + blockSize <= signal.getNumSamples(); start += blockSize) {
+            auto const * samples{ signal.getReadPointer(0, start) };
+            std::transform(samples, samples + blockSize, block.begin(), [](float x) { return static_cast<double>(x); });
+            onsetDetectionFunctions.push(block.data(), blockSize);
+            onsetDetection.process(onsetDetectionFunctions, SAMPLE_RATE, blockSize);
+
+            auto const frames{ onsetDetectionFunctions.getValues(metric) };
+            output.detectionFunction.insert(output.detectionFunction.end(), frames.begin(), frames.end());
+            output.values.push_back(onsetDetection.getValue());
+        }
+        return output;
+    }
+
+    //==============================================================================
+    /** Picks the onsets the way OnsetDetectionD does: a frame reaching the threshold after one below it. */
+    static std::vector<double> getOnsetTimesMs(std::vector<double> const & detectionFunction)
+    {
+        constexpr auto framesPerChunk{ OnsetDetectionFunctionCache::FRAMES_PER_CHUNK };
+        constexpr auto hopSize{ static_cast<int>(OnsetDetectionFunctionCache::HOP_SIZE) };
+
+        std::vector<double> onsetTimesMs{};
+        auto isReady{ true };
+        for (size_t frame{}; frame < detectionFunction.size(); ++frame) {
+            if (detectionFunction[frame] >= THRESHOLD && isReady) {
+                isReady = false;
+                auto const chunk{ static_cast<int>(frame) / framesPerChunk };
+                auto const frameInChunk{ static_cast<int>(frame) % framesPerChunk };
+                auto const sample{ chunk * OnsetDetectionFunctionCache::CHUNK_SIZE + frameInChunk * hopSize };
+                onsetTimesMs.push_back(sample / SAMPLE_RATE * 1000.0);
+            } else if (detectionFunction[frame] < THRESHOLD) {
+                isReady = true;
+            }
+        }
+        return onsetTimesMs;
+    }
+};
+
+static OnsetDetectionTest onsetDetectionTest;
+
+} // namespace gris
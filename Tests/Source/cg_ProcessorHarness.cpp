@@ -0,0 +1,216 @@
+/*
+ This file is part of ControlGris.
+
+ Developers: Hicheme BEN GAIED, Gaël LANE LÉPINE
+
+ ControlGris is free software: you can redistribute it and/or modify
+ it under the terms of the GNU Lesser General Public License as
+ published by the Free Software Foundation, either version 3 of the
+ License, or (at your option) any later version.
+
+ ControlGris is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with ControlGris.  If not, see
+ <http://www.gnu.org/licenses/>.
+*/
+
+//==============================================================================
+
+#include "cg_ProcessorHarness.hpp"
+
+namespace gris
+{
+//==============================================================================
+ProcessorHarness::ProcessorHarness(HarnessSettings const & settings, juce::AudioBuffer<float> const & signal)
+    : mSettings(settings)
+    , mSignal(signal)
+    , mBuffer(settings.numChannels, settings.blockSize)
+{
+    jassert(mSignal.getNumChannels() > 0 && mSignal.getNumSamples() > 0);
+
+    mProcessor.setPlayConfigDetails(mSettings.numChannels,
+                                    mSettings.numChannels,
+                                    mSettings.sampleRate,
+                                    mSettings.blockSize);
+    mProcessor.setPlayHead(this);
+
+    // The routing is set before prepareToPlay(), which allocates the analysis resources it needs.
+    mProcessor.setSpatMode(mSettings.spatMode);
+    if (mSettings.isPlayingTrajectories) {
+        auto & positionTrajectoryManager{ mProcessor.getPositionTrajectoryManager() };
+        auto & elevationTrajectoryManager{ mProcessor.getElevationTrajectoryManager() };
+        positionTrajectoryManager.setTrajectoryType(PositionTrajectoryType::circleClockwise,
+                                                    mProcessor.getSources()[0].getPos());
+        elevationTrajectoryManager.setTrajectoryType(ElevationTrajectoryType::downUp);
+        positionTrajectoryManager.setPlaybackDuration(TRAJECTORY_DURATION_S);
+        elevationTrajectoryManager.setPlaybackDuration(TRAJECTORY_DURATION_S);
+        positionTrajectoryManager.setPositionActivateState(true);
+        elevationTrajectoryManager.setPositionActivateState(true);
+        mProcessor.setSelectedSoundTrajectoriesTab(1);
+    } else {
+        std::array<SpatialParameter *, 5> parameters{};
+        if (mSettings.spatMode == SpatMode::cube) {
+            parameters = { &mProcessor.getXCube(),
+                           &mProcessor.getYCube(),
+                           &mProcessor.getZCube(),
+                           &mProcessor.getHSpanCube(),
+                           &mProcessor.getVSpanCube() };
+        } else {
+            parameters = { &mProcessor.getAzimuthDome(),
+                           &mProcessor.getElevationDome(),
+                           &mProcessor.getHSpanDome(),
+                           &mProcessor.getVSpanDome(),
+                           nullptr };
+        }
+        for (size_t i{}; i < parameters.size(); ++i) {
+            if (parameters[i] != nullptr) {
+                parameters[i]->setDescriptorToUse(mSettings.descriptors[i]);
+            }
+        }
+        mProcessor.setGainMultiplierForAudioAnalysis(1.0);
+        // The channel after the last one is the weighted mix of all of them.
+        mProcessor.setChannelForAudioAnalysis(mSettings.numChannels + 1);
+        mProcessor.setAudioAnalysisAsync(mSettings.isAsync);
+        mProcessor.setPerSourceAnalysisOn(mSettings.isPerSourceAnalysisOn);
+        mProcessor.setPerSourceAnalysisDescriptor(mSettings.perSourceDescriptor);
+        mProcessor.setPerSourceAnalysisTarget(mSettings.perSourceTarget);
+        mProcessor.setSelectedSoundTrajectoriesTab(0);
+    }
+
+    mProcessor.prepareToPlay(mSettings.sampleRate, mSettings.blockSize);
+}
+
+//==============================================================================
+ProcessorHarness::~ProcessorHarness()
+{
+    mProcessor.setPlayHead(nullptr);
+    mProcessor.releaseResources();
+}
+
+//==============================================================================
+void ProcessorHarness::processNextBlock(int numSamples)
+{
+    jassert(numSamples > 0 && numSamples <= mSettings.blockSize);
+    numSamples = juce::jlimit(1, mSettings.blockSize, numSamples);
+    // The buffer keeps the memory allocated for the prepared size.
+    mBuffer.setSize(mSettings.numChannels, numSamples, false, false, true);
+
+    for (int written{}; written < numSamples;) {
+        auto const numToCopy{ std::min(numSamples - written, mSignal.getNumSamples() - mSignalPosition) };
+        for (int channel{}; channel < mBuffer.getNumChannels(); ++channel) {
+            mBuffer.copyFrom(channel,
+                             written,
+                             mSignal,
+                             channel % mSignal.getNumChannels(),
+                             mSignalPosition,
+                             numToCopy);
+        }
+        written += numToCopy;
+        mSignalPosition = (mSignalPosition + numToCopy) % mSignal.getNumSamples();
+    }
+
+    mProcessor.processBlock(mBuffer, mMidiBuffer);
+
+    mTimeInSamples += numSamples;
+    mSamplesUntilTimer -= numSamples;
+}
+
+//==============================================================================
+void ProcessorHarness::runMessageThreadTasks()
+{
+    if (mSamplesUntilTimer > 0) {
+        return;
+    }
+    mSamplesUntilTimer += static_cast<juce::int64>(mSettings.sampleRate / TIMER_RATE_HZ);
+    mProcessor.timerCallback();
+}
+
+//==============================================================================
+juce::Optional<juce::AudioPlayHead::PositionInfo> ProcessorHarness::getPosition() const
+{
+    PositionInfo position{};
+    position.setIsPlaying(true);
+    position.setBpm(120.0);
+    position.setTimeInSamples(mTimeInSamples);
+    position.setTimeInSeconds(static_cast<double>(mTimeInSamples) / mSettings.sampleRate);
+    return position;
+}
+
+//==============================================================================
+juce::AudioBuffer<float>
+    ProcessorHarness::generateSignal(juce::String const & name, int numChannels, double sampleRate, double durationS)
+{
+    auto const numSamples{ static_cast<int>(durationS * sampleRate) };
+    juce::AudioBuffer<float> signal{ numChannels, numSamples };
+    auto * samples{ signal.getWritePointer(0) };
+    auto const twoPi{ juce::MathConstants<double>::twoPi };
+
+    if (name == "noise") {
+        juce::Random random{ 1234 };
+        for (int i{}; i < numSamples; ++i) {
+            samples[i] = 0.5f * (2.0f * random.nextFloat() - 1.0f);
+        }
+    } else if (name == "sine") {
+        for (int i{}; i < numSamples; ++i) {
+            samples[i] = 0.5f * static_cast<float>(std::sin(twoPi * 440.0 * i / sampleRate));
+        }
+    } else if (name == "sweep") {
+        // Exponential sweep from 50 Hz to 10 kHz.
+        auto const rate{ std::log(10000.0 / 50.0) / durationS };
+        for (int i{}; i < numSamples; ++i) {
+            auto const t{ i / sampleRate };
+            samples[i] = 0.5f * static_cast<float>(std::sin(twoPi * 50.0 * (std::exp(rate * t) - 1.0) / rate));
+        }
+    } else if (name == "clicks") {
+        // A 5 ms noise burst every 250 ms, every other burst being 30 ms late.
+        juce::Random random{ 1234 };
+        signal.clear();
+        auto const burstLength{ static_cast<int>(0.005 * sampleRate) };
+        for (int click{}; click * 0.25 < durationS; ++click) {
+            auto const start{ static_cast<int>((click * 0.25 + (click % 2) * 0.03) * sampleRate) };
+            for (int i{ start }; i < std::min(start + burstLength, numSamples); ++i) {
+                samples[i] = 0.8f * (2.0f * random.nextFloat() - 1.0f);
+            }
+        }
+    } else {
+        return {};
+    }
+
+    for (int channel{ 1 }; channel < numChannels; ++channel) {
+        signal.copyFrom(channel, 0, signal, 0, 0, numSamples);
+    }
+    return signal;
+}
+
+//==============================================================================
+juce::AudioBuffer<float> ProcessorHarness::readSignal(juce::File const & file)
+{
+    juce::AudioFormatManager formatManager{};
+    formatManager.registerBasicFormats();
+    std::unique_ptr<juce::AudioFormatReader> const reader{ formatManager.createReaderFor(file) };
+    if (reader == nullptr || reader->lengthInSamples <= 0
+        || reader->lengthInSamples > std::numeric_limits<int>::max()) {
+        return {};
+    }
+
+    juce::AudioBuffer<float> signal{ static_cast<int>(reader->numChannels),
+                                     static_cast<int>(reader->lengthInSamples) };
+    reader->read(&signal, 0, signal.getNumSamples(), 0, true, true);
+    return signal;
+}
+
+//==============================================================================
+char const * ProcessorHarness::getDescriptorName(DescriptorID const descriptor)
+{
+    auto const match{ std::find_if(DESCRIPTOR_NAMES.cbegin(), DESCRIPTOR_NAMES.cend(), [&](auto const & entry) {
+        return entry.second == descriptor;
+    }) };
+    jassert(match != DESCRIPTOR_NAMES.cend());
+    return match != DESCRIPTOR_NAMES.cend() ? match->first : "";
+}
+
+} // namespace gris
@@ -0,0 +1,132 @@
+/*
+ This file is part of ControlGris.
+
+ Developers: Hicheme BEN GAIED, Gaël LANE LÉPINE
+
+ ControlGris is free software: you can redistribute it and/or modify
+ it under the terms of the GNU Lesser General Public License as
+ published by the Free Software Foundation, either version 3 of the
+ License, or (at your option) any later version.
+
+ ControlGris is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with ControlGris.  If not, see
+ <http://www.gnu.org/licenses/>.
+*/
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "../../Source/cg_ControlGrisAudioProcessor.hpp"
+
+namespace gris
+{
+//==============================================================================
+struct HarnessSettings {
+    double sampleRate{ 48000.0 };
+    int blockSize{ 512 };
+    int numChannels{ 1 };
+    SpatMode spatMode{ SpatMode::cube };
+    bool isAsync{};
+    bool isPerSourceAnalysisOn{};
+    PerSourceDescriptor perSourceDescriptor{ PerSourceDescriptor::loudness };
+    PerSourceTarget perSourceTarget{ PerSourceTarget::elevation };
+    // Plays a circle and a down-up trajectory from the abstract trajectories tab instead of analysing the input.
+    bool isPlayingTrajectories{};
+    // The descriptors followed by the spatial parameters: X, Y, Z, the horizontal span and the vertical span in cube
+    // mode, the azimuth, the elevation, the horizontal span and the vertical span in dome mode, where the last
+    // descriptor is not used.
+    std::array<DescriptorID, 5> descriptors{ DescriptorID::loudness,
+                                             DescriptorID::pitch,
+                                             DescriptorID::centroid,
+                                             DescriptorID::iterationsSpeed,
+                                             DescriptorID::flux };
+};
+
+//==============================================================================
+/** Runs a ControlGrisAudioProcessor without a host.
+ *
+ * The processor either analyses the mix of the input channels with the descriptors of the settings or plays abstract
+ * trajectories, while a playhead reports a playing transport. The input signal is read in a loop. There is no message
+ * loop: the calling thread plays both the audio thread and the message thread, and runMessageThreadTasks() calls the
+ * processor timer at its 50 Hz rate, counted in processed samples.
+ */
+class ProcessorHarness final : private juce::AudioPlayHead
+{
+    HarnessSettings mSettings;
+    juce::AudioBuffer<float> const & mSignal;
+    ControlGrisAudioProcessor mProcessor;
+    juce::AudioBuffer<float> mBuffer;
+    juce::MidiBuffer mMidiBuffer;
+    int mSignalPosition{};
+    juce::int64 mTimeInSamples{};
+    juce::int64 mSamplesUntilTimer{};
+
+public:
+    //==============================================================================
+    static constexpr double TIMER_RATE_HZ{ 50.0 };
+    static constexpr double TRAJECTORY_DURATION_S{ 2.0 };
+    // The names the test commands give to the descriptors.
+    static constexpr std::array<std::pair<char const *, DescriptorID>, NUM_DESCRIPTOR_IDS + 1> DESCRIPTOR_NAMES{
+        { { "none", DescriptorID::invalid },
+          { "loudness", DescriptorID::loudness },
+          { "centroid", DescriptorID::centroid },
+          { "spread", DescriptorID::spread },
+          { "noise", DescriptorID::noise },
+          { "pitch", DescriptorID::pitch },
+          { "iterationsSpeed", DescriptorID::iterationsSpeed },
+          { "flux", DescriptorID::flux },
+          { "rolloff", DescriptorID::rolloff },
+          { "crest", DescriptorID::crest },
+          { "lowBandEnergy", DescriptorID::lowBandEnergy },
+          { "midBandEnergy", DescriptorID::midBandEnergy },
+          { "highBandEnergy", DescriptorID::highBandEnergy } }
+    };
+
+    //==============================================================================
+    ProcessorHarness(HarnessSettings const & settings, juce::AudioBuffer<float> const & signal);
+    ~ProcessorHarness() override;
+
+    ProcessorHarness(ProcessorHarness const &) = delete;
+    ProcessorHarness(ProcessorHarness &&) = delete;
+
+    ProcessorHarness & operator=(ProcessorHarness const &) = delete;
+    ProcessorHarness & operator=(ProcessorHarness &&) = delete;
+    //==============================================================================
+    /** Copies the next block of the signal to the input channels and calls processBlock(). */
+    void processNextBlock() { processNextBlock(mSettings.blockSize); }
+    /** Same, with a host block shorter than the prepared size. Does not allocate. */
+    void processNextBlock(int numSamples);
+    /** Calls the processor timer if it is due. Does nothing between two timer periods. */
+    void runMessageThreadTasks();
+
+    [[nodiscard]] ControlGrisAudioProcessor & getProcessor() { return mProcessor; }
+    [[nodiscard]] HarnessSettings const & getSettings() const { return mSettings; }
+
+    //==============================================================================
+    /** Generates "noise", "sine", "sweep" or "clicks", the same on every channel. Returns an empty buffer for any other
+     * name.
+     */
+    static juce::AudioBuffer<float>
+        generateSignal(juce::String const & name, int numChannels, double sampleRate, double durationS);
+    /** Reads a whole audio file. Returns an empty buffer if the file can not be read. */
+    static juce::AudioBuffer<float> readSignal(juce::File const & file);
+    /** The name of a descriptor in DESCRIPTOR_NAMES. */
+    static char const * getDescriptorName(DescriptorID descriptor);
+
+private:
+    //==============================================================================
+    juce::Optional<PositionInfo> getPosition() const override;
+
+    //==============================================================================
+    JUCE_LEAK_DETECTOR(ProcessorHarness)
+};
+
+} // namespace gris
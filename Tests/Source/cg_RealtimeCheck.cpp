@@ -0,0 +1,306 @@
+/*
+ This file is part of ControlGris.
+
+ Developers: Hicheme BEN GAIED, Gaël LANE LÉPINE
+
+ ControlGris is free software: you can redistribute it and/or modify
+ it under the terms of the GNU Lesser General Public License as
+ published by the Free Software Foundation, either version 3 of the
+ License, or (at your option) any later version.
+
+ ControlGris is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with ControlGris.  If not, see
+ <http://www.gnu.org/licenses/>.
+*/
+
+//==============================================================================
+
+#include "cg_RealtimeCheck.hpp"
+
+#include "cg_AllocationCounter.hpp"
+#include "cg_ProcessorHarness.hpp"
+
+#include <iostream>
+
+#if CG_REALTIME_SANITIZER
+// Whatever RTSAN_OPTIONS the environment sets by default, a violation must end the run with an error.
+extern "C" char const * __rtsan_default_options()
+{
+    return "halt_on_error=true:print_stats_on_exit=false";
+}
+#endif
+
+namespace gris
+{
+namespace
+{
+//==============================================================================
+enum class Mode { syncAnalysis = 0, asyncAnalysis, perSourceAnalysis, trajectories, count };
+
+//==============================================================================
+char const * getModeName(Mode const mode)
+{
+    switch (mode) {
+    case Mode::syncAnalysis:
+        return "syncAnalysis";
+    case Mode::asyncAnalysis:
+        return "asyncAnalysis";
+    case Mode::perSourceAnalysis:
+        return "perSourceAnalysis";
+    case Mode::trajectories:
+        return "trajectories";
+    case Mode::count:
+    default:
+        jassertfalse;
+        return "";
+    }
+}
+
+//==============================================================================
+char const * getSpatModeName(SpatMode const spatMode)
+{
+    return spatMode == SpatMode::dome ? "dome" : "cube";
+}
+
+//==============================================================================
+char const * getPerSourceDescriptorName(PerSourceDescriptor const descriptor)
+{
+    switch (descriptor) {
+    case PerSourceDescriptor::loudness:
+        return "loudness";
+    case PerSourceDescriptor::rmsFrequency:
+        return "rmsFrequency";
+    default:
+        jassertfalse;
+        return "";
+    }
+}
+
+//==============================================================================
+char const * getPerSourceTargetName(PerSourceTarget const target)
+{
+    switch (target) {
+    case PerSourceTarget::elevation:
+        return "elevation";
+    case PerSourceTarget::azimuthSpan:
+        return "azimuthSpan";
+    case PerSourceTarget::elevationSpan:
+        return "elevationSpan";
+    case PerSourceTarget::azimuth:
+        return "azimuth";
+    default:
+        jassertfalse;
+        return "";
+    }
+}
+
+//==============================================================================
+/** Every setting of a mode that changes what processBlock() does: the descriptors followed by the spatial parameters
+ * for the global analysis, the descriptor and its target for the per-source analysis.
+ */
+std::vector<HarnessSettings> getVariants(HarnessSettings const & settings, Mode const mode)
+{
+    std::vector<HarnessSettings> variants{};
+    switch (mode) {
+    case Mode::syncAnalysis:
+    case Mode::asyncAnalysis:
+        // Rotating the descriptors over the parameters puts every descriptor on every parameter once.
+        for (size_t first{}; first < NUM_DESCRIPTOR_IDS; ++first) {
+            auto variant{ settings };
+            for (size_t i{}; i < variant.descriptors.size(); ++i) {
+                variant.descriptors[i] = static_cast<DescriptorID>((first + i) % NUM_DESCRIPTOR_IDS);
+            }
+            variants.push_back(variant);
+        }
+        break;
+    case Mode::perSourceAnalysis:
+        for (auto const descriptor : { PerSourceDescriptor::loudness, PerSourceDescriptor::rmsFrequency }) {
+            for (auto const target : { PerSourceTarget::elevation,
+                                       PerSourceTarget::azimuthSpan,
+                                       PerSourceTarget::elevationSpan,
+                                       PerSourceTarget::azimuth }) {
+                auto variant{ settings };
+                variant.perSourceDescriptor = descriptor;
+                variant.perSourceTarget = target;
+                variants.push_back(variant);
+            }
+        }
+        break;
+    case Mode::trajectories:
+        variants.push_back(settings);
+        break;
+    case Mode::count:
+    default:
+        jassertfalse;
+    }
+    return variants;
+}
+
+//==============================================================================
+juce::String getVariantName(HarnessSettings const & settings, Mode const mode)
+{
+    if (mode == Mode::perSourceAnalysis) {
+        return juce::String{ getPerSourceDescriptorName(settings.perSourceDescriptor) } + " on "
+               + getPerSourceTargetName(settings.perSourceTarget);
+    }
+    if (mode == Mode::trajectories) {
+        return {};
+    }
+
+    // The dome has no fifth parameter.
+    auto const numParameters{ settings.spatMode == SpatMode::dome ? 4 : 5 };
+    juce::StringArray names{};
+    for (int i{}; i < numParameters; ++i) {
+        names.add(ProcessorHarness::getDescriptorName(settings.descriptors[static_cast<size_t>(i)]));
+    }
+    return names.joinIntoString("/");
+}
+
+//==============================================================================
+juce::String getOption(juce::ArgumentList const & args, juce::String const & option, juce::String const & fallback)
+{
+    return args.containsOption(option) ? args.getValueForOption(option) : fallback;
+}
+
+//==============================================================================
+juce::StringArray splitList(juce::String const & list)
+{
+    auto items{ juce::StringArray::fromTokens(list, ",", {}) };
+    items.trim();
+    items.removeEmptyStrings();
+    return items;
+}
+
+//==============================================================================
+struct Violations {
+    juce::int64 numAllocations{};
+    juce::int64 numLocks{};
+};
+
+//==============================================================================
+/** Returns the allocations and mutex locks made by processBlock() after the warm-up. */
+Violations runConfiguration(HarnessSettings const & settings, juce::AudioBuffer<float> const & signal, double durationS)
+{
+    ProcessorHarness harness{ settings, signal };
+    auto const secondsToBlocks = [&settings](double timeS) {
+        return std::max(juce::roundToInt(std::ceil(timeS * settings.sampleRate / settings.blockSize)), 1);
+    };
+
+    for (int i{}; i < secondsToBlocks(RealtimeCheck::WARM_UP_TIME_S); ++i) {
+        harness.runMessageThreadTasks();
+        harness.processNextBlock();
+    }
+
+    juce::Random random{ settings.blockSize };
+    Violations violations{};
+    auto const numBlocks{ secondsToBlocks(durationS) };
+    for (int i{}; i < numBlocks; ++i) {
+        harness.runMessageThreadTasks();
+        auto const numSamples{ i < numBlocks / 2 ? settings.blockSize : 1 + random.nextInt(settings.blockSize) };
+
+        AllocationCounter::ScopedCount const count{};
+        harness.processNextBlock(numSamples);
+        violations.numAllocations += count.getNumAllocations();
+        violations.numLocks += count.getNumLocks();
+    }
+    return violations;
+}
+} // namespace
+
+//==============================================================================
+juce::String const RealtimeCheck::HELP{
+    "Runs processBlock() through every audio path, in dome and cube mode and with every descriptor, and fails on any\n"
+    "allocation or mutex lock made from it. In the RTSan configuration, the realtime sanitizer also aborts the run on\n"
+    "the first blocking system call.\n"
+    "\n"
+    "  --rates <list>          Sample rates. Default: 44100,96000.\n"
+    "  --blocks <list>         Prepared block sizes. Default: 32,512,4096.\n"
+    "  --channels <n>          Input channels. Default: 2.\n"
+    "  --seconds <s>           Audio per configuration, after one second of warm-up. Default: 4.\n"
+    "  --require-rtsan         Fail if the program is not built with the realtime sanitizer.\n"
+};
+
+//==============================================================================
+bool RealtimeCheck::isSanitizerEnabled()
+{
+    return CG_REALTIME_SANITIZER != 0;
+}
+
+//==============================================================================
+void RealtimeCheck::run(juce::ArgumentList const & args)
+{
+    if (!isSanitizerEnabled()) {
+        if (args.containsOption("--require-rtsan")) {
+            juce::ConsoleApplication::fail("Not built with the realtime sanitizer: build the RTSan configuration.");
+        }
+        std::cerr << "Not built with the realtime sanitizer: only allocations and mutex locks are checked."
+                  << std::endl;
+    }
+
+    auto const durationS{ getOption(args, "--seconds", juce::String{ DEFAULT_DURATION_S }).getDoubleValue() };
+    auto const numChannels{ juce::jlimit(1, 32, getOption(args, "--channels", "2").getIntValue()) };
+
+    juce::StringArray failures{};
+    auto numConfigurations{ 0 };
+    for (auto const & rateText : splitList(getOption(args, "--rates", "44100,96000"))) {
+        HarnessSettings settings{};
+        settings.sampleRate = rateText.getDoubleValue();
+        settings.numChannels = numChannels;
+        // Noise keeps every descriptor busy, including the pitch and onset detection searches.
+        auto const signal{ ProcessorHarness::generateSignal("noise", numChannels, settings.sampleRate, 5.0) };
+        if (settings.sampleRate <= 0.0 || signal.getNumSamples() == 0) {
+            juce::ConsoleApplication::fail("Invalid sample rate: " + rateText);
+        }
+
+        for (auto const & blockText : splitList(getOption(args, "--blocks", "32,512,4096"))) {
+            settings.blockSize = blockText.getIntValue();
+            if (settings.blockSize <= 0) {
+                juce::ConsoleApplication::fail("Invalid block size: " + blockText);
+            }
+
+            for (auto const spatMode : { SpatMode::dome, SpatMode::cube }) {
+                settings.spatMode = spatMode;
+                for (int modeIndex{}; modeIndex < static_cast<int>(Mode::count); ++modeIndex) {
+                    auto const mode{ static_cast<Mode>(modeIndex) };
+                    settings.isAsync = mode == Mode::asyncAnalysis;
+                    settings.isPerSourceAnalysisOn = mode == Mode::perSourceAnalysis;
+                    settings.isPlayingTrajectories = mode == Mode::trajectories;
+
+                    for (auto const & variant : getVariants(settings, mode)) {
+                        auto name{ rateText + " Hz, " + blockText + " samples, " + getSpatModeName(spatMode) + ", "
+                                   + getModeName(mode) };
+                        auto const variantName{ getVariantName(variant, mode) };
+                        if (variantName.isNotEmpty()) {
+                            name += " (" + variantName + ")";
+                        }
+                        std::cerr << "Running " << name << std::endl;
+
+                        auto const violations{ runConfiguration(variant, signal, durationS) };
+                        ++numConfigurations;
+                        if (violations.numAllocations > 0 || violations.numLocks > 0) {
+                            failures.add(name + ": " + juce::String{ violations.numAllocations } + " allocation(s), "
+                                         + juce::String{ violations.numLocks } + " lock(s)");
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    for (auto const & failure : failures) {
+        std::cout << failure << std::endl;
+    }
+    if (!failures.isEmpty()) {
+        juce::ConsoleApplication::fail(juce::String{ failures.size() } + " of " + juce::String{ numConfigurations }
+                                       + " configuration(s) allocated or locked from processBlock().");
+    }
+    std::cout << numConfigurations << " configuration(s) passed"
+              << (isSanitizerEnabled() ? " under the realtime sanitizer." : ".") << std::endl;
+}
+
+} // namespace gris
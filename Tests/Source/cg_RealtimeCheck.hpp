@@ -0,0 +1,63 @@
+/*
+ This file is part of ControlGris.
+
+ Developers: Hicheme BEN GAIED, Gaël LANE LÉPINE
+
+ ControlGris is free software: you can redistribute it and/or modify
+ it under the terms of the GNU Lesser General Public License as
+ published by the Free Software Foundation, either version 3 of the
+ License, or (at your option) any later version.
+
+ ControlGris is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with ControlGris.  If not, see
+ <http://www.gnu.org/licenses/>.
+*/
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace gris
+{
+//==============================================================================
+/** Runs processBlock() through every audio path and fails if it is not realtime safe.
+ *
+ * Every sample rate, block size, spatialisation mode (dome and cube) and audio path (synchronous analysis,
+ * asynchronous analysis, per-source analysis and abstract trajectories) gets a fresh processor. The global analysis
+ * runs once per rotation of the descriptors over the spatial parameters, so that every descriptor drives every
+ * parameter, and the per-source analysis once per descriptor and target. After one second of warm-up, the first half
+ * of the run uses blocks of the prepared size and the second half shorter blocks of random sizes.
+ *
+ * Two checks run together:
+ * - In the RTSan configuration, the realtime sanitizer aborts the run on the first allocation, lock or blocking system
+ *   call made from processBlock(), which is [[clang::nonblocking]].
+ * - In every other configuration, AllocationCounter counts the allocations and mutex locks made by processBlock() on
+ *   the calling thread, through operator new everywhere and through malloc() and pthread_mutex_lock() on Linux. The
+ *   command fails if there is any.
+ */
+class RealtimeCheck
+{
+public:
+    //==============================================================================
+    static constexpr double WARM_UP_TIME_S{ 1.0 };
+    static constexpr double DEFAULT_DURATION_S{ 4.0 };
+
+    //==============================================================================
+    RealtimeCheck() = delete;
+
+    /** The "realtime" command. */
+    static void run(juce::ArgumentList const & args);
+    /** True when the program is built with the realtime sanitizer. */
+    static bool isSanitizerEnabled();
+
+    static juce::String const HELP;
+};
+
+} // namespace gris